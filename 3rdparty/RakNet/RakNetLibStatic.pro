@@ -0,0 +1,34 @@
+#-------------------------------------------------
+#
+# RakNet static library, with the DCS Copilot additions in Source, for every
+# build: qmake RakNetLibStatic.pro && make
+# Writes Lib/libRakNetLibStatic.a on Linux and Lib/RakNetStatic_x64.lib
+# (RakNetStatic_x64d.lib for debug) on Windows. DCS_Copilot.pro builds it
+# itself; a RakNet library built from stock sources lacks the added API and
+# will not link.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+
+TARGET = RakNetLibStatic
+TEMPLATE = lib
+CONFIG += staticlib c++11 warn_off
+CONFIG -= qt
+
+DESTDIR = $$PWD/Lib
+
+win32 {
+    CONFIG(debug, debug|release): TARGET = RakNetStatic_x64d
+    else: TARGET = RakNetStatic_x64
+}
+
+# debug and release builds may share a build directory
+CONFIG(debug, debug|release): OBJECTS_DIR = raknet_debug
+else: OBJECTS_DIR = raknet_release
+
+INCLUDEPATH += $$PWD/Source
+DEPENDPATH += $$PWD/Source
+
+SOURCES += $$files($$PWD/Source/*.cpp)
+HEADERS += $$files($$PWD/Source/*.h)
@@ -0,0 +1,218 @@
+/*
+ *  Added to RakNet for DCS Copilot. Distributed under the same BSD-style license
+ *  as the rest of RakNet, found in the LICENSE file in the root directory of this source tree.
+ *
+ */
+
+/// \file DS_LocklessAllocatingQueue.h
+/// \internal
+/// \brief A multiple producer, single consumer queue that never takes a lock, with the same interface as ThreadsafeAllocatingQueue.
+///
+
+
+#ifndef __LOCKLESS_ALLOCATING_QUEUE
+#define __LOCKLESS_ALLOCATING_QUEUE
+
+#include "Export.h"
+#include "NativeTypes.h"
+#include "RakMemoryOverride.h"
+#include <atomic>
+
+namespace DataStructures
+{
+
+/// \brief Hands structures from any number of threads to one consumer thread.
+/// \details Push() links the structure onto a shared stack with a compare and swap. The consumer takes the whole stack with one exchange
+/// and reverses it into a list only it reads, so items come out in the order they were pushed and neither side ever waits on the other.
+/// Allocate() and Deallocate() take nodes from and return them to a free list, a stack of pool indices behind one 64 bit head that also
+/// holds a counter bumped by every change, so an Allocate() that read a node which meanwhile left and rejoined the list fails its swap.
+/// The pool grows a block of nodes at a time and never shrinks. Once its blocks run out the nodes come from the allocator.
+/// \note Pop(), PopInaccurate() and Clear() are for the consumer only.
+template <class structureType>
+class RAK_DLL_EXPORT LocklessAllocatingQueue
+{
+public:
+	LocklessAllocatingQueue();
+	~LocklessAllocatingQueue();
+
+	// Queue operations
+	void Push(structureType *s);
+	structureType *PopInaccurate(void);
+	structureType *Pop(void);
+
+	// Memory operations
+	structureType *Allocate(const char *file, unsigned int line);
+	void Deallocate(structureType *s, const char *file, unsigned int line);
+	void Clear(const char *file, unsigned int line);
+
+protected:
+	struct Node
+	{
+		structureType value; // First, so a structure and its node share an address
+		Node *next;
+		uint32_t index; // In the pool, or HEAP_NODE
+		std::atomic<uint32_t> nextFree; // Read by Allocate() calls that may lose the race for this node
+	};
+
+	static const uint32_t BLOCK_SIZE=64;
+	static const uint32_t MAX_BLOCKS=256;
+	static const uint32_t NO_NODE=0xFFFFFFFF;
+	static const uint32_t HEAP_NODE=0xFFFFFFFE;
+
+	static Node *GetNode(structureType *s) {return reinterpret_cast<Node*>(s);}
+	Node *GetPoolNode(uint32_t index) {return blocks[index/BLOCK_SIZE].load(std::memory_order_acquire)+index%BLOCK_SIZE;}
+
+	/// Adds the pool nodes \a first to \a last, already linked through nextFree, to the free list
+	void PushFree(Node *first, Node *last);
+
+	/// Adds a block to the pool and returns one of its nodes, the others going to the free list
+	Node *AllocateBlock(const char *file, unsigned int line);
+
+	// Pushed and not yet taken by the consumer, newest first
+	std::atomic<Node*> pushed;
+
+	// Consumer only, oldest first
+	Node *taken;
+
+	// Change counter in the high 32 bits, index of the first free node in the low 32 bits
+	std::atomic<uint64_t> freeHead;
+	std::atomic<Node*> blocks[MAX_BLOCKS];
+	std::atomic<uint32_t> blockCount;
+};
+
+template <class structureType>
+LocklessAllocatingQueue<structureType>::LocklessAllocatingQueue()
+{
+	pushed.store(0);
+	taken=0;
+	freeHead.store(NO_NODE);
+	for (uint32_t i=0; i < MAX_BLOCKS; i++)
+		blocks[i].store(0);
+	blockCount.store(0);
+}
+
+template <class structureType>
+LocklessAllocatingQueue<structureType>::~LocklessAllocatingQueue()
+{
+	Clear(_FILE_AND_LINE_);
+	for (uint32_t i=0; i < MAX_BLOCKS; i++)
+	{
+		Node *block = blocks[i].load();
+		if (block)
+			RakNet::OP_DELETE_ARRAY(block, _FILE_AND_LINE_);
+	}
+}
+
+template <class structureType>
+void LocklessAllocatingQueue<structureType>::Push(structureType *s)
+{
+	Node *node = GetNode(s);
+	Node *head = pushed.load(std::memory_order_relaxed);
+	do
+	{
+		node->next=head;
+	} while (pushed.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed)==false);
+}
+
+template <class structureType>
+structureType *LocklessAllocatingQueue<structureType>::PopInaccurate(void)
+{
+	if (taken==0 && pushed.load(std::memory_order_relaxed)==0)
+		return 0;
+	return Pop();
+}
+
+template <class structureType>
+structureType *LocklessAllocatingQueue<structureType>::Pop(void)
+{
+	if (taken==0)
+	{
+		Node *node = pushed.exchange(0, std::memory_order_acquire);
+		while (node)
+		{
+			Node *next = node->next;
+			node->next=taken;
+			taken=node;
+			node=next;
+		}
+		if (taken==0)
+			return 0;
+	}
+
+	Node *node = taken;
+	taken=node->next;
+	return &node->value;
+}
+
+template <class structureType>
+structureType *LocklessAllocatingQueue<structureType>::Allocate(const char *file, unsigned int line)
+{
+	uint64_t head = freeHead.load(std::memory_order_acquire);
+	while ((uint32_t) head!=NO_NODE)
+	{
+		Node *node = GetPoolNode((uint32_t) head);
+		uint64_t next = (((head>>32)+1)<<32) | node->nextFree.load(std::memory_order_relaxed);
+		if (freeHead.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+			return &node->value;
+	}
+
+	return &AllocateBlock(file, line)->value;
+}
+
+template <class structureType>
+void LocklessAllocatingQueue<structureType>::Deallocate(structureType *s, const char *file, unsigned int line)
+{
+	Node *node = GetNode(s);
+	if (node->index==HEAP_NODE)
+		RakNet::OP_DELETE(node, file, line);
+	else
+		PushFree(node, node);
+}
+
+template <class structureType>
+void LocklessAllocatingQueue<structureType>::PushFree(Node *first, Node *last)
+{
+	uint64_t head = freeHead.load(std::memory_order_relaxed);
+	uint64_t next;
+	do
+	{
+		last->nextFree.store((uint32_t) head, std::memory_order_relaxed);
+		next = (((head>>32)+1)<<32) | first->index;
+	} while (freeHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed)==false);
+}
+
+template <class structureType>
+typename LocklessAllocatingQueue<structureType>::Node *LocklessAllocatingQueue<structureType>::AllocateBlock(const char *file, unsigned int line)
+{
+	uint32_t blockIndex = blockCount.load(std::memory_order_relaxed) < MAX_BLOCKS ? blockCount.fetch_add(1, std::memory_order_relaxed) : MAX_BLOCKS;
+	if (blockIndex >= MAX_BLOCKS)
+	{
+		Node *node = RakNet::OP_NEW<Node>(file, line);
+		node->index=HEAP_NODE;
+		return node;
+	}
+
+	Node *block = RakNet::OP_NEW_ARRAY<Node>(BLOCK_SIZE, file, line);
+	for (uint32_t i=0; i < BLOCK_SIZE; i++)
+	{
+		block[i].index=blockIndex*BLOCK_SIZE+i;
+		block[i].nextFree.store(block[i].index+1, std::memory_order_relaxed);
+	}
+
+	// Published before any of its indices reach the free list
+	blocks[blockIndex].store(block, std::memory_order_release);
+	PushFree(&block[1], &block[BLOCK_SIZE-1]);
+	return &block[0];
+}
+
+template <class structureType>
+void LocklessAllocatingQueue<structureType>::Clear(const char *file, unsigned int line)
+{
+	structureType *s;
+	while ((s=Pop())!=0)
+		Deallocate(s, file, line);
+}
+
+} // namespace DataStructures
+
+#endif
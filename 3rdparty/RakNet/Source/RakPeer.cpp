@@ -117,6 +117,16 @@ using namespace RakNet;
 
 static RakNetRandom rnr;
 
+// Below this many active systems, waking the update workers costs more than it saves
+static const unsigned int UPDATE_WORKER_MIN_SYSTEMS=4;
+
+// Passed to RakPeer::UpdateReliabilityLayer through UpdateWorkerPool::Run()
+struct ReliabilityUpdateContext
+{
+	RakPeer *rakPeer;
+	RakNet::TimeUS timeNS;
+};
+
 /*
 struct RakPeerAndIndex
 {
@@ -219,6 +229,7 @@ RakPeer::RakPeer()
 	incomingDatagramEventHandler=0;
 
 	tickTime = 10;
+	updateWorkerCount = 0;
 
 
 
@@ -256,7 +267,6 @@ RakPeer::RakPeer()
 	_extraPingVariance=0;
 #endif
 
-	bufferedCommands.SetPageSize(sizeof(BufferedCommandStruct)*16);
 	socketQueryOutput.SetPageSize(sizeof(SocketQueryOutput)*8);
 
 	packetAllocationPoolMutex.Lock();
@@ -310,6 +320,8 @@ RakPeer::RakPeer()
 	GenerateGUID();
 
 	quitAndDataEvents.InitEvent();
+	packetReadyEvent.InitEvent();
+	userPacketReadyEvent=0;
 	limitConnectionFrequencyFromTheSameIP=false;
 	ResetSendReceipt();
 }
@@ -329,6 +341,7 @@ RakPeer::~RakPeer()
 	WSAStartupSingleton::Deref();
 
 	quitAndDataEvents.CloseEvent();
+	packetReadyEvent.CloseEvent();
 
 #if LIBCAT_SECURITY==1
 	// Encryption and security
@@ -672,6 +685,9 @@ StartupResult RakPeer::Startup(unsigned int maxConnections, RakNet::TimeMS tickT
 
 			int errorCode;
 
+			tickScheduler.Start();
+			// Fewer workers than asked for if a thread cannot be created, down to the update thread alone
+			updateWorkerPool.Start(updateWorkerCount, threadPriority);
 
 
 
@@ -1133,6 +1149,8 @@ void RakPeer::Shutdown( unsigned int blockDuration, unsigned char orderingChanne
 		endThreads = true;
 		RakSleep(15);
 	}
+	tickScheduler.Stop();
+	updateWorkerPool.Stop();
 
 	/*
 	timeout = RakNet::GetTimeMS()+1000;
@@ -1614,6 +1632,45 @@ Packet* RakPeer::Receive( void )
 	return packet;
 }
 
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Description:
+// Blocks until a packet is waiting to be returned by Receive, or until timeoutMS elapses
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool RakPeer::WaitForPacket( RakNet::TimeMS timeoutMS )
+{
+	RakNet::TimeMS startTime=RakNet::GetTimeMS();
+	RakNet::TimeMS elapsed;
+	bool hasPacket;
+
+	for(;;)
+	{
+		packetReturnMutex.Lock();
+		hasPacket=packetReturnQueue.IsEmpty()==false;
+		packetReturnMutex.Unlock();
+		if (hasPacket)
+			return true;
+
+		elapsed=RakNet::GetTimeMS()-startTime;
+		if (elapsed>=timeoutMS)
+			return false;
+
+		// The event stays signaled if a packet was pushed after the check above, so the wakeup is not lost.
+		// It may also still be set for packets that were already returned by Receive, hence the loop
+		packetReadyEvent.WaitOnEvent((int) (timeoutMS-elapsed));
+	}
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Description:
+// Sets an additional event to signal whenever a packet is added to the receive queue
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void RakPeer::SetPacketReadyEvent( SignaledEvent *event )
+{
+	packetReturnMutex.Lock();
+	userPacketReadyEvent=event;
+	packetReturnMutex.Unlock();
+}
+
 // --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Description:
 // Call this to deallocate a packet returned by Receive
@@ -2596,6 +2653,34 @@ RakNet::TimeMS RakPeer::GetTickTime(void) const
 	return tickTime;
 }
 
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void RakPeer::SetTickSpinTime(RakNet::TimeUS spinTimeUS)
+{
+	tickScheduler.SetSpinTime(spinTimeUS);
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void RakPeer::GetTickStatistics(TickStatistics *stats) const
+{
+	tickScheduler.GetStatistics(stats);
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void RakPeer::SetUpdateWorkers(unsigned int workerCount)
+{
+	updateWorkerCount=workerCount;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int RakPeer::GetUpdateWorkers(void) const
+{
+	return updateWorkerCount;
+}
+
 // --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Description:
 // Returns the current MTU size
@@ -2870,6 +2955,7 @@ void RakPeer::PushBackPacket( Packet *packet, bool pushAtHead)
 		packetReturnQueue.PushAtHead(packet,0,_FILE_AND_LINE_);
 	else
 		packetReturnQueue.Push(packet,_FILE_AND_LINE_);
+	SignalPacketReady();
 	packetReturnMutex.Unlock();
 }
 
@@ -4148,6 +4234,34 @@ void RakPeer::PingInternal( const SystemAddress target, bool performImmediate, P
 		Send( &bitStream, IMMEDIATE_PRIORITY, reliability, 0, target, false );
 }
 // --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void RakPeer::SendKeepAliveIfIdle( RemoteSystemStruct *remoteSystem, RakNet::Time timeMS )
+{
+	if (timeMS > remoteSystem->lastReliableSend && timeMS-remoteSystem->lastReliableSend > remoteSystem->reliabilityLayer.GetTimeoutTime()/2 && remoteSystem->connectMode==RemoteSystemStruct::CONNECTED)
+	{
+		// If no reliable packets are waiting for an ack, do a one byte reliable send so that disconnections are noticed
+		RakNetStatistics rakNetStatistics;
+		RakNetStatistics *rnss=remoteSystem->reliabilityLayer.GetStatistics(&rakNetStatistics);
+		if (rnss->messagesInResendBuffer==0)
+		{
+			PingInternal( remoteSystem->systemAddress, true, RELIABLE );
+
+			//remoteSystem->lastReliableSend=timeMS+remoteSystem->reliabilityLayer.GetTimeoutTime();
+			remoteSystem->lastReliableSend=timeMS;
+		}
+	}
+}
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void RakPeer::UpdateReliabilityLayer( void *context, unsigned int index, BitStream &scratch )
+{
+	ReliabilityUpdateContext *updateContext = (ReliabilityUpdateContext *) context;
+	RakPeer *rakPeer = updateContext->rakPeer;
+	RemoteSystemStruct *remoteSystem = rakPeer->activeSystemList[ index ];
+	SystemAddress systemAddress = remoteSystem->systemAddress;
+
+	// Only ever called with no plugins, so Update() calls nothing outside this layer. rnr is not used by Update().
+	remoteSystem->reliabilityLayer.Update( remoteSystem->rakNetSocket, systemAddress, remoteSystem->MTUSize, updateContext->timeNS, rakPeer->maxOutgoingBPS, rakPeer->pluginListNTS, &rnr, scratch );
+}
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void RakPeer::CloseConnectionInternal( const AddressOrGUID& systemIdentifier, bool sendDisconnectionNotification, bool performImmediate, unsigned char orderingChannel, PacketPriority disconnectionNotificationPriority )
 {
 #ifdef _DEBUG
@@ -4488,9 +4602,18 @@ inline void RakPeer::AddPacketToProducer(RakNet::Packet *p)
 {
 	packetReturnMutex.Lock();
 	packetReturnQueue.Push(p,_FILE_AND_LINE_);
+	SignalPacketReady();
 	packetReturnMutex.Unlock();
 }
 // --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Must be called with packetReturnMutex locked
+void RakPeer::SignalPacketReady(void)
+{
+	packetReadyEvent.SetEvent();
+	if (userPacketReadyEvent)
+		userPacketReadyEvent->SetEvent();
+}
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 union Buff6AndBuff8
 {
 	unsigned char buff6[6];
@@ -5631,7 +5754,6 @@ bool RakPeer::RunUpdateCycle(BitStream &updateBitStream )
 	SystemAddress systemAddress;
 	BufferedCommandStruct *bcs;
 	bool callerDataAllocationUsed;
-	RakNetStatistics *rnss;
 	RakNet::TimeUS timeNS=0;
 	RakNet::Time timeMS=0;
 
@@ -5646,7 +5768,7 @@ bool RakPeer::RunUpdateCycle(BitStream &updateBitStream )
 			SystemAddress sender;
 			char dataOut[ MAXIMUM_MTU_SIZE ];
 			do {
-				len = ((RNS2_Windows*)socketList[0])->GetSocketLayerOverride()->RakNetRecvFrom(dataOut,&sender,true);
+				len = static_cast<RNS2_Berkley*>(socketList[0])->GetSocketLayerOverride()->RakNetRecvFrom(dataOut,&sender,true); // DCS Copilot: RNS2_Windows only exists on Windows
 				if (len>0)
 					ProcessNetworkPacket( sender, dataOut, len, this, socketList[0], RakNet::GetTimeUS(), updateBitStream );
 			} while (len>0);
@@ -5883,6 +6005,27 @@ bool RakPeer::RunUpdateCycle(BitStream &updateBitStream )
 		requestedConnectionQueueMutex.Unlock();
 	}
 
+	// With update workers, every ReliabilityLayer::Update() runs first, spread over the workers and this thread. An update only
+	// touches its own layer and sends on the socket, so the layers are independent. Closing connections and handling what was
+	// received stay on this thread in the loop below. Plugins are called from inside Update(), so they keep everything serial.
+	bool parallelUpdate = updateWorkerPool.GetWorkerCount()>0 && pluginListNTS.Size()==0 && activeSystemListSize>=UPDATE_WORKER_MIN_SYSTEMS;
+	if (parallelUpdate)
+	{
+		if (timeNS==0)
+		{
+			timeNS = RakNet::GetTimeUS();
+			timeMS = (RakNet::TimeMS)(timeNS/(RakNet::TimeUS)1000);
+		}
+
+		for ( activeSystemListIndex = 0; activeSystemListIndex < activeSystemListSize; ++activeSystemListIndex )
+			SendKeepAliveIfIdle(activeSystemList[ activeSystemListIndex ], timeMS);
+
+		ReliabilityUpdateContext context;
+		context.rakPeer=this;
+		context.timeNS=timeNS;
+		updateWorkerPool.Run(UpdateReliabilityLayer, &context, activeSystemListSize, updateBitStream);
+	}
+
 	// remoteSystemList in network thread
 	for ( activeSystemListIndex = 0; activeSystemListIndex < activeSystemListSize; ++activeSystemListIndex )
 	//for ( remoteSystemIndex = 0; remoteSystemIndex < remoteSystemListSize; ++remoteSystemIndex )
@@ -5909,22 +6052,13 @@ bool RakPeer::RunUpdateCycle(BitStream &updateBitStream )
 			}
 
 
-			if (timeMS > remoteSystem->lastReliableSend && timeMS-remoteSystem->lastReliableSend > remoteSystem->reliabilityLayer.GetTimeoutTime()/2 && remoteSystem->connectMode==RemoteSystemStruct::CONNECTED)
+			if (parallelUpdate==false)
 			{
-				// If no reliable packets are waiting for an ack, do a one byte reliable send so that disconnections are noticed
-				RakNetStatistics rakNetStatistics;
-				rnss=remoteSystem->reliabilityLayer.GetStatistics(&rakNetStatistics);
-				if (rnss->messagesInResendBuffer==0)
-				{
-					PingInternal( systemAddress, true, RELIABLE );
+				SendKeepAliveIfIdle(remoteSystem, timeMS);
 
-					//remoteSystem->lastReliableSend=timeMS+remoteSystem->reliabilityLayer.GetTimeoutTime();
-					remoteSystem->lastReliableSend=timeMS;
-				}
+				remoteSystem->reliabilityLayer.Update( remoteSystem->rakNetSocket, systemAddress, remoteSystem->MTUSize, timeNS, maxOutgoingBPS, pluginListNTS, &rnr, updateBitStream ); // systemAddress only used for the internet simulator test
 			}
 
-			remoteSystem->reliabilityLayer.Update( remoteSystem->rakNetSocket, systemAddress, remoteSystem->MTUSize, timeNS, maxOutgoingBPS, pluginListNTS, &rnr, updateBitStream ); // systemAddress only used for the internet simulator test
-
 			// Check for failure conditions
 			if ( remoteSystem->reliabilityLayer.IsDeadConnection() ||
 				((remoteSystem->connectMode==RemoteSystemStruct::DISCONNECT_ASAP || remoteSystem->connectMode==RemoteSystemStruct::DISCONNECT_ASAP_SILENTLY) && remoteSystem->reliabilityLayer.IsOutgoingDataWaiting()==false) ||
@@ -6412,10 +6546,12 @@ RAK_THREAD_DECLARATION(RakNet::UpdateNetworkLoop)
 		if (rakPeer->userUpdateThreadPtr)
 			rakPeer->userUpdateThreadPtr(rakPeer, rakPeer->userUpdateThreadData);
 
+		RakNet::TimeUS updateStartUS=RakNet::GetTimeUS();
 		rakPeer->RunUpdateCycle(updateBitStream);
+		rakPeer->tickScheduler.RecordUpdateTime(RakNet::GetTimeUS()-updateStartUS);
 
-		// Pending sends go out this often, unless quitAndDataEvents is set
-		rakPeer->quitAndDataEvents.WaitOnEvent(10); //rakPeer->tickTime
+		// Pending sends go out once per tickTime, unless quitAndDataEvents is set
+		rakPeer->tickScheduler.WaitForNextTick((RakNet::TimeUS) rakPeer->tickTime * 1000, rakPeer->quitAndDataEvents);
 
 		/*
 
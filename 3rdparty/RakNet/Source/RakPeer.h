@@ -31,7 +31,10 @@
 //#include "RakNetSocket.h"
 #include "RakNetSmartPtr.h"
 #include "DS_ThreadsafeAllocatingQueue.h"
+#include "DS_LocklessAllocatingQueue.h"
 #include "SignaledEvent.h"
+#include "TickScheduler.h"
+#include "UpdateWorkerPool.h"
 #include "NativeFeatureIncludes.h"
 #include "SecureHandshake.h"
 #include "LocklessTypes.h"
@@ -274,6 +277,16 @@ public:
 	/// \sa RakNetTypes.h contains struct Packet.
 	Packet* Receive( void );
 
+	/// \brief Blocks the calling thread until a message is waiting to be returned by Receive(), or until \a timeoutMS elapses.
+	/// \param[in] timeoutMS Maximum time to wait, in milliseconds. 0 only checks the queue and never blocks.
+	/// \return true if a message is waiting, false on timeout.
+	bool WaitForPacket( RakNet::TimeMS timeoutMS );
+
+	/// \brief Sets an additional event to signal whenever a message is added to the incoming message queue.
+	/// \details Lets one thread wait on several RakPeer instances. The event must outlive this instance, or be cleared first by passing 0.
+	/// \param[in] event The event to signal, or 0 for none.
+	void SetPacketReadyEvent( SignaledEvent *event );
+
 	/// \brief Call this to deallocate a message returned by Receive() when you are done handling it.
 	/// \param[in] packet Message to deallocate.	
 	void DeallocatePacket( Packet *packet );
@@ -468,6 +481,22 @@ public:
 	/// \return Time in milliseconds between update ticks
 	RakNet::TimeMS GetTickTime(void) const;
 
+	/// \brief Sets how long the update thread spins at the end of each tick instead of sleeping.
+	/// \param[in] spinTimeUS Time in microseconds. 0 (the default) always sleeps.
+	void SetTickSpinTime(RakNet::TimeUS spinTimeUS);
+
+	/// \brief Returns how closely the update thread has kept to its tick time since Startup().
+	/// \param[out] stats Filled in with the tick count, jitter and update cycle time.
+	void GetTickStatistics(TickStatistics *stats) const;
+
+	/// \brief Sets how many extra threads update the reliability layers of the connected systems in parallel.
+	/// \details Takes effect at the next Startup(). Only used while no plugins are attached.
+	/// \param[in] workerCount Threads besides the update thread. 0 (the default) updates every connection on the update thread.
+	void SetUpdateWorkers(unsigned int workerCount);
+
+	/// \brief Returns the value passed to SetUpdateWorkers()
+	unsigned int GetUpdateWorkers(void) const;
+
 	/// \brief Returns the current MTU size
 	/// \param[in] target Which system to get MTU for.  UNASSIGNED_SYSTEM_ADDRESS to get the default
 	/// \return The current MTU size of the target system.
@@ -901,7 +930,8 @@ protected:
 	// Single producer single consumer queue using a linked list
 	//BufferedCommandStruct* bufferedCommandReadIndex, bufferedCommandWriteIndex;
 
-	DataStructures::ThreadsafeAllocatingQueue<BufferedCommandStruct> bufferedCommands;
+	// Sends from the user thread go through here, so the hand-off to the update thread never blocks on a lock
+	DataStructures::LocklessAllocatingQueue<BufferedCommandStruct> bufferedCommands;
 
 
 	// DataStructures::ThreadsafeAllocatingQueue<RNS2RecvStruct> bufferedPackets;
@@ -930,6 +960,10 @@ protected:
 	bool AllowIncomingConnections(void) const;
 
 	void PingInternal( const SystemAddress target, bool performImmediate, PacketReliability reliability );
+	/// One byte reliable send to a connected system with nothing waiting for an ack, so a lost connection is still noticed
+	void SendKeepAliveIfIdle( RemoteSystemStruct *remoteSystem, RakNet::Time timeMS );
+	/// UpdateWorkerPool::WorkFunction that runs ReliabilityLayer::Update() for one entry of activeSystemList
+	static void UpdateReliabilityLayer( void *context, unsigned int index, BitStream &scratch );
 	// This stores the user send calls to be handled by the update thread.  This way we don't have thread contention over systemAddresss
 	void CloseConnectionInternal( const AddressOrGUID& systemIdentifier, bool sendDisconnectionNotification, bool performImmediate, unsigned char orderingChannel, PacketPriority disconnectionNotificationPriority );
 	void SendBuffered( const char *data, BitSize_t numberOfBitsToSend, PacketPriority priority, PacketReliability reliability, char orderingChannel, const AddressOrGUID systemIdentifier, bool broadcast, RemoteSystemStruct::ConnectMode connectionMode, uint32_t receipt );
@@ -996,6 +1030,9 @@ protected:
 
 
 	SignaledEvent quitAndDataEvents;
+	TickScheduler tickScheduler; /// Paces UpdateNetworkLoop to tickTime
+	UpdateWorkerPool updateWorkerPool; /// Shares ReliabilityLayer::Update() of the active systems with the update thread
+	unsigned int updateWorkerCount;
 	bool limitConnectionFrequencyFromTheSameIP;
 
 	SimpleMutex packetAllocationPoolMutex;
@@ -1003,6 +1040,11 @@ protected:
 
 	SimpleMutex packetReturnMutex;
 	DataStructures::Queue<Packet*> packetReturnQueue;
+	// Signaled whenever packetReturnQueue is pushed, so the user thread can sleep in WaitForPacket() instead of polling Receive()
+	SignaledEvent packetReadyEvent;
+	// Optional user event, signaled along with packetReadyEvent. Guarded by packetReturnMutex
+	SignaledEvent *userPacketReadyEvent;
+	void SignalPacketReady(void);
 	Packet *AllocPacket(unsigned dataSize, const char *file, unsigned int line);
 	Packet *AllocPacket(unsigned dataSize, unsigned char *data, const char *file, unsigned int line);
 
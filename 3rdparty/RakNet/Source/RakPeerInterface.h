@@ -35,6 +35,8 @@ struct RakNetStatistics;
 struct RakNetBandwidth;
 class RouterInterface;
 class NetworkIDManager;
+class SignaledEvent;
+struct TickStatistics;
 
 /// The primary interface for RakNet, RakPeer contains all major functions for the library.
 /// See the individual functions for what the class can do.
@@ -247,6 +249,18 @@ public:
 	/// sa RakNetTypes.h contains struct Packet
 	virtual Packet* Receive( void )=0;
 
+	/// Blocks the calling thread until a message is waiting in the incoming message queue, or until \a timeoutMS elapses.
+	/// Call Receive() in a loop afterwards, as usual. A timeout of 0 only checks the queue and never blocks.
+	/// \param[in] timeoutMS Maximum time to wait, in milliseconds.
+	/// \return true if a message is waiting to be returned by Receive(), false on timeout.
+	virtual bool WaitForPacket( RakNet::TimeMS timeoutMS )=0;
+
+	/// Sets an additional event to signal whenever a message is added to the incoming message queue.
+	/// Use this to wait on several RakPeer instances (and anything else of your own) from a single thread.
+	/// The event must outlive this instance, or be cleared first by passing 0.
+	/// \param[in] event The event to signal, or 0 for none.
+	virtual void SetPacketReadyEvent( SignaledEvent *event )=0;
+
 	/// Call this to deallocate a message returned by Receive() when you are done handling it.
 	/// \param[in] packet The message to deallocate.	
 	virtual void DeallocatePacket( Packet *packet )=0;
@@ -437,6 +451,22 @@ public:
 	/// \return Time in milliseconds between update ticks
 	virtual RakNet::TimeMS GetTickTime(void) const = 0;
 
+	/// Sets how long the update thread spins at the end of each tick instead of sleeping, for sub-millisecond tick accuracy at the cost of CPU.
+	/// \param[in] spinTimeUS Time in microseconds. 0 (the default) always sleeps.
+	virtual void SetTickSpinTime(RakNet::TimeUS spinTimeUS) = 0;
+
+	/// \brief Returns how closely the update thread has kept to its tick time since Startup().
+	/// \param[out] stats Filled in with the tick count, jitter and update cycle time.
+	virtual void GetTickStatistics(TickStatistics *stats) const = 0;
+
+	/// Sets how many extra threads update the reliability layers of the connected systems in parallel, for hosts with many connections.
+	/// Takes effect at the next Startup(). Only used while no plugins are attached.
+	/// \param[in] workerCount Threads besides the update thread. 0 (the default) updates every connection on the update thread.
+	virtual void SetUpdateWorkers(unsigned int workerCount) = 0;
+
+	/// \brief Returns the value passed to SetUpdateWorkers()
+	virtual unsigned int GetUpdateWorkers(void) const = 0;
+
 	/// Returns the current MTU size
 	/// \param[in] target Which system to get this for.  UNASSIGNED_SYSTEM_ADDRESS to get the default
 	/// \return The current MTU size
@@ -14,6 +14,7 @@
 #include "GetTime.h"
 
 #if defined(__GNUC__) 
+#include <errno.h>
 #include <sys/time.h>
 #include <unistd.h>
 #endif
@@ -110,13 +111,12 @@ void SignaledEvent::SetEvent(void)
 
 #else
 	// Different from SetEvent which stays signaled.
-	// We have to record manually that the event was signaled
-	isSignaledMutex.Lock();
+	// The flag is set under the mutex the waiter checks it under, so a signal between the check and
+	// pthread_cond_timedwait is not missed
+	pthread_mutex_lock(&hMutex);
 	isSignaled=true;
-	isSignaledMutex.Unlock();
-
-	// Unblock waiting threads
 	pthread_cond_broadcast(&eventList);
+	pthread_mutex_unlock(&hMutex);
 #endif
 }
 
@@ -172,96 +172,26 @@ void SignaledEvent::WaitOnEvent(int timeoutMs)
 
 #else
 
-	// If was previously set signaled, just unset and return
-	isSignaledMutex.Lock();
-	if (isSignaled==true)
+	RakNet::TimeVal tp;
+	RakNet::gettimeofday(&tp, NULL);
+	struct timespec ts;
+	ts.tv_sec = tp.tv_sec + timeoutMs / 1000;
+	ts.tv_nsec = tp.tv_usec * 1000 + (long) (timeoutMs % 1000) * 1000000;
+	if (ts.tv_nsec >= 1000000000)
 	{
-		isSignaled=false;
-		isSignaledMutex.Unlock();
-		return;
+		ts.tv_nsec -= 1000000000;
+		ts.tv_sec++;
 	}
-	isSignaledMutex.Unlock();
-
-	
-
-	//struct timespec   ts;
-
-	// Else wait for SetEvent to be called
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-		struct timespec   ts;
-
-		int rc;
-		//struct timeval    tp;
-		//rc =  gettimeofday(&tp, NULL);
-		RakNet::TimeVal tp;
-		rc = RakNet::gettimeofday(&tp, NULL);
-		ts.tv_sec  = tp.tv_sec;
-		ts.tv_nsec = tp.tv_usec * 1000;
-// #endif
-
-		while (timeoutMs > 30)
-		{
-			// Wait 30 milliseconds for the signal, then check again.
-			// This is in case we  missed the signal between the top of this function and pthread_cond_timedwait, or after the end of the loop and pthread_cond_timedwait
-			ts.tv_nsec += 30*1000000;
-			if (ts.tv_nsec >= 1000000000)
-			{
-			        ts.tv_nsec -= 1000000000;
-			        ts.tv_sec++;
-			}
-			
-			// [SBC] added mutex lock/unlock around cond_timedwait.
-            // this prevents airplay from generating a whole much of errors.
-            // not sure how this works on other platforms since according to
-            // the docs you are suppost to hold the lock before you wait
-            // on the cond.
-            pthread_mutex_lock(&hMutex);
-			pthread_cond_timedwait(&eventList, &hMutex, &ts);
-            pthread_mutex_unlock(&hMutex);
-
-			timeoutMs-=30;
-
-			isSignaledMutex.Lock();
-			if (isSignaled==true)
-			{
-				isSignaled=false;
-				isSignaledMutex.Unlock();
-				return;
-			}
-			isSignaledMutex.Unlock();
-		}
-
-		// Wait the remaining time, and turn off the signal in case it was set
-		ts.tv_nsec += timeoutMs*1000000;
-		if (ts.tv_nsec >= 1000000000)
-		{
-		        ts.tv_nsec -= 1000000000;
-		        ts.tv_sec++;
-		}
-
-		pthread_mutex_lock(&hMutex);
-		pthread_cond_timedwait(&eventList, &hMutex, &ts);
-        pthread_mutex_unlock(&hMutex);
-
-		isSignaledMutex.Lock();
-		isSignaled=false;
-		isSignaledMutex.Unlock();
 
+	// isSignaled is only touched under hMutex, so SetEvent cannot slip in between the check and the wait.
+	// The first waiter to take the mutex consumes the signal, as with an auto-reset event on Windows.
+	pthread_mutex_lock(&hMutex);
+	while (isSignaled==false)
+	{
+		if (pthread_cond_timedwait(&eventList, &hMutex, &ts)==ETIMEDOUT)
+			break;
+	}
+	isSignaled=false;
+	pthread_mutex_unlock(&hMutex);
 #endif
 }
@@ -53,8 +53,7 @@ protected:
 
 
 #else
-	SimpleMutex isSignaledMutex;
-	bool isSignaled;
+	bool isSignaled; // Guarded by hMutex
 #if !defined(ANDROID)
 	pthread_condattr_t condAttr;
 #endif
@@ -0,0 +1,187 @@
+/*
+ *  Added to RakNet for DCS Copilot. Distributed under the same BSD-style license
+ *  as the rest of RakNet, found in the LICENSE file in the root directory of this source tree.
+ *
+ */
+
+#include "TickScheduler.h"
+#include "SignaledEvent.h"
+#include "GetTime.h"
+
+#if defined(_WIN32)
+#include "WindowsIncludes.h"
+#if !defined(WINDOWS_STORE_RT)
+#include <mmsystem.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "winmm.lib")
+#endif
+#endif
+#else
+#include <sched.h>
+#endif
+
+using namespace RakNet;
+
+// One step of the spin tail. A pause hint where there is one, as sleeping for 0 ms gives the time slice away on POSIX
+static inline void SpinPause(void)
+{
+#if defined(_WIN32)
+	YieldProcessor();
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	__builtin_ia32_pause();
+#else
+	sched_yield();
+#endif
+}
+
+TickScheduler::TickScheduler()
+{
+	nextDeadline=0;
+	periodUS=0;
+	jitterSumUS=0;
+	updateSumUS=0;
+	updateCount=0;
+	spinTime=0;
+	timerResolutionRaised=false;
+	statistics.periodUS=0;
+	statistics.tickCount=0;
+	statistics.lateTickCount=0;
+	statistics.earlyWakeCount=0;
+	statistics.lastJitterUS=0;
+	statistics.maxJitterUS=0;
+	statistics.averageJitterUS=0;
+	statistics.lastUpdateUS=0;
+	statistics.maxUpdateUS=0;
+	statistics.averageUpdateUS=0;
+}
+TickScheduler::~TickScheduler()
+{
+	Stop();
+}
+void TickScheduler::Start(void)
+{
+	nextDeadline=0;
+	periodUS=0;
+	jitterSumUS=0;
+	updateSumUS=0;
+	updateCount=0;
+
+	statisticsMutex.Lock();
+	statistics.periodUS=0;
+	statistics.tickCount=0;
+	statistics.lateTickCount=0;
+	statistics.earlyWakeCount=0;
+	statistics.lastJitterUS=0;
+	statistics.maxJitterUS=0;
+	statistics.averageJitterUS=0;
+	statistics.lastUpdateUS=0;
+	statistics.maxUpdateUS=0;
+	statistics.averageUpdateUS=0;
+	statisticsMutex.Unlock();
+
+#if defined(_WIN32) && !defined(WINDOWS_STORE_RT)
+	if (timerResolutionRaised==false)
+		timerResolutionRaised = timeBeginPeriod(1)==TIMERR_NOERROR;
+#endif
+}
+void TickScheduler::Stop(void)
+{
+#if defined(_WIN32) && !defined(WINDOWS_STORE_RT)
+	if (timerResolutionRaised)
+		timeEndPeriod(1);
+#endif
+	timerResolutionRaised=false;
+}
+void TickScheduler::SetSpinTime(RakNet::TimeUS spinTimeUS)
+{
+	statisticsMutex.Lock();
+	spinTime=spinTimeUS;
+	statisticsMutex.Unlock();
+}
+RakNet::TimeUS TickScheduler::GetSpinTime(void) const
+{
+	statisticsMutex.Lock();
+	RakNet::TimeUS spinTimeUS=spinTime;
+	statisticsMutex.Unlock();
+	return spinTimeUS;
+}
+bool TickScheduler::WaitForNextTick(RakNet::TimeUS tickPeriodUS, SignaledEvent &wakeEvent)
+{
+	RakNet::TimeUS spinTimeUS=GetSpinTime();
+	RakNet::TimeUS now=RakNet::GetTimeUS();
+
+	if (nextDeadline==0 || tickPeriodUS!=periodUS)
+	{
+		// First tick, or the period changed (a client takes the server's tick time on connect)
+		periodUS=tickPeriodUS;
+		nextDeadline=now+periodUS;
+		statisticsMutex.Lock();
+		statistics.periodUS=periodUS;
+		statisticsMutex.Unlock();
+	}
+
+	if (now + spinTimeUS < nextDeadline)
+	{
+		RakNet::TimeUS sleepUS = nextDeadline - spinTimeUS - now;
+		// Without a spin tail round up, so the sleep itself does not end before the deadline
+		int sleepMS = (int) (spinTimeUS > 0 ? sleepUS / 1000 : (sleepUS + 999) / 1000);
+		if (sleepMS > 0)
+		{
+			wakeEvent.WaitOnEvent(sleepMS);
+			now=RakNet::GetTimeUS();
+			if (now + spinTimeUS < nextDeadline)
+			{
+				statisticsMutex.Lock();
+				statistics.earlyWakeCount++;
+				statisticsMutex.Unlock();
+				return false;
+			}
+		}
+	}
+
+	while (now < nextDeadline)
+	{
+		SpinPause();
+		now=RakNet::GetTimeUS();
+	}
+
+	RakNet::TimeUS jitterUS = now - nextDeadline;
+	jitterSumUS+=jitterUS;
+
+	statisticsMutex.Lock();
+	statistics.tickCount++;
+	statistics.lastJitterUS=jitterUS;
+	if (jitterUS > statistics.maxJitterUS)
+		statistics.maxJitterUS=jitterUS;
+	statistics.averageJitterUS=jitterSumUS/statistics.tickCount;
+	if (jitterUS >= periodUS)
+		statistics.lateTickCount++;
+	statisticsMutex.Unlock();
+
+	nextDeadline+=periodUS;
+	if (nextDeadline <= now)
+	{
+		// Overran a whole period. Restart from now rather than running the missed ticks back to back
+		nextDeadline=now+periodUS;
+	}
+
+	return true;
+}
+void TickScheduler::RecordUpdateTime(RakNet::TimeUS updateUS)
+{
+	updateSumUS+=updateUS;
+	updateCount++;
+
+	statisticsMutex.Lock();
+	statistics.lastUpdateUS=updateUS;
+	if (updateUS > statistics.maxUpdateUS)
+		statistics.maxUpdateUS=updateUS;
+	statistics.averageUpdateUS=updateSumUS/updateCount;
+	statisticsMutex.Unlock();
+}
+void TickScheduler::GetStatistics(TickStatistics *stats) const
+{
+	statisticsMutex.Lock();
+	*stats=statistics;
+	statisticsMutex.Unlock();
+}
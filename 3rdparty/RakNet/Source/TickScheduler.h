@@ -0,0 +1,108 @@
+/*
+ *  Added to RakNet for DCS Copilot. Distributed under the same BSD-style license
+ *  as the rest of RakNet, found in the LICENSE file in the root directory of this source tree.
+ *
+ */
+
+/// \file TickScheduler.h
+/// \brief Paces the RakPeer update thread to a fixed tick using absolute deadlines, and records how late each tick started and how long each update took.
+///
+
+
+#ifndef __TICK_SCHEDULER_H
+#define __TICK_SCHEDULER_H
+
+#include "Export.h"
+#include "RakNetTime.h"
+#include "SimpleMutex.h"
+
+namespace RakNet
+{
+class SignaledEvent;
+
+/// Timing of the RakPeer update thread, as returned by RakPeerInterface::GetTickStatistics()
+/// Jitter is how long after its deadline a tick actually started.
+struct RAK_DLL_EXPORT TickStatistics
+{
+	/// Current tick period, in microseconds
+	RakNet::TimeUS periodUS;
+
+	/// Ticks run on schedule since Startup()
+	uint64_t tickCount;
+
+	/// Ticks that started a full period or more late. The schedule restarts from that tick, so missed ticks are not run back to back.
+	uint64_t lateTickCount;
+
+	/// Update cycles run between ticks because the wake event was set (a Send with IMMEDIATE_PRIORITY, for example)
+	uint64_t earlyWakeCount;
+
+	/// Jitter of the most recent tick
+	RakNet::TimeUS lastJitterUS;
+
+	/// Largest jitter since Startup()
+	RakNet::TimeUS maxJitterUS;
+
+	/// Average jitter since Startup()
+	RakNet::TimeUS averageJitterUS;
+
+	/// Time the most recent update cycle took, in microseconds
+	RakNet::TimeUS lastUpdateUS;
+
+	/// Longest update cycle since Startup()
+	RakNet::TimeUS maxUpdateUS;
+
+	/// Average update cycle since Startup(), early wakes included
+	RakNet::TimeUS averageUpdateUS;
+};
+
+/// \brief Paces a loop to a fixed tick using absolute deadlines.
+/// \details Each deadline is the previous deadline plus the period, not the wake time plus the period, so the loop does not drift by the time spent in the update.
+/// The wait sleeps on an event so it can be woken early. If a spin time is set, the last part of each wait is spent polling the clock instead of sleeping,
+/// which trades some CPU for sub-millisecond accuracy on systems where the sleep granularity is a millisecond or more.
+/// \note On Windows the system timer resolution is raised to 1 ms between Start() and Stop(), otherwise sleeps are rounded up to about 15.6 ms.
+class RAK_DLL_EXPORT TickScheduler
+{
+public:
+	TickScheduler();
+	~TickScheduler();
+
+	/// Clears the schedule and statistics. The first tick is one period after the first call to WaitForNextTick()
+	void Start(void);
+
+	/// Releases the timer resolution requested by Start()
+	void Stop(void);
+
+	/// Time at the end of each wait to spin instead of sleep, in microseconds. 0 (the default) never spins.
+	void SetSpinTime(RakNet::TimeUS spinTimeUS);
+	RakNet::TimeUS GetSpinTime(void) const;
+
+	/// Waits until the next deadline, or until \a wakeEvent is set.
+	/// A change in \a tickPeriodUS restarts the schedule from now.
+	/// \param[in] tickPeriodUS Time between ticks, in microseconds.
+	/// \param[in] wakeEvent Event that ends the wait early.
+	/// \return true if the deadline was reached, false if woken early by \a wakeEvent.
+	bool WaitForNextTick(RakNet::TimeUS tickPeriodUS, SignaledEvent &wakeEvent);
+
+	/// Records how long one update cycle took. Called by the same thread as WaitForNextTick().
+	void RecordUpdateTime(RakNet::TimeUS updateUS);
+
+	/// Copies the current statistics. Safe to call from any thread.
+	void GetStatistics(TickStatistics *stats) const;
+
+protected:
+	// Only touched by the thread calling WaitForNextTick
+	RakNet::TimeUS nextDeadline;
+	RakNet::TimeUS periodUS;
+	RakNet::TimeUS jitterSumUS;
+	RakNet::TimeUS updateSumUS;
+	uint64_t updateCount;
+
+	mutable SimpleMutex statisticsMutex;
+	TickStatistics statistics;
+	RakNet::TimeUS spinTime;
+	bool timerResolutionRaised;
+};
+
+} // namespace RakNet
+
+#endif
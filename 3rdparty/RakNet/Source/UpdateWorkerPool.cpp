@@ -0,0 +1,168 @@
+/*
+ *  Added to RakNet for DCS Copilot. Distributed under the same BSD-style license
+ *  as the rest of RakNet, found in the LICENSE file in the root directory of this source tree.
+ *
+ */
+
+#include "UpdateWorkerPool.h"
+#include "BitStream.h"
+#include "MTUSize.h"
+#include "RakMemoryOverride.h"
+#include "RakSleep.h"
+#include "RakThread.h"
+#include "SignaledEvent.h"
+
+using namespace RakNet;
+
+// Longest a worker sleeps between checks for Stop()
+static const int UPDATE_WORKER_IDLE_WAIT_MS=100;
+
+// Index stored in the cursor once a batch is finished, higher than any count
+static const uint32_t UPDATE_WORKER_BATCH_CLOSED=0xFFFFFFFF;
+
+struct UpdateWorkerPool::Worker
+{
+	Worker() : pool(0), scratch(MAXIMUM_MTU_SIZE) {wakeEvent.InitEvent();}
+	~Worker() {wakeEvent.CloseEvent();}
+
+	UpdateWorkerPool *pool;
+	SignaledEvent wakeEvent;
+	BitStream scratch;
+};
+
+namespace RakNet
+{
+RAK_THREAD_DECLARATION(UpdateWorkerLoop)
+{
+	UpdateWorkerPool::Worker *worker = (UpdateWorkerPool::Worker *) arguments;
+	UpdateWorkerPool *pool = worker->pool;
+
+	while (pool->stopWorkers.load(std::memory_order_acquire)==false)
+	{
+		worker->wakeEvent.WaitOnEvent(UPDATE_WORKER_IDLE_WAIT_MS);
+		if (pool->stopWorkers.load(std::memory_order_acquire))
+			break;
+		pool->RunItems(worker->scratch);
+	}
+
+	pool->runningWorkers.fetch_sub(1, std::memory_order_release);
+	return 0;
+}
+}
+
+UpdateWorkerPool::UpdateWorkerPool()
+{
+	workers=0;
+	workerCount=0;
+	runningWorkers.store(0);
+	stopWorkers.store(false);
+	cursor.store(UPDATE_WORKER_BATCH_CLOSED);
+	completed.store(0);
+	batchWork.store(0);
+	batchContext.store(0);
+	batchCount.store(0);
+	generation=0;
+	doneEvent.InitEvent();
+}
+UpdateWorkerPool::~UpdateWorkerPool()
+{
+	Stop();
+	doneEvent.CloseEvent();
+}
+bool UpdateWorkerPool::Start(unsigned int count, int threadPriority)
+{
+	Stop();
+	if (count==0)
+		return true;
+
+	workers=RakNet::OP_NEW_ARRAY<Worker>(count, _FILE_AND_LINE_);
+	stopWorkers.store(false, std::memory_order_release);
+
+	for (unsigned int i=0; i < count; i++)
+	{
+		workers[i].pool=this;
+		runningWorkers.fetch_add(1, std::memory_order_acq_rel);
+		if (RakThread::Create(UpdateWorkerLoop, &workers[i], threadPriority)!=0)
+		{
+			runningWorkers.fetch_sub(1, std::memory_order_acq_rel);
+			return false;
+		}
+		workerCount++;
+	}
+
+	return true;
+}
+void UpdateWorkerPool::Stop(void)
+{
+	if (workers==0)
+		return;
+
+	stopWorkers.store(true, std::memory_order_release);
+	for (unsigned int i=0; i < workerCount; i++)
+		workers[i].wakeEvent.SetEvent();
+	while (runningWorkers.load(std::memory_order_acquire)>0)
+		RakSleep(1);
+
+	RakNet::OP_DELETE_ARRAY(workers, _FILE_AND_LINE_);
+	workers=0;
+	workerCount=0;
+}
+unsigned int UpdateWorkerPool::GetWorkerCount(void) const
+{
+	return workerCount;
+}
+void UpdateWorkerPool::Run(WorkFunction work, void *context, unsigned int count, BitStream &callerScratch)
+{
+	if (count==0)
+		return;
+
+	if (workerCount==0)
+	{
+		for (unsigned int i=0; i < count; i++)
+			work(context, i, callerScratch);
+		return;
+	}
+
+	// The previous batch was closed before Run() returned, so no worker can claim from this one until the cursor is published
+	generation++;
+	batchWork.store(work, std::memory_order_relaxed);
+	batchContext.store(context, std::memory_order_relaxed);
+	batchCount.store(count, std::memory_order_relaxed);
+	completed.store(0, std::memory_order_relaxed);
+	cursor.store((uint64_t) generation << 32, std::memory_order_release);
+
+	// Wake no more workers than there are items the caller will not take itself
+	unsigned int wakeCount = count-1 < workerCount ? count-1 : workerCount;
+	for (unsigned int i=0; i < wakeCount; i++)
+		workers[i].wakeEvent.SetEvent();
+
+	// The caller claims items like any worker, so it only waits for the ones still running when the cursor ran out
+	RunItems(callerScratch);
+	while (completed.load(std::memory_order_acquire) < count)
+		doneEvent.WaitOnEvent(UPDATE_WORKER_IDLE_WAIT_MS);
+
+	cursor.store(((uint64_t) generation << 32) | UPDATE_WORKER_BATCH_CLOSED, std::memory_order_release);
+}
+void UpdateWorkerPool::RunItems(BitStream &scratch)
+{
+	for (;;)
+	{
+		uint64_t claimed = cursor.load(std::memory_order_acquire);
+		uint32_t index = (uint32_t) claimed;
+		if (index==UPDATE_WORKER_BATCH_CLOSED || index >= batchCount.load(std::memory_order_relaxed))
+			return;
+
+		WorkFunction work = batchWork.load(std::memory_order_relaxed);
+		void *context = batchContext.load(std::memory_order_relaxed);
+
+		// Fails if another thread took this index, or the batch was closed and a new one published since the load
+		if (cursor.compare_exchange_weak(claimed, claimed+1, std::memory_order_acq_rel, std::memory_order_acquire)==false)
+			continue;
+
+		work(context, index, scratch);
+
+		// A signal left over when the caller finished the last item itself only costs the next Run() one more check
+		if (completed.fetch_add(1, std::memory_order_release)+1==batchCount.load(std::memory_order_relaxed))
+			doneEvent.SetEvent();
+	}
+}
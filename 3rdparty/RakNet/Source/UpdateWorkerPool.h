@@ -0,0 +1,82 @@
+/*
+ *  Added to RakNet for DCS Copilot. Distributed under the same BSD-style license
+ *  as the rest of RakNet, found in the LICENSE file in the root directory of this source tree.
+ *
+ */
+
+/// \file UpdateWorkerPool.h
+/// \brief Splits the per-connection part of the RakPeer update cycle across a few threads.
+///
+
+
+#ifndef __UPDATE_WORKER_POOL_H
+#define __UPDATE_WORKER_POOL_H
+
+#include "Export.h"
+#include "NativeTypes.h"
+#include "RakThread.h"
+#include "SignaledEvent.h"
+#include <atomic>
+
+namespace RakNet
+{
+class BitStream;
+
+/// \brief Small fixed pool of threads that run one batch of independent work items at a time.
+/// \details Run() hands the items out through a single atomic cursor, so there is no lock between the caller and the workers.
+/// Each item is claimed by exactly one thread, the caller included, and Run() returns once every item has finished.
+/// A caller that runs out of items to claim waits on an event the thread finishing the last item sets.
+/// The cursor carries a generation number next to the item index, so a worker that wakes late cannot claim an item of a later batch.
+/// Every thread gets its own scratch BitStream, as each ReliabilityLayer::Update() needs one to build datagrams in.
+/// \note Start(), Stop() and Run() are for the RakPeer update thread only, and not while a Run() is in progress.
+class RAK_DLL_EXPORT UpdateWorkerPool
+{
+public:
+	/// \param[in] context As passed to Run()
+	/// \param[in] index Item to process, 0 to count-1
+	/// \param[in] scratch Scratch BitStream owned by the running thread
+	typedef void (*WorkFunction)(void *context, unsigned int index, BitStream &scratch);
+
+	UpdateWorkerPool();
+	~UpdateWorkerPool();
+
+	/// Starts \a workerCount threads. 0 stops the pool, and Run() then does all the work on the calling thread.
+	/// \return false if a thread could not be created. The threads that did start are kept.
+	bool Start(unsigned int workerCount, int threadPriority);
+
+	/// Stops and waits for every thread
+	void Stop(void);
+
+	/// Threads running, not counting the caller of Run()
+	unsigned int GetWorkerCount(void) const;
+
+	/// Calls \a work for each index below \a count, spread over the workers and the calling thread, and waits for all of them.
+	/// \param[in] callerScratch Scratch BitStream for the items the calling thread runs itself
+	void Run(WorkFunction work, void *context, unsigned int count, BitStream &callerScratch);
+
+protected:
+	struct Worker;
+
+	/// Claims and runs items of the current batch until none are left
+	void RunItems(BitStream &scratch);
+
+	Worker *workers;
+	unsigned int workerCount;
+	std::atomic<unsigned int> runningWorkers;
+	std::atomic<bool> stopWorkers;
+
+	// Batch in progress. The cursor holds the generation in the high 32 bits and the next unclaimed index in the low 32 bits.
+	std::atomic<uint64_t> cursor;
+	std::atomic<unsigned int> completed;
+	std::atomic<WorkFunction> batchWork;
+	std::atomic<void*> batchContext;
+	std::atomic<unsigned int> batchCount;
+	uint32_t generation;
+	SignaledEvent doneEvent;
+
+	friend RAK_THREAD_DECLARATION(UpdateWorkerLoop);
+};
+
+} // namespace RakNet
+
+#endif
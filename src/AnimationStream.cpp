@@ -0,0 +1,365 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       AnimationStream.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      AnimationSender and AnimationReceiver Classes
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Keyframe and delta encoding of DCS animation arguments.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+Values are quantized before they are compared, so noise below the 16 bit step
+does not count as a change.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "AnimationStream.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "BitStream.h"
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+const unsigned int SMALL_DELTA_BITS = 6;
+const unsigned int SMALL_DELTA_MAX = 1 << SMALL_DELTA_BITS;
+
+//an even number of steps puts the middle of the range (0 for -1..1) exactly on a step
+const float VALUE_STEPS = 65534.0f;
+
+inline bool argumentLess(const Network::AnimationArgument& arg, unsigned short argument)
+{
+    return arg.argument < argument;
+}
+
+inline const Network::AnimationArgument* findArgument(const std::vector<Network::AnimationArgument>& arguments, unsigned short argument)
+{
+    auto it = std::lower_bound(arguments.begin(), arguments.end(), argument, argumentLess);
+    if (it != arguments.end() && it->argument == argument)
+        return &(*it);
+    return nullptr;
+}
+
+inline unsigned short encodeValue(float value)
+{
+    if (value < Network::ANIMATION_VALUE_MIN)
+        value = Network::ANIMATION_VALUE_MIN;
+    else if (value > Network::ANIMATION_VALUE_MAX)
+        value = Network::ANIMATION_VALUE_MAX;
+
+    return (unsigned short)lroundf((value - Network::ANIMATION_VALUE_MIN) / (Network::ANIMATION_VALUE_MAX - Network::ANIMATION_VALUE_MIN) * VALUE_STEPS);
+}
+
+inline float decodeValue(unsigned short step)
+{
+    if (step > (unsigned short)VALUE_STEPS)
+        step = (unsigned short)VALUE_STEPS;
+
+    return Network::ANIMATION_VALUE_MIN + (float)step * (Network::ANIMATION_VALUE_MAX - Network::ANIMATION_VALUE_MIN) / VALUE_STEPS;
+}
+
+inline bool argumentOrder(const Network::AnimationArgument& a, const Network::AnimationArgument& b)
+{
+    return a.argument < b.argument;
+}
+
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+AnimationSender::AnimationSender()
+{
+    reset();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void AnimationSender::setArguments(const std::vector<AnimationArgument>& arguments)
+{
+    for (const auto& arg : arguments)
+    {
+        float value = quantize(arg.value);
+
+        auto it = std::lower_bound(current.begin(), current.end(), arg.argument, argumentLess);
+        if (it != current.end() && it->argument == arg.argument)
+        {
+            if (it->value != value)
+            {
+                it->value = value;
+                changed = true;
+            }
+        }
+        else if (current.size() < MAX_ANIMATION_ARGUMENTS)
+        {
+            AnimationArgument newArg;
+            newArg.argument = arg.argument;
+            newArg.value = value;
+            current.insert(it, newArg);
+            changed = true;
+        }
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool AnimationSender::hasChanges() const
+{
+    return changed;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool AnimationSender::needsKeyframe(RakNet::Time currentTime) const
+{
+    if (keyframeRequested)
+        return !current.empty();
+
+    size_t numChanged = countChangedArguments();
+    if (numChanged == 0)
+        return false;
+
+    //once most arguments moved, a keyframe costs no more than a delta and stops the deltas growing
+    if (numChanged * 2 >= current.size())
+        return true;
+
+    //while arguments keep moving every delta replaces a lost one. Once they stop, the
+    //last delta may have been lost, so the final state goes out reliably.
+    return !changed && currentTime - lastSendTime >= (RakNet::Time)ANIMATION_SETTLE_TIME_MS;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void AnimationSender::requestKeyframe()
+{
+    keyframeRequested = true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void AnimationSender::writeKeyframe(RakNet::BitStream& bsOut, RakNet::Time currentTime)
+{
+    keyframeID++;
+    keyframe = current;
+    lastSendTime = currentTime;
+    keyframeRequested = false;
+    changed = false;
+
+    writeFrame(bsOut, keyframeID, keyframe);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void AnimationSender::writeDelta(RakNet::BitStream& bsOut, RakNet::Time currentTime)
+{
+    frame.clear();
+
+    //keyframe is a subset of current, so one pass over both in ID order finds every difference
+    auto keyIt = keyframe.begin();
+    for (const auto& arg : current)
+    {
+        while (keyIt != keyframe.end() && keyIt->argument < arg.argument)
+            ++keyIt;
+
+        if (keyIt == keyframe.end() || keyIt->argument != arg.argument || keyIt->value != arg.value)
+            frame.push_back(arg);
+    }
+    lastSendTime = currentTime;
+    changed = false;
+
+    writeFrame(bsOut, keyframeID, frame);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void AnimationSender::reset()
+{
+    current.clear();
+    keyframe.clear();
+    lastSendTime = 0;
+    keyframeRequested = true;
+    changed = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+float AnimationSender::quantize(float value)
+{
+    return decodeValue(encodeValue(value));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void AnimationSender::writeFrame(RakNet::BitStream& bsOut, unsigned char keyframeID, const std::vector<AnimationArgument>& arguments)
+{
+    bsOut.Write(keyframeID);
+
+    unsigned short count = (unsigned short)std::min(arguments.size(), (size_t)MAX_ANIMATION_ARGUMENTS);
+    bsOut.Write(count);
+
+    unsigned short lastArgument = 0;
+    for (unsigned short i = 0; i < count; i++)
+    {
+        const AnimationArgument& arg = arguments[i];
+
+        int delta = (int)arg.argument - (int)lastArgument;
+        if (i > 0 && delta > 0 && delta <= (int)SMALL_DELTA_MAX)
+        {
+            unsigned char smallDelta = (unsigned char)(delta - 1);
+            bsOut.Write1();
+            bsOut.WriteBits(&smallDelta, SMALL_DELTA_BITS);
+        }
+        else
+        {
+            bsOut.Write0();
+            bsOut.Write(arg.argument);
+        }
+        lastArgument = arg.argument;
+
+        bsOut.Write(encodeValue(arg.value));
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+size_t AnimationSender::countChangedArguments() const
+{
+    if (!changed)
+        return 0;
+
+    size_t numChanged = current.size() - keyframe.size();
+    for (const auto& arg : keyframe)
+    {
+        const AnimationArgument* currentArg = findArgument(current, arg.argument);
+        if (currentArg && currentArg->value != arg.value)
+            numChanged++;
+    }
+    return numChanged;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool AnimationReceiver::readFrame(RakNet::BitStream& bsIn, unsigned char& keyframeID, std::vector<AnimationArgument>& arguments)
+{
+    unsigned short count = 0;
+    if (!bsIn.Read(keyframeID) || !bsIn.Read(count) || count > MAX_ANIMATION_ARGUMENTS)
+        return false;
+
+    unsigned short lastArgument = 0;
+    for (unsigned short i = 0; i < count; i++)
+    {
+        AnimationArgument arg;
+
+        bool smallDelta = false;
+        if (!bsIn.Read(smallDelta))
+            return false;
+
+        if (smallDelta)
+        {
+            unsigned char delta = 0;
+            if (!bsIn.ReadBits(&delta, SMALL_DELTA_BITS))
+                return false;
+            arg.argument = (unsigned short)(lastArgument + delta + 1);
+        }
+        else if (!bsIn.Read(arg.argument)) {
+            return false;
+        }
+        lastArgument = arg.argument;
+
+        unsigned short step = 0;
+        if (!bsIn.Read(step))
+            return false;
+        arg.value = decodeValue(step);
+
+        arguments.push_back(arg);
+    }
+
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void AnimationReceiver::applyKeyframe(unsigned char newKeyframeID, const std::vector<AnimationArgument>& arguments, std::vector<AnimationArgument>& changedArguments)
+{
+    //the frame is in ID order from the sender, but a bad packet must not break the lookups
+    keyframe = arguments;
+    std::sort(keyframe.begin(), keyframe.end(), argumentOrder);
+    keyframeID = newKeyframeID;
+    hasKeyframe = true;
+
+    frame = keyframe;
+    applyFrame(changedArguments);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void AnimationReceiver::applyDelta(unsigned char deltaKeyframeID, const std::vector<AnimationArgument>& arguments, std::vector<AnimationArgument>& changedArguments)
+{
+    if (!hasKeyframe || deltaKeyframeID != keyframeID)
+        return;
+
+    frame = arguments;
+    std::sort(frame.begin(), frame.end(), argumentOrder);
+
+    //arguments missing from the delta are back at their keyframe value
+    size_t numDeltaArguments = frame.size();
+    for (const auto& arg : keyframe)
+    {
+        if (!std::binary_search(frame.begin(), frame.begin() + numDeltaArguments, arg, argumentOrder))
+            frame.push_back(arg);
+    }
+    std::inplace_merge(frame.begin(), frame.begin() + numDeltaArguments, frame.end(), argumentOrder);
+
+    applyFrame(changedArguments);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void AnimationReceiver::reset()
+{
+    keyframe.clear();
+    delivered.clear();
+    frame.clear();
+    keyframeID = 0;
+    hasKeyframe = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void AnimationReceiver::applyFrame(std::vector<AnimationArgument>& changedArguments)
+{
+    //frame holds the full state, sorted by ID
+    for (const auto& arg : frame)
+    {
+        auto it = std::lower_bound(delivered.begin(), delivered.end(), arg.argument, argumentLess);
+        if (it != delivered.end() && it->argument == arg.argument)
+        {
+            if (it->value == arg.value)
+                continue;
+            it->value = arg.value;
+        }
+        else
+        {
+            delivered.insert(it, arg);
+        }
+        changedArguments.push_back(arg);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
@@ -0,0 +1,188 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       AnimationStream.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef ANIMATIONSTREAM_H
+#define ANIMATIONSTREAM_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstddef>
+#include <vector>
+
+#include "RakNetTime.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const unsigned int MAX_ANIMATION_ARGUMENTS = 1024; //per stream, further arguments are ignored
+    static const int ANIMATION_SETTLE_TIME_MS = 250; //arguments at rest this long are sent again as a reliable keyframe
+    static const float ANIMATION_VALUE_MIN = -1.0f; //arguments are clamped to this range and sent in 16 bits
+    static const float ANIMATION_VALUE_MAX = 1.0f;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace RakNet {
+class BitStream;
+}
+
+namespace Network {
+
+enum AnimationType
+{
+    COCKPIT_ANIMATION = 0,
+    EXTERNAL_ANIMATION,
+    NUM_ANIMATION_TYPES
+};
+
+struct AnimationArgument
+{
+    unsigned short argument = 0;
+    float value = 0.0f;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Sending side of one animation stream (cockpit or external arguments of one seat).
+
+DCS hands over argument values every frame. Each frame is sent as a delta that
+holds only the arguments that differ from the last keyframe. Keyframes hold
+every argument and are sent reliably, deltas are sent unreliable sequenced on
+the same ordering channel. RakNet never delivers a sequenced message ahead of
+an ordered one sent before it on that channel, so a delta always arrives after
+the keyframe it was made against, and a lost delta is simply replaced by the
+next one.
+
+A new keyframe is made when a delta would be half the size of a keyframe,
+when the arguments have come to rest away from the last keyframe (so a lost
+final delta cannot leave a receiver wrong), or on request (a new receiver
+joined).
+
+Frame layout after the message header:
+    keyframe ID     8 bits
+    count           16 bits
+    per argument:
+        argument    1 bit small flag, then 6 bit (delta - 1) or 16 bit ID
+        value       16 bits in [ANIMATION_VALUE_MIN, ANIMATION_VALUE_MAX]
+
+Arguments are sorted by ID, so runs of neighbouring arguments cost 7 bits per ID.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class AnimationSender
+{
+public:
+    /// Constructor
+    AnimationSender();
+
+    ///Merge the latest argument values from DCS. Arguments not listed keep their value.
+    void setArguments(const std::vector<AnimationArgument>& arguments);
+
+    ///Returns true if the latest values differ from what was last sent
+    bool hasChanges() const;
+
+    ///Returns true if the next frame should be a keyframe
+    bool needsKeyframe(RakNet::Time currentTime) const;
+
+    ///Make the next frame a keyframe
+    void requestKeyframe();
+
+    ///Write every argument and make the latest values the new keyframe
+    void writeKeyframe(RakNet::BitStream& bsOut, RakNet::Time currentTime);
+
+    ///Write the arguments that differ from the last keyframe
+    void writeDelta(RakNet::BitStream& bsOut, RakNet::Time currentTime);
+
+    ///Forget everything, the next frame is a keyframe
+    void reset();
+
+    ///Returns the value a receiver decodes for the given argument value
+    static float quantize(float value);
+
+    ///Write a keyframe or delta of arguments sorted by ID
+    static void writeFrame(RakNet::BitStream& bsOut, unsigned char keyframeID, const std::vector<AnimationArgument>& arguments);
+
+private:
+    size_t countChangedArguments() const;
+
+    std::vector<AnimationArgument> current; //sorted by ID
+    std::vector<AnimationArgument> keyframe; //sorted by ID, arguments are never removed so this is a subset of current
+    std::vector<AnimationArgument> frame; //reused between writes
+    unsigned char keyframeID = 0;
+    RakNet::Time lastSendTime = 0;
+    bool keyframeRequested = true;
+    bool changed = false;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Receiving side of one animation stream. Rebuilds the full argument state
+from keyframes and deltas and reports only the arguments whose value changed
+since the last report, so DCS gets nothing for arguments at rest.
+
+Frames are read and applied in two steps so the host can drop arguments the
+sending seat does not own before applying or relaying them.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class AnimationReceiver
+{
+public:
+    ///Read a frame written by AnimationSender::writeFrame(), appending the arguments to the list.
+    ///Returns false if the frame was truncated.
+    static bool readFrame(RakNet::BitStream& bsIn, unsigned char& keyframeID, std::vector<AnimationArgument>& arguments);
+
+    ///Apply a keyframe. changedArguments is filled with the arguments to pass on.
+    void applyKeyframe(unsigned char keyframeID, const std::vector<AnimationArgument>& arguments, std::vector<AnimationArgument>& changedArguments);
+
+    ///Apply a delta. Deltas made against a keyframe we do not have are dropped.
+    void applyDelta(unsigned char keyframeID, const std::vector<AnimationArgument>& arguments, std::vector<AnimationArgument>& changedArguments);
+
+    ///Forget everything, waiting for the next keyframe
+    void reset();
+
+private:
+    void applyFrame(std::vector<AnimationArgument>& changedArguments);
+
+    std::vector<AnimationArgument> keyframe; //sorted by ID
+    std::vector<AnimationArgument> delivered; //sorted by ID, last value passed on for each argument
+    std::vector<AnimationArgument> frame; //reused between reads
+    unsigned char keyframeID = 0;
+    bool hasKeyframe = false;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // ANIMATIONSTREAM_H
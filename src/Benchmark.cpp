@@ -0,0 +1,413 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       Benchmark.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      BenchmarkClient and BenchmarkRunner Classes
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Simulated copilots for the dcs_copilot_benchmark target.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+The clients tick on a deadline like the EFM: the next tick is due one tick time
+after the previous one was due, not after it ran, so a slow tick does not shift
+the ones after it. A tick that starts more than a whole tick late is counted as
+an overrun and the schedule restarts from now.
+
+Only sends inside the measurement window are counted, and their deliveries are
+counted whenever they arrive, including during the drain.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Network.h"
+
+#include "GetTime.h"
+#include "PacketPriority.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+BenchmarkClient::BenchmarkClient(BenchmarkRunner* runner_, int index_, UiChannel* uiChannel, Logger* logger, RakNet::SignaledEvent* packetReadyEvent)
+    : runner(runner_), index(index_), analogSequence(runner_->config.analogAxes, 0)
+{
+    net = new Network(uiChannel);
+    net->setPacketReadyEvent(packetReadyEvent);
+    net->setLogger(logger);
+    //every analog sample carries a sequence number that is counted lost if it does not arrive, so none may be
+    //skipped as close enough to the receivers' extrapolation. config.deadReckoning still decides if it carries a rate.
+    net->setDeadReckoning("off");
+
+    QObject::connect(net, SIGNAL(receivedSeatChange(int)), this, SLOT(handleReceivedSeatChange(int)), Qt::DirectConnection);
+    QObject::connect(net, SIGNAL(receivedNetCommand(unsigned short)),
+                     this, SLOT(handleReceivedNetCommand(unsigned short)), Qt::DirectConnection);
+    QObject::connect(net, SIGNAL(receivedNetCommandValue(unsigned short,float,bool,float)),
+                     this, SLOT(handleReceivedNetCommandValue(unsigned short,float,bool,float)), Qt::DirectConnection);
+    QObject::connect(net, SIGNAL(receivedNetEvent(unsigned char)),
+                     this, SLOT(handleReceivedNetEvent(unsigned char)), Qt::DirectConnection);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+BenchmarkClient::~BenchmarkClient()
+{
+    delete net;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Network* BenchmarkClient::getNetwork()
+{
+    return net;
+}
+
+bool BenchmarkClient::isSeated() const
+{
+    return seated;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchmarkClient::sendTick(uint64_t timeUS, double tickSeconds)
+{
+    const BenchmarkConfig& config = runner->config;
+    unsigned short commandBase = (unsigned short)(index * BENCHMARK_COMMAND_BLOCK);
+
+    //every axis moves every frame, the value carries the sequence number
+    for (unsigned int axis = 0; axis < config.analogAxes; axis++)
+    {
+        unsigned int sequence = analogSequence[axis]++ % BENCHMARK_SEQUENCE_SIZE;
+        float value = -1.0f + (float)sequence * (2.0f / (float)BENCHMARK_SEQUENCE_SIZE);
+
+        runner->recordSend(BENCHMARK_ANALOG, index, axis * BENCHMARK_SEQUENCE_SIZE + sequence, timeUS);
+        net->handleReceivedLocalCommandValue(commandBase + BENCHMARK_DIGITAL_COMMANDS + axis, HIGH_PRIORITY, UNRELIABLE_SEQUENCED, 1,
+                                             FLOAT16, value, config.deadReckoning, 1.0f);
+    }
+
+    digitalBudget += config.digitalPerSecond * tickSeconds;
+    while (digitalBudget >= 1.0)
+    {
+        digitalBudget -= 1.0;
+        unsigned int slot = digitalSequence++ % BENCHMARK_DIGITAL_COMMANDS;
+
+        runner->recordSend(BENCHMARK_DIGITAL, index, slot, timeUS);
+        net->handleReceivedLocalCommand(commandBase + slot, HIGH_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_DEFAULT);
+    }
+
+    unsigned int eventsPerClient = runner->getEventsPerClient();
+    eventBudget += config.eventsPerSecond * tickSeconds;
+    while (eventBudget >= 1.0)
+    {
+        eventBudget -= 1.0;
+        unsigned int slot = eventSequence++ % eventsPerClient;
+
+        runner->recordSend(BENCHMARK_EVENT, index, slot, timeUS);
+        net->handleReceivedLocalEvent((unsigned char)(index * eventsPerClient + slot));
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchmarkClient::handleReceivedSeatChange(int seatNumber)
+{
+    seated = (seatNumber == index + 1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchmarkClient::handleReceivedNetCommand(unsigned short command)
+{
+    int client = command / BENCHMARK_COMMAND_BLOCK;
+    unsigned int slot = command % BENCHMARK_COMMAND_BLOCK;
+
+    if (slot < BENCHMARK_DIGITAL_COMMANDS)
+        runner->recordReceive(BENCHMARK_DIGITAL, client, slot, RakNet::GetTimeUS());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchmarkClient::handleReceivedNetCommandValue(unsigned short command, float value, bool /*deadReckoned*/, float /*valueRate*/)
+{
+    int client = command / BENCHMARK_COMMAND_BLOCK;
+    unsigned int slot = command % BENCHMARK_COMMAND_BLOCK;
+
+    if (slot < BENCHMARK_DIGITAL_COMMANDS)
+        return;
+
+    unsigned int axis = slot - BENCHMARK_DIGITAL_COMMANDS;
+    unsigned int sequence = (unsigned int)std::lround((value + 1.0f) * (float)(BENCHMARK_SEQUENCE_SIZE / 2)) % BENCHMARK_SEQUENCE_SIZE;
+    runner->recordReceive(BENCHMARK_ANALOG, client, axis * BENCHMARK_SEQUENCE_SIZE + sequence, RakNet::GetTimeUS());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchmarkClient::handleReceivedNetEvent(unsigned char eventID)
+{
+    unsigned int eventsPerClient = runner->getEventsPerClient();
+    runner->recordReceive(BENCHMARK_EVENT, eventID / eventsPerClient, eventID % eventsPerClient, RakNet::GetTimeUS());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& config_) : config(config_)
+{
+    config.numClients = std::min(std::max(config.numClients, 2), MAX_CLIENTS);
+    config.tickTimeMS = std::max(config.tickTimeMS, 1);
+    config.analogAxes = std::min(config.analogAxes, BENCHMARK_MAX_ANALOG_AXES);
+
+    sendTimes.resize(config.numClients);
+    for (auto& clientTimes : sendTimes)
+    {
+        clientTimes[BENCHMARK_ANALOG].assign(config.analogAxes * BENCHMARK_SEQUENCE_SIZE, 0);
+        clientTimes[BENCHMARK_DIGITAL].assign(BENCHMARK_DIGITAL_COMMANDS, 0);
+        clientTimes[BENCHMARK_EVENT].assign(getEventsPerClient(), 0);
+    }
+
+    wakeEvent.InitEvent();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+BenchmarkRunner::~BenchmarkRunner()
+{
+    wait();
+    wakeEvent.CloseEvent();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const BenchmarkConfig& BenchmarkRunner::getConfig() const
+{
+    return config;
+}
+
+const BenchmarkResults& BenchmarkRunner::getResults() const
+{
+    return results;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+uint64_t BenchmarkRunner::getProcessCpuTimeUS()
+{
+#if defined(_WIN32)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+        return 0;
+
+    //100 ns units
+    uint64_t kernel = ((uint64_t)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+    uint64_t user = ((uint64_t)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+    return (kernel + user) / 10;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    return (uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000
+            + (uint64_t)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int BenchmarkRunner::getEventsPerClient() const
+{
+    return 256 / (unsigned int)config.numClients;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchmarkRunner::recordSend(BenchmarkTrafficType type, int client, unsigned int slot, uint64_t timeUS)
+{
+    sendTimes[client][type][slot] = timeUS;
+
+    if (phase == PHASE_MEASURING)
+    {
+        results.sent[type]++;
+        results.expected[type] += (uint64_t)(config.numClients - 1);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchmarkRunner::recordReceive(BenchmarkTrafficType type, int client, unsigned int slot, uint64_t timeUS)
+{
+    if (client < 0 || client >= config.numClients || slot >= sendTimes[client][type].size())
+        return;
+
+    uint64_t sendTimeUS = sendTimes[client][type][slot];
+    if (sendTimeUS < measureStartUS || sendTimeUS >= measureEndUS || timeUS < sendTimeUS)
+        return;
+
+    results.latency[type].add(timeUS - sendTimeUS);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchmarkRunner::updateClients()
+{
+    for (BenchmarkClient* client : clients)
+        client->getNetwork()->update();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchmarkRunner::sumHostBytes(uint64_t& bytesIn, uint64_t& bytesOut)
+{
+    //every client is connected to the host only, so their totals mirror the host's
+    bytesIn = 0;
+    bytesOut = 0;
+    for (BenchmarkClient* client : clients)
+    {
+        bytesIn += client->getNetwork()->getBandwidth(ACTUAL_BYTES_SENT);
+        bytesOut += client->getNetwork()->getBandwidth(ACTUAL_BYTES_RECEIVED);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool BenchmarkRunner::connectClients()
+{
+    for (int i = 0; i < config.numClients; i++)
+    {
+        clients.push_back(new BenchmarkClient(this, i, &uiChannel, &logger, &wakeEvent));
+        clients.back()->getNetwork()->connect("127.0.0.1", config.port, "Benchmark" + std::to_string(i + 1));
+    }
+
+    std::vector<bool> seatRequested(config.numClients, false);
+    RakNet::TimeMS deadline = RakNet::GetTimeMS() + BENCHMARK_CONNECT_TIMEOUT_MS;
+
+    while (RakNet::GetTimeMS() < deadline)
+    {
+        updateClients();
+
+        int seatedClients = 0;
+        for (int i = 0; i < config.numClients; i++)
+        {
+            Network* net = clients[i]->getNetwork();
+            if (!seatRequested[i] && net->getNetworkStatus() == IS_CONNECTED)
+            {
+                net->requestSeat(i + 1);
+                seatRequested[i] = true;
+            }
+
+            if (clients[i]->isSeated())
+                seatedClients++;
+        }
+
+        if (seatedClients == config.numClients)
+            return true;
+
+        wakeEvent.WaitOnEvent(config.tickTimeMS);
+    }
+
+    results.error = "Timed out connecting the clients and taking seats";
+    return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchmarkRunner::run()
+{
+    logger.setLevel(LOG_WARNING);
+    logger.start(QThread::LowPriority);
+
+    if (connectClients())
+    {
+        const uint64_t tickUS = (uint64_t)config.tickTimeMS * 1000;
+        const double tickSeconds = (double)config.tickTimeMS / 1000.0;
+
+        uint64_t nowUS = RakNet::GetTimeUS();
+        uint64_t nextTickUS = nowUS;
+        uint64_t warmupEndUS = nowUS + (uint64_t)config.warmupSeconds * 1000000;
+        measureStartUS = warmupEndUS;
+        measureEndUS = measureStartUS + (uint64_t)config.durationSeconds * 1000000;
+        uint64_t drainEndUS = measureEndUS + (uint64_t)BENCHMARK_DRAIN_TIME_MS * 1000;
+
+        uint64_t cpuStartUS = 0;
+        uint64_t hostBytesInStart = 0;
+        uint64_t hostBytesOutStart = 0;
+        phase = PHASE_WARMUP;
+
+        while (nowUS < drainEndUS)
+        {
+            if (phase == PHASE_WARMUP && nowUS >= measureStartUS)
+            {
+                phase = PHASE_MEASURING;
+                cpuStartUS = getProcessCpuTimeUS();
+                sumHostBytes(hostBytesInStart, hostBytesOutStart);
+            }
+            else if (phase == PHASE_MEASURING && nowUS >= measureEndUS)
+            {
+                phase = PHASE_DRAINING;
+                results.cpuTimeUS = getProcessCpuTimeUS() - cpuStartUS;
+
+                uint64_t bytesIn, bytesOut;
+                sumHostBytes(bytesIn, bytesOut);
+                results.hostBytesIn = bytesIn - hostBytesInStart;
+                results.hostBytesOut = bytesOut - hostBytesOutStart;
+            }
+
+            if (nowUS >= nextTickUS)
+            {
+                if (phase != PHASE_DRAINING)
+                {
+                    for (BenchmarkClient* client : clients)
+                        client->sendTick(nowUS, tickSeconds);
+                }
+
+                nextTickUS += tickUS;
+                if (nowUS > nextTickUS)
+                {
+                    if (phase == PHASE_MEASURING)
+                        results.tickOverruns++;
+                    nextTickUS = nowUS + tickUS;
+                }
+            }
+
+            updateClients();
+
+            //sleep until the next tick or until a client has a packet
+            nowUS = RakNet::GetTimeUS();
+            if (nowUS < nextTickUS)
+                wakeEvent.WaitOnEvent((int)((nextTickUS - nowUS + 999) / 1000));
+            nowUS = RakNet::GetTimeUS();
+        }
+
+        results.measuredSeconds = (double)(measureEndUS - measureStartUS) / 1000000.0;
+        results.completed = true;
+    }
+
+    for (BenchmarkClient* client : clients)
+        client->getNetwork()->disconnect();
+    for (BenchmarkClient* client : clients)
+        delete client;
+    clients.clear();
+
+    logger.stop();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
@@ -0,0 +1,237 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       Benchmark.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LatencyHistogram.h"
+#include "Logger.h"
+#include "UiChannel.h"
+
+#include "SignaledEvent.h"
+
+#include <QObject>
+#include <QThread>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const unsigned short BENCHMARK_COMMAND_BLOCK = 1024; //command IDs per simulated client
+    static const unsigned short BENCHMARK_DIGITAL_COMMANDS = 256; //digital IDs cycle through the start of the block
+    static const unsigned int BENCHMARK_MAX_ANALOG_AXES = BENCHMARK_COMMAND_BLOCK - BENCHMARK_DIGITAL_COMMANDS;
+    static const unsigned int BENCHMARK_SEQUENCE_SIZE = 256; //send times kept per command, older ones are overwritten
+    static const int BENCHMARK_CONNECT_TIMEOUT_MS = 20000;
+    static const int BENCHMARK_DRAIN_TIME_MS = 1000; //updates continue this long after the last send
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+class Network;
+class BenchmarkRunner;
+
+enum BenchmarkTrafficType
+{
+    BENCHMARK_ANALOG = 0,
+    BENCHMARK_DIGITAL,
+    BENCHMARK_EVENT,
+    NUM_BENCHMARK_TRAFFIC_TYPES
+};
+
+///Load generated by every simulated client
+struct BenchmarkConfig
+{
+    int numClients = 8;
+    unsigned short port = 39641;
+    int tickTimeMS = 6; //EFM frame time, one analog value per axis per tick
+    int warmupSeconds = 2;
+    int durationSeconds = 10;
+    unsigned int analogAxes = 4; //FLOAT16, unreliable sequenced
+    bool deadReckoning = true; //analog values carry a rate
+    double digitalPerSecond = 10.0; //reliable ordered
+    double eventsPerSecond = 1.0; //reliable ordered, events channel
+    int updateWorkers = 0; //host only, Network::setUpdateWorkers()
+    int busyGuiMS = 0; //the thread standing in for the GUI blocks this long between two UI updates, 0 for an idle GUI
+};
+
+struct BenchmarkResults
+{
+    bool completed = false;
+    std::string error;
+
+    double measuredSeconds = 0.0;
+    std::array<uint64_t, NUM_BENCHMARK_TRAFFIC_TYPES> sent{}; //ingress, in the measurement window
+    std::array<uint64_t, NUM_BENCHMARK_TRAFFIC_TYPES> expected{}; //sent times the other seated clients
+    std::array<LatencyHistogram, NUM_BENCHMARK_TRAFFIC_TYPES> latency; //egress of the commands sent in the window
+
+    uint64_t hostBytesIn = 0; //actual bytes, including RakNet overhead and acks
+    uint64_t hostBytesOut = 0;
+    uint64_t cpuTimeUS = 0; //whole process: host, clients and RakNet threads
+    uint64_t tickOverruns = 0; //ticks started late by more than a tick
+
+    uint64_t hostUpdateAverageUS = 0; //RakNet update cycles on the host over the whole run, filled in by the caller
+    uint64_t hostUpdateMaxUS = 0;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** One simulated copilot: a Network client whose receive signals stand in for
+NetworkLocal, measuring when each command would be handed to DCS.
+
+Latency is measured without adding anything to the protocol. Every client owns
+a block of BENCHMARK_COMMAND_BLOCK command IDs. Digital commands cycle through
+the first BENCHMARK_DIGITAL_COMMANDS IDs of the block, analog axes use the rest
+and carry their sequence number in the value, and events are split between the
+clients in the same way. The receiver maps what it gets back to the send time.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class BenchmarkClient : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void handleReceivedSeatChange(int seatNumber);
+    void handleReceivedNetCommand(unsigned short command);
+    void handleReceivedNetCommandValue(unsigned short command, float value, bool deadReckoned, float valueRate);
+    void handleReceivedNetEvent(unsigned char eventID);
+
+public:
+    /// Constructor
+    BenchmarkClient(BenchmarkRunner* runner_, int index_, UiChannel* uiChannel, Logger* logger, RakNet::SignaledEvent* packetReadyEvent);
+    /// Destructor
+    ~BenchmarkClient();
+
+    Network* getNetwork();
+    bool isSeated() const;
+
+    ///Generate this tick's commands
+    void sendTick(uint64_t timeUS, double tickSeconds);
+
+private:
+    BenchmarkRunner* runner = nullptr;
+    Network* net = nullptr;
+    int index = 0;
+    bool seated = false;
+
+    std::vector<uint32_t> analogSequence;
+    uint32_t digitalSequence = 0;
+    uint32_t eventSequence = 0;
+    double digitalBudget = 0.0;
+    double eventBudget = 0.0;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Runs the simulated clients against a host on loopback, all on this thread:
+connect and take seats, warm up, measure, then let in-flight commands drain.
+
+Commands enter each client through the slots NetworkLocal calls when DCS sends
+them, and leave through the signals NetworkLocal would forward to DCS, so the
+measured path is everything except the loopback hop to DCS itself.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class BenchmarkRunner : public QThread
+{
+    Q_OBJECT
+
+public:
+    /// Constructor
+    BenchmarkRunner(const BenchmarkConfig& config_);
+    /// Destructor
+    ~BenchmarkRunner();
+
+    ///Config after clamping to the supported range
+    const BenchmarkConfig& getConfig() const;
+    const BenchmarkResults& getResults() const;
+
+    ///Returns the process CPU time (user and system) in microseconds
+    static uint64_t getProcessCpuTimeUS();
+
+protected:
+    void run() override;
+
+private:
+    friend class BenchmarkClient;
+
+    enum Phase
+    {
+        PHASE_CONNECTING,
+        PHASE_WARMUP,
+        PHASE_MEASURING,
+        PHASE_DRAINING,
+    };
+
+    //BenchmarkClient side
+    void recordSend(BenchmarkTrafficType type, int client, unsigned int slot, uint64_t timeUS);
+    void recordReceive(BenchmarkTrafficType type, int client, unsigned int slot, uint64_t timeUS);
+    unsigned int getEventsPerClient() const;
+
+    bool connectClients();
+    void updateClients();
+    void sumHostBytes(uint64_t& bytesIn, uint64_t& bytesOut);
+
+    BenchmarkConfig config;
+    BenchmarkResults results;
+    Phase phase = PHASE_CONNECTING;
+
+    uint64_t measureStartUS = 0;
+    uint64_t measureEndUS = 0;
+
+    //send time of every [client][type][slot], slot being a command, axis and sequence, or event
+    std::vector<std::array<std::vector<uint64_t>, NUM_BENCHMARK_TRAFFIC_TYPES> > sendTimes;
+
+    UiChannel uiChannel; //never drained, the log messages the clients raise are dropped
+    Logger logger{&uiChannel};
+    RakNet::SignaledEvent wakeEvent;
+    std::vector<BenchmarkClient*> clients;
+
+    // Make this object be noncopyable because it holds pointers
+    BenchmarkRunner(const BenchmarkRunner&);
+    const BenchmarkRunner &operator =(const BenchmarkRunner &);
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // BENCHMARK_H
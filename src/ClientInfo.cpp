@@ -0,0 +1,220 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       ClientInfo.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      ClientInfoTracker Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Threshold based publishing of client pings to their crew, piggybacked on
+command batches where possible.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "ClientInfo.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "BitStream.h"
+
+#include "ClientTable.h"
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+ClientInfoTracker::ClientInfoTracker(int numSlots)
+    : slotStates(numSlots)
+{
+    for (auto& slot : slotStates)
+        slot.pending.resize(numSlots, false);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ClientInfoTracker::clear()
+{
+    for (size_t slot = 0; slot < slotStates.size(); slot++)
+        removeSlot((int)slot);
+}
+
+void ClientInfoTracker::removeSlot(int slot)
+{
+    if (slot < 0 || slot >= (int)slotStates.size())
+        return;
+
+    Slot& removed = slotStates[slot];
+    removed.joined = false;
+    removed.publishedPing = -1;
+    std::fill(removed.pending.begin(), removed.pending.end(), false);
+    removed.numPending = 0;
+    removed.refreshCursor = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ClientInfoTracker::joinCrew(const ClientTable& clientTable, int slot, RakNet::Time now)
+{
+    if (slot < 0 || slot >= (int)slotStates.size() || !clientTable.isUsed(slot))
+        return;
+
+    //what was queued for the old crew is of no use in the new one
+    removeSlot(slot);
+    Slot& joined = slotStates[slot];
+    joined.joined = true;
+    joined.publishedPing = clientTable.get(slot).ping;
+    joined.refreshTime = now;
+
+    int crew = clientTable.get(slot).crew;
+    for (int other = 0; other < (int)slotStates.size(); other++)
+    {
+        if (!slotStates[other].joined || !clientTable.isUsed(other) || clientTable.get(other).crew != crew)
+            continue;
+
+        queue(slot, other, now);
+        queue(other, slot, now);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ClientInfoTracker::updatePing(const ClientTable& clientTable, int slot, int ping, RakNet::Time now)
+{
+    if (slot < 0 || slot >= (int)slotStates.size() || !slotStates[slot].joined)
+        return;
+
+    //jitter of a few percent is not worth telling anyone about
+    Slot& measured = slotStates[slot];
+    int threshold = std::max(CLIENT_INFO_PING_THRESHOLD_MS, measured.publishedPing * CLIENT_INFO_PING_THRESHOLD_PERCENT / 100);
+    if (measured.publishedPing >= 0 && ping >= 0 && std::abs(ping - measured.publishedPing) <= threshold)
+        return;
+    if (ping == measured.publishedPing)
+        return;
+
+    measured.publishedPing = ping;
+
+    int crew = clientTable.get(slot).crew;
+    for (int recipient = 0; recipient < (int)slotStates.size(); recipient++)
+    {
+        if (slotStates[recipient].joined && clientTable.isUsed(recipient) && clientTable.get(recipient).crew == crew)
+            queue(recipient, slot, now);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ClientInfoTracker::refresh(const ClientTable& clientTable, RakNet::Time now)
+{
+    int numSlots = (int)slotStates.size();
+    for (int recipient = 0; recipient < numSlots; recipient++)
+    {
+        Slot& refreshed = slotStates[recipient];
+        if (!refreshed.joined || now - refreshed.refreshTime < CLIENT_INFO_REFRESH_INTERVAL_MS)
+            continue;
+
+        refreshed.refreshTime = now;
+
+        //carry on where the last refresh stopped, so a large crew is covered over several intervals
+        int crew = clientTable.get(recipient).crew;
+        int queued = 0;
+        int subject = refreshed.refreshCursor;
+        for (int step = 0; step < numSlots && queued < CLIENT_INFO_REFRESH_ENTRIES; step++, subject = (subject + 1) % numSlots)
+        {
+            if (slotStates[subject].joined && clientTable.isUsed(subject) && clientTable.get(subject).crew == crew)
+            {
+                queue(recipient, subject, now);
+                queued++;
+            }
+        }
+        refreshed.refreshCursor = subject;
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool ClientInfoTracker::hasPending(int slot) const
+{
+    return slot >= 0 && slot < (int)slotStates.size() && slotStates[slot].numPending > 0;
+}
+
+bool ClientInfoTracker::isOverdue(int slot, RakNet::Time now) const
+{
+    return hasPending(slot) && now - slotStates[slot].pendingSince >= CLIENT_INFO_PIGGYBACK_WAIT_MS;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ClientInfoTracker::writePending(const ClientTable& clientTable, int slot, RakNet::BitStream& bsOut)
+{
+    Slot& recipient = slotStates[slot];
+    int crew = clientTable.get(slot).crew;
+
+    //a subject may have left or changed crew since it was queued
+    unsigned short numberOfClients = 0;
+    for (size_t subject = 0; subject < slotStates.size(); subject++)
+    {
+        if (recipient.pending[subject] && slotStates[subject].joined && clientTable.get((int)subject).crew == crew)
+            numberOfClients++;
+    }
+
+    bsOut.Write(numberOfClients);
+    for (size_t subject = 0; subject < slotStates.size(); subject++)
+    {
+        if (!recipient.pending[subject])
+            continue;
+
+        recipient.pending[subject] = false;
+        if (!slotStates[subject].joined || clientTable.get((int)subject).crew != crew)
+            continue;
+
+        int ping = std::min(std::max(slotStates[subject].publishedPing, -1), CLIENT_INFO_MAX_PING);
+        bsOut.Write(clientTable.get((int)subject).ID);
+        bsOut.WriteBitsFromIntegerRange(ping, -1, CLIENT_INFO_MAX_PING);
+    }
+    recipient.numPending = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool ClientInfoTracker::readEntries(RakNet::BitStream& bsIn, std::vector<ClientInfoEntry>& entries)
+{
+    unsigned short numberOfClients = 0;
+    if (!bsIn.Read(numberOfClients))
+        return false;
+
+    for (unsigned short us = 0; us < numberOfClients; us++)
+    {
+        ClientInfoEntry entry;
+        if (!bsIn.Read(entry.guid) || !bsIn.ReadBitsFromIntegerRange(entry.ping, -1, CLIENT_INFO_MAX_PING))
+            return false;
+        if (entry.ping >= CLIENT_INFO_MAX_PING)
+            entry.ping = 9999;
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ClientInfoTracker::queue(int recipient, int subject, RakNet::Time now)
+{
+    Slot& queuedFor = slotStates[recipient];
+    if (queuedFor.pending[subject])
+        return;
+
+    queuedFor.pending[subject] = true;
+    if (queuedFor.numPending++ == 0)
+        queuedFor.pendingSince = now;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
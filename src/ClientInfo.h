@@ -0,0 +1,136 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       ClientInfo.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef CLIENTINFO_H
+#define CLIENTINFO_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstddef>
+#include <vector>
+
+#include "RakNetTime.h"
+#include "RakNetTypes.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const int CLIENT_INFO_PING_THRESHOLD_MS = 5; //a ping is only republished once it moved by more than this
+    static const int CLIENT_INFO_PING_THRESHOLD_PERCENT = 10; //or by this share of the published one, if that is more
+    static const RakNet::Time CLIENT_INFO_PIGGYBACK_WAIT_MS = 1000; //longest entries wait for a command batch before going out on their own
+    static const RakNet::Time CLIENT_INFO_REFRESH_INTERVAL_MS = 10000;
+    static const int CLIENT_INFO_REFRESH_ENTRIES = 4; //crew members resent to each client per refresh interval
+    static const int CLIENT_INFO_MAX_PING = 2046; //higher pings are shown as 9999
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace RakNet {
+class BitStream;
+}
+
+namespace Network {
+
+class ClientTable;
+
+struct ClientInfoEntry
+{
+    RakNet::RakNetGUID guid = RakNet::UNASSIGNED_RAKNET_GUID;
+    int ping = -1;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Host side bookkeeping of which pings each client still has to be told.
+
+A client's measured ping is only published when it moved past the threshold,
+and is then queued for every client of its crew. Queued entries ride along on
+the next reliable command batch sent to a client (an unreliable or sequenced
+one may never arrive, taking the entries with it), and go out in their own
+ID_NET_CLIENT_INFO, sent reliably, once they waited CLIENT_INFO_PIGGYBACK_WAIT_MS
+without one.
+
+Every CLIENT_INFO_REFRESH_INTERVAL_MS each client is also queued the next
+CLIENT_INFO_REFRESH_ENTRIES of its crew, so a lost entry is repaired within
+one pass over the crew while a client's idle traffic stays the same however
+large its crew gets.
+
+Entries, in ID_NET_CLIENT_INFO and after the entries of a batch:
+    count           16 bits
+    per entry:
+        GUID        64 bits
+        ping        11 bits, -1 to CLIENT_INFO_MAX_PING
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class ClientInfoTracker
+{
+public:
+    /// Constructor, for the remote slots 0..numSlots-1 of the client table
+    explicit ClientInfoTracker(int numSlots);
+
+    void clear();
+
+    ///Forget a slot's published ping and queue, for a client that left
+    void removeSlot(int slot);
+
+    ///Queue the slot's crew for it and it for its crew, after it said which crew it flies with
+    void joinCrew(const ClientTable& clientTable, int slot, RakNet::Time now);
+
+    ///Take a measured ping, publishing it to the slot's crew if it moved past the threshold
+    void updatePing(const ClientTable& clientTable, int slot, int ping, RakNet::Time now);
+
+    ///Queue the next crew members for every client whose refresh is due
+    void refresh(const ClientTable& clientTable, RakNet::Time now);
+
+    bool hasPending(int slot) const;
+    ///Returns true if the slot's queue waited long enough to be sent on its own
+    bool isOverdue(int slot, RakNet::Time now) const;
+
+    ///Write the slot's queued entries and empty the queue
+    void writePending(const ClientTable& clientTable, int slot, RakNet::BitStream& bsOut);
+
+    ///Read entries written by writePending(), appending them to the list. Returns false if they were truncated.
+    static bool readEntries(RakNet::BitStream& bsIn, std::vector<ClientInfoEntry>& entries);
+
+private:
+    void queue(int recipient, int subject, RakNet::Time now);
+
+    struct Slot
+    {
+        bool joined = false;
+        int publishedPing = -1;
+        std::vector<bool> pending; //by subject slot
+        size_t numPending = 0;
+        RakNet::Time pendingSince = 0;
+        RakNet::Time refreshTime = 0;
+        int refreshCursor = 0;
+    };
+    std::vector<Slot> slotStates;
+};
+
+} // namespace Network
+
+#endif // CLIENTINFO_H
@@ -0,0 +1,183 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       ClientTable.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      ClientTable Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Slot indexed table of the clients in a session and the seats they occupy.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "ClientTable.h"
+
+#include <algorithm>
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+ClientTable::ClientTable(int numSlots, int numSeats_, int numCrews_)
+    : clients(numSlots), used(numSlots, false), seatSlots(numSeats_ * numCrews_, -1), numSeats(numSeats_), numCrews(numCrews_),
+      slotGUIDs(numSlots, RakNet::UNASSIGNED_RAKNET_GUID.g)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Client& ClientTable::add(int slot, const RakNet::RakNetGUID& guid)
+{
+    remove(slot);
+
+    //a GUID lives in one slot only
+    int oldSlot = findSlot(guid);
+    if (oldSlot >= 0)
+        remove(oldSlot);
+
+    clients[slot] = Client();
+    clients[slot].ID = guid;
+    used[slot] = true;
+    slotGUIDs[slot] = guid.g;
+    numClients++;
+    return clients[slot];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool ClientTable::remove(int slot)
+{
+    if (!isUsed(slot))
+        return false;
+
+    setSeat(slot, 0);
+    slotGUIDs[slot] = RakNet::UNASSIGNED_RAKNET_GUID.g;
+    used[slot] = false;
+    numClients--;
+    return true;
+}
+
+void ClientTable::clear()
+{
+    for (size_t slot = 0; slot < used.size(); slot++)
+        used[slot] = false;
+    for (size_t seat = 0; seat < seatSlots.size(); seat++)
+        seatSlots[seat] = -1;
+    std::fill(slotGUIDs.begin(), slotGUIDs.end(), RakNet::UNASSIGNED_RAKNET_GUID.g);
+    numClients = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int ClientTable::getFreeSlot() const
+{
+    for (int slot = 0; slot + 1 < getNumSlots(); slot++)
+    {
+        if (!used[slot])
+            return slot;
+    }
+    return -1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool ClientTable::isUsed(int slot) const
+{
+    return slot >= 0 && slot < getNumSlots() && used[slot];
+}
+
+Client& ClientTable::get(int slot)
+{
+    return clients[slot];
+}
+
+const Client& ClientTable::get(int slot) const
+{
+    return clients[slot];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int ClientTable::findSlot(const RakNet::RakNetGUID& guid) const
+{
+    if (guid == RakNet::UNASSIGNED_RAKNET_GUID)
+        return -1;
+
+    auto it = std::find(slotGUIDs.begin(), slotGUIDs.end(), guid.g);
+    return (it != slotGUIDs.end()) ? (int)(it - slotGUIDs.begin()) : -1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int ClientTable::getSeatSlot(int crew, int seatNumber) const
+{
+    int index = getSeatIndex(crew, seatNumber);
+    return (index >= 0) ? seatSlots[index] : -1;
+}
+
+void ClientTable::setSeat(int slot, int seatNumber)
+{
+    if (!isUsed(slot))
+        return;
+
+    Client& client = clients[slot];
+    int oldIndex = getSeatIndex(client.crew, client.seatNumber);
+    if (oldIndex >= 0 && seatSlots[oldIndex] == slot)
+        seatSlots[oldIndex] = -1;
+
+    int index = getSeatIndex(client.crew, seatNumber);
+    if (index < 0)
+    {
+        client.seatNumber = 0;
+        return;
+    }
+
+    //the host has the final word, so a stale occupant loses the seat
+    int occupant = seatSlots[index];
+    if (occupant >= 0 && occupant != slot)
+        clients[occupant].seatNumber = 0;
+
+    seatSlots[index] = slot;
+    client.seatNumber = seatNumber;
+}
+
+void ClientTable::setCrew(int slot, int crew)
+{
+    if (!isUsed(slot))
+        return;
+
+    setSeat(slot, 0);
+    clients[slot].crew = crew;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int ClientTable::getSeatIndex(int crew, int seatNumber) const
+{
+    if (crew < 0 || crew >= numCrews || seatNumber <= 0 || seatNumber >= numSeats)
+        return -1;
+    return crew * numSeats + seatNumber;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+size_t ClientTable::size() const
+{
+    return numClients;
+}
+
+int ClientTable::getNumSlots() const
+{
+    return (int)clients.size();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
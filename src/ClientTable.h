@@ -0,0 +1,120 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       ClientTable.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef CLIENTTABLE_H
+#define CLIENTTABLE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "RakNetTypes.h"
+#include "RakString.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+struct Client
+{
+    RakNet::RakNetGUID ID = RakNet::UNASSIGNED_RAKNET_GUID;
+    RakNet::RakString name = "Unknown Client";
+    int seatNumber = 0;
+    int ping = -1;
+    uint32_t codecProfile = 0; //fingerprint of the client's CommandCodecProfile, host only
+    RakNet::SystemAddress address = RakNet::UNASSIGNED_SYSTEM_ADDRESS; //host only
+    int crew = 0; //host only, negative until the client says which crew it flies with
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Every client in the session in one flat array of slots, with the seats
+pointing back into it.
+
+The last slot is the local peer. On the host a remote client's slot is its
+RakNet system index, so a received packet finds its sender without a lookup. A
+client does not know the host's system indices and puts everyone else in the
+first free slot. A seat's occupant is found in constant time, and a slot by
+GUID by scanning a flat array of the slots' GUIDs, which for a session's few
+slots beats hashing. Storage is allocated once by the constructor.
+
+Seats belong to a crew, so each crew has its own seat 1 and so on. A client
+outside every crew cannot be seated.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class ClientTable
+{
+public:
+    /// Constructor. Seats are numbered 1..numSeats-1 in each of the crews 0..numCrews-1, seat 0 being no seat.
+    ClientTable(int numSlots, int numSeats, int numCrews = 1);
+
+    ///Put a client in a slot, replacing whoever was in it
+    Client& add(int slot, const RakNet::RakNetGUID& guid);
+    ///Empty a slot and its seat. Returns false if the slot was not in use.
+    bool remove(int slot);
+    void clear();
+
+    ///First unused slot below the last one, -1 if there is none
+    int getFreeSlot() const;
+
+    bool isUsed(int slot) const;
+    Client& get(int slot);
+    const Client& get(int slot) const;
+
+    ///Slot of the client with the given GUID, -1 if none
+    int findSlot(const RakNet::RakNetGUID& guid) const;
+
+    ///Slot of the occupant of a crew's seat, -1 if the seat is empty or out of range
+    int getSeatSlot(int crew, int seatNumber) const;
+    ///Move a client to a seat of its crew, emptying its old one. Whoever was recorded in the seat is left without one.
+    void setSeat(int slot, int seatNumber);
+    ///Move a client to another crew, leaving its seat
+    void setCrew(int slot, int crew);
+
+    ///Number of slots in use
+    size_t size() const;
+    ///Number of slots, used or not
+    int getNumSlots() const;
+
+private:
+    ///Index of a crew's seat in seatSlots, -1 if out of range
+    int getSeatIndex(int crew, int seatNumber) const;
+
+    std::vector<Client> clients;
+    std::vector<bool> used;
+    std::vector<int> seatSlots; //numSeats per crew
+    int numSeats;
+    int numCrews;
+    std::vector<uint64_t> slotGUIDs; //UNASSIGNED_RAKNET_GUID for unused slots
+    size_t numClients = 0;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // CLIENTTABLE_H
@@ -0,0 +1,298 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       CommandBatch.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      CommandBatch Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+CommandBatch packs the commands of one network loop into a single frame, and
+unpacks them again on receive.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+The host relays frames without decoding them, so the layout here must only ever
+change together with the message ID.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "CommandBatch.h"
+#include "CommandCodec.h"
+#include "CommandCodecProfile.h"
+
+#include "BitStream.h"
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+CommandBatch::CommandBatch(unsigned char priority_, unsigned char reliability_, char orderingChannel_)
+    : priority(priority_), reliability(reliability_), orderingChannel(orderingChannel_)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandBatch::addCommand(unsigned short command)
+{
+    CommandBatchEntry entry;
+    entry.type = BATCH_COMMAND;
+    entry.command = command;
+    entries.push_back(entry);
+}
+
+void CommandBatch::addCommandValue(unsigned short command, unsigned char compressionType, float value, bool deadReckoned, float valueRate)
+{
+    CommandBatchEntry entry;
+    entry.type = BATCH_COMMAND_VALUE;
+    entry.command = command;
+    entry.compressionType = compressionType;
+    entry.value = value;
+    entry.deadReckoned = deadReckoned;
+    entry.valueRate = valueRate;
+    entries.push_back(entry);
+}
+
+void CommandBatch::addCorrection(unsigned short command, float value)
+{
+    CommandBatchEntry entry;
+    entry.type = BATCH_COMMAND_VALUE_CORRECTION;
+    entry.command = command;
+    entry.value = value;
+    entries.push_back(entry);
+}
+
+void CommandBatch::addEvent(unsigned char eventID)
+{
+    CommandBatchEntry entry;
+    entry.type = BATCH_EVENT;
+    entry.eventID = eventID;
+    entries.push_back(entry);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandBatch::clear()
+{
+    entries.clear();
+}
+
+void CommandBatch::setIngressTime(RakNet::Time time)
+{
+    ingressTime = time;
+}
+
+RakNet::Time CommandBatch::getIngressTime() const
+{
+    return ingressTime;
+}
+
+bool CommandBatch::empty() const
+{
+    return entries.empty();
+}
+
+bool CommandBatch::full() const
+{
+    return entries.size() >= MAX_BATCH_ENTRIES;
+}
+
+size_t CommandBatch::size() const
+{
+    return entries.size();
+}
+
+const std::vector<CommandBatchEntry>& CommandBatch::getEntries() const
+{
+    return entries;
+}
+
+unsigned char CommandBatch::getPriority() const
+{
+    return priority;
+}
+
+unsigned char CommandBatch::getReliability() const
+{
+    return reliability;
+}
+
+char CommandBatch::getOrderingChannel() const
+{
+    return orderingChannel;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandBatch::writeEntries(RakNet::BitStream& bsOut, const CommandCodecProfile* profile) const
+{
+    writeEntries(bsOut, entries.data(), entries.size(), profile);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandBatch::writeEntries(RakNet::BitStream& bsOut, const CommandBatchEntry* entries, size_t numEntries, const CommandCodecProfile* profile)
+{
+    unsigned char count = (unsigned char)numEntries;
+    bsOut.Write(count);
+
+    unsigned short lastCommand = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const CommandBatchEntry& entry = entries[i];
+        unsigned char type = (unsigned char)entry.type;
+        bsOut.WriteBits(&type, 2);
+
+        if (entry.type != BATCH_EVENT)
+        {
+            int delta = (int)entry.command - (int)lastCommand;
+            if (delta >= BATCH_SMALL_DELTA_MIN && delta <= BATCH_SMALL_DELTA_MAX)
+            {
+                bsOut.Write1();
+                bsOut.WriteBitsFromIntegerRange(delta, BATCH_SMALL_DELTA_MIN, BATCH_SMALL_DELTA_MAX);
+            }
+            else
+            {
+                bsOut.Write0();
+                bsOut.Write(entry.command);
+            }
+            lastCommand = entry.command;
+        }
+
+        switch (entry.type)
+        {
+        case BATCH_COMMAND:
+            break;
+        case BATCH_COMMAND_VALUE:
+        {
+            const CommandCodecSpec* spec = profile ? profile->find(entry.command) : nullptr;
+            if (spec)
+            {
+                spec->write(bsOut, *spec, entry.value);
+                if (spec->hasValueRate)
+                {
+                    bsOut.Write(entry.deadReckoned);
+                    if (entry.deadReckoned) {
+                        writeCompressedValueRate(bsOut, FLOAT16, entry.valueRate);
+                    }
+                }
+                break;
+            }
+
+            bsOut.WriteBits(&entry.compressionType, 3);
+            writeCompressedValue(bsOut, entry.compressionType, entry.value);
+            if (hasValueRate(entry.compressionType))
+            {
+                bsOut.Write(entry.deadReckoned);
+                if (entry.deadReckoned) {
+                    writeCompressedValueRate(bsOut, entry.compressionType, entry.valueRate);
+                }
+            }
+            break;
+        }
+        case BATCH_COMMAND_VALUE_CORRECTION:
+            bsOut.Write(entry.value);
+            break;
+        case BATCH_EVENT:
+            bsOut.Write(entry.eventID);
+            break;
+        }
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CommandBatch::readEntries(RakNet::BitStream& bsIn, std::vector<CommandBatchEntry>& entries, const CommandCodecProfile* profile)
+{
+    unsigned char count = 0;
+    if (!bsIn.Read(count))
+        return false;
+
+    unsigned short lastCommand = 0;
+    for (unsigned char i = 0; i < count; i++)
+    {
+        CommandBatchEntry entry;
+        unsigned char type = 0;
+        if (!bsIn.ReadBits(&type, 2))
+            return false;
+        entry.type = static_cast<CommandBatchEntryType>(type);
+
+        if (entry.type != BATCH_EVENT)
+        {
+            bool smallDelta = false;
+            if (!bsIn.Read(smallDelta))
+                return false;
+
+            if (smallDelta)
+            {
+                int delta = 0;
+                if (!bsIn.ReadBitsFromIntegerRange(delta, BATCH_SMALL_DELTA_MIN, BATCH_SMALL_DELTA_MAX))
+                    return false;
+                entry.command = (unsigned short)(lastCommand + delta);
+            }
+            else if (!bsIn.Read(entry.command))
+                return false;
+
+            lastCommand = entry.command;
+        }
+
+        bool success = true;
+        switch (entry.type)
+        {
+        case BATCH_COMMAND:
+            break;
+        case BATCH_COMMAND_VALUE:
+        {
+            const CommandCodecSpec* spec = profile ? profile->find(entry.command) : nullptr;
+            if (spec)
+            {
+                success = spec->read(bsIn, *spec, entry.value);
+                entry.compressionType = FLOAT32;
+                if (success && spec->hasValueRate)
+                {
+                    success = bsIn.Read(entry.deadReckoned);
+                    if (success && entry.deadReckoned) {
+                        success = readCompressedValueRate(bsIn, FLOAT16, entry.valueRate);
+                    }
+                }
+                break;
+            }
+
+            success = bsIn.ReadBits(&entry.compressionType, 3) && readCompressedValue(bsIn, entry.compressionType, entry.value);
+            if (success && hasValueRate(entry.compressionType))
+            {
+                success = bsIn.Read(entry.deadReckoned);
+                if (success && entry.deadReckoned) {
+                    success = readCompressedValueRate(bsIn, entry.compressionType, entry.valueRate);
+                }
+            }
+            break;
+        }
+        case BATCH_COMMAND_VALUE_CORRECTION:
+            success = bsIn.Read(entry.value);
+            break;
+        case BATCH_EVENT:
+            success = bsIn.Read(entry.eventID);
+            break;
+        }
+
+        if (!success)
+            return false;
+
+        entries.push_back(entry);
+    }
+
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
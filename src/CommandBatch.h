@@ -0,0 +1,169 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       CommandBatch.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef COMMANDBATCH_H
+#define COMMANDBATCH_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstddef>
+#include <vector>
+
+#include "NetworkTypes.h"
+
+#include "RakNetTime.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const unsigned int MAX_BATCH_ENTRIES = 255; //a full batch is sent right away
+    static const int BATCH_SMALL_DELTA_MIN = -64; //command ID deltas in this range take 7 bits instead of 16
+    static const int BATCH_SMALL_DELTA_MAX = 63;
+    static const unsigned char BATCH_CODEC_PROFILE = 1 << 5; //packetInfo flag, values of commands in the session's CommandCodecProfile use it
+    static const unsigned char BATCH_CLIENT_INFO = 1 << 6; //packetInfo flag, the host appended client info after the entries
+    static const unsigned int BATCH_FINGERPRINT_SIZE = 4; //bytes of the codec profile fingerprint after the header of a BATCH_CODEC_PROFILE batch
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace RakNet {
+class BitStream;
+}
+
+namespace Network {
+
+class CommandCodecProfile;
+
+enum CommandBatchEntryType
+{
+    BATCH_COMMAND = 0,
+    BATCH_COMMAND_VALUE,
+    BATCH_COMMAND_VALUE_CORRECTION,
+    BATCH_EVENT,
+};
+
+struct CommandBatchEntry
+{
+    CommandBatchEntryType type = BATCH_COMMAND;
+    unsigned short command = 0;
+    unsigned char eventID = 0;
+    unsigned char compressionType = BINARY;
+    float value = 0.0f;
+    bool deadReckoned = false;
+    float valueRate = 0.0f;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Commands, command values, corrections and events from one network loop that
+share a priority, reliability and ordering channel. They are sent as a single
+ID_NET_COMMAND_BATCH message instead of one message each.
+
+Entries keep the order they were added in, which is the order DCS sent them.
+Each command ID is written as the difference from the previous one, so runs of
+related switches cost 8 bits per ID instead of 16.
+
+With BATCH_CODEC_PROFILE set in the header's packetInfo, values of the
+commands the session's CommandCodecProfile lists skip the compression type and
+are encoded by the profile, whose fingerprint follows the header. Receivers
+with another profile drop the batch, and the host relays it to them with the
+entries written again without the profile, or not at all if it could not read
+them either. Priority and reliability stay in packetInfo, the host relays by
+them.
+
+With BATCH_CLIENT_INFO set, the host appended the pings its recipient was still
+owed (see ClientInfoTracker) from the byte after the last entry. Clients that
+do not know the flag stop reading after the entries.
+
+Frame layout after the message header:
+    fingerprint     32 bits, the CommandCodecProfile's      (BATCH_CODEC_PROFILE only)
+    count           8 bits
+    per entry:
+        type        2 bits (CommandBatchEntryType)
+        command     1 bit small flag, then 7 bit delta or 16 bit ID   (not for events)
+        value       3 bit compression type, value, then for FLOAT16/FLOAT32
+                    a dead reckoning flag and optional rate          (values only)
+                    or, for commands in the codec profile, the profile
+                    codec's value, then for linear codecs a dead
+                    reckoning flag and optional FLOAT16 rate
+        value       32 bit float                                     (corrections only)
+        eventID     8 bits                                           (events only)
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class CommandBatch
+{
+public:
+    /// Constructor
+    CommandBatch(unsigned char priority_, unsigned char reliability_, char orderingChannel_);
+
+    void addCommand(unsigned short command);
+    void addCommandValue(unsigned short command, unsigned char compressionType, float value, bool deadReckoned, float valueRate);
+    void addCorrection(unsigned short command, float value);
+    void addEvent(unsigned char eventID);
+
+    ///Drops all entries, keeping the send class
+    void clear();
+
+    ///Time the first entry was added, sent in the command stamp. Set by the caller when the batch is empty.
+    void setIngressTime(RakNet::Time time);
+    RakNet::Time getIngressTime() const;
+
+    bool empty() const;
+    bool full() const;
+    size_t size() const;
+
+    const std::vector<CommandBatchEntry>& getEntries() const;
+
+    unsigned char getPriority() const;
+    unsigned char getReliability() const;
+    char getOrderingChannel() const;
+
+    ///Write the entry count and all entries (not the message header). With a profile, the header must have BATCH_CODEC_PROFILE set.
+    void writeEntries(RakNet::BitStream& bsOut, const CommandCodecProfile* profile = nullptr) const;
+
+    ///Write the entry count and the given entries, such as ones readEntries() returned, the same way.
+    static void writeEntries(RakNet::BitStream& bsOut, const CommandBatchEntry* entries, size_t numEntries, const CommandCodecProfile* profile = nullptr);
+
+    ///Read entries written by writeEntries(), appending them to the list. profile must be the writer's if the header has BATCH_CODEC_PROFILE set.
+    ///Values the profile decoded get FLOAT32 as their compression type, so writing them again without it keeps them whole.
+    ///Returns false if the frame was truncated.
+    static bool readEntries(RakNet::BitStream& bsIn, std::vector<CommandBatchEntry>& entries, const CommandCodecProfile* profile = nullptr);
+
+private:
+    unsigned char priority;
+    unsigned char reliability;
+    char orderingChannel;
+    RakNet::Time ingressTime = 0;
+
+    std::vector<CommandBatchEntry> entries;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // COMMANDBATCH_H
@@ -0,0 +1,288 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       CommandCodec.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      Command value compression
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Reads and writes command values in the NetCompressionTypes formats used on the
+copilot network.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FLOAT64 is not sent yet, so like any unknown type it falls back to a full float.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "CommandCodec.h"
+
+#include <cmath>
+
+#include "BitStream.h"
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FUNCTION IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+bool hasValueRate(unsigned char compressionType)
+{
+    return compressionType == FLOAT16 || compressionType == FLOAT32;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void writeCompressedValue(RakNet::BitStream& bsOut, unsigned char compressionType, float value)
+{
+    switch (compressionType)
+    {
+        case BINARY:
+            value > 0.0f ? bsOut.Write1() : bsOut.Write0();
+            break;
+        case FLOAT16:
+            bsOut.WriteFloat16(value, -1.0f, 1.0f);
+            break;
+        case FLOAT32:
+            bsOut.Write(value);
+            break;
+        //case FLOAT64:
+        //	bsOut.Write(dValue);
+        //	break;
+        case NEG_ONE_ZERO_ONE:
+        {
+            unsigned char bitValue = 0;
+            if (value < 0.0f) {
+                bitValue = 0;
+            }
+            else if (value == 0.0f) {
+                bitValue = 1;
+            }
+            else {
+                bitValue = 2;
+            }
+            bsOut.WriteBits((const unsigned char *)&bitValue, 2);
+            break;
+        }
+        case ZERO_HALF_ONE:
+        {
+            unsigned char bitValue = 0;
+            if (value == 0.0f) {
+                bitValue = 0;
+            }
+            else if (value > 0.99999f) {
+                bitValue = 2;
+            }
+            else {
+                bitValue = 1;
+            }
+            bsOut.WriteBits((const unsigned char *)&bitValue, 2);
+            break;
+        }
+        case NEG_ONE_ZERO_HALF_ONE:
+        {
+            unsigned char bitValue = 0;
+            if (value < -0.99999f) {
+                bitValue = 0;
+            }
+            else if (value == 0.0f) {
+                bitValue = 1;
+            }
+            else if (value > 0.99999f) {
+                bitValue = 3;
+            }
+            else {
+                bitValue = 2;
+            }
+            bsOut.WriteBits((const unsigned char *)&bitValue, 3);
+            break;
+        }
+        case NEG_TWO_NEG_ONE_ZERO_ONE:
+        {
+            unsigned char bitValue = 0;
+            if (value < -1.99999f) {
+                bitValue = 0;
+            }
+            else if (value < -0.99999f) {
+                bitValue = 1;
+            }
+            else if (value == 0.0f) {
+                bitValue = 2;
+            }
+            else if (value > 0.99999f) {
+                bitValue = 3;
+            }
+            bsOut.WriteBits((const unsigned char *)&bitValue, 3);
+            break;
+        }
+        default:
+            bsOut.Write(value);
+            break;
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool readCompressedValue(RakNet::BitStream& bsIn, unsigned char compressionType, float& value)
+{
+    unsigned char bitValue = 0;
+    bool success = true;
+
+    switch (compressionType)
+    {
+        case BINARY:
+            bitValue = bsIn.ReadBit();
+            value = (bitValue > 0) ? 1.0f : 0.0f;
+            break;
+        case FLOAT16:
+            success = bsIn.ReadFloat16(value, -1.0f, 1.0f);
+            break;
+        case FLOAT32:
+            success = bsIn.Read(value);
+            break;
+        //case FLOAT64:
+        //	bsIn.Read(dValue);
+        //	break;
+        case NEG_ONE_ZERO_ONE:
+        {
+            success = bsIn.ReadBits((unsigned char *)(&(bitValue)), 2);
+            if (bitValue == 0) {
+                value = -1.0f;
+            }
+            else if (bitValue == 1) {
+                value = 0.0f;
+            }
+            else {
+                value = 1.0f;
+            }
+            break;
+        }
+        case ZERO_HALF_ONE:
+        {
+            success = bsIn.ReadBits((unsigned char *)(&(bitValue)), 2);
+            if (bitValue == 0) {
+                value = 0.0f;
+            }
+            else if (bitValue == 1) {
+                value = 0.5f;
+            }
+            else {
+                value = 1.0f;
+            }
+            break;
+        }
+        case NEG_ONE_ZERO_HALF_ONE:
+        {
+            success = bsIn.ReadBits((unsigned char *)(&(bitValue)), 3);
+            if (bitValue == 0) {
+                value = -1.0f;
+            }
+            else if (bitValue == 1) {
+                value = 0.0f;
+            }
+            else if (bitValue == 2) {
+                value = 0.5f;
+            }
+            else {
+                value = 1.0f;
+            }
+            break;
+        }
+        case NEG_TWO_NEG_ONE_ZERO_ONE:
+        {
+            success = bsIn.ReadBits((unsigned char *)(&(bitValue)), 3);
+            if (bitValue == 0) {
+                value = -2.0f;
+            }
+            else if (bitValue == 1) {
+                value = -1.0f;
+            }
+            else if (bitValue == 2) {
+                value = 0.0f;
+            }
+            else {
+                value = 1.0f;
+            }
+            break;
+        }
+        default:
+            success = bsIn.Read(value);
+            break;
+    }
+
+    return success;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+float quantizeCompressedValue(unsigned char compressionType, float value)
+{
+    if (compressionType == FLOAT32)
+        return value;
+
+    //BitStream starts on its internal stack buffer, so this does not allocate
+    RakNet::BitStream bs;
+    writeCompressedValue(bs, compressionType, value);
+    readCompressedValue(bs, compressionType, value);
+    return value;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void writeCompressedValueRate(RakNet::BitStream& bsOut, unsigned char compressionType, float valueRate)
+{
+    if (compressionType == FLOAT16) {
+        bsOut.WriteFloat16(valueRate, -MAX_VALUE_RATE, MAX_VALUE_RATE);
+    }
+    else if (compressionType == FLOAT32) {
+        bsOut.Write(valueRate);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool readCompressedValueRate(RakNet::BitStream& bsIn, unsigned char compressionType, float& valueRate)
+{
+    if (compressionType == FLOAT16)
+    {
+        if (!bsIn.ReadFloat16(valueRate, -MAX_VALUE_RATE, MAX_VALUE_RATE))
+            return false;
+
+        //a zero rate does not survive the 16 bit quantization exactly
+        if (fabsf(valueRate) < 0.002f) {
+            valueRate = 0.0f;
+        }
+        return true;
+    }
+    else if (compressionType == FLOAT32) {
+        return bsIn.Read(valueRate);
+    }
+
+    return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+float quantizeCompressedValueRate(unsigned char compressionType, float valueRate)
+{
+    if (compressionType == FLOAT32)
+        return valueRate;
+    if (compressionType != FLOAT16)
+        return 0.0f;
+
+    RakNet::BitStream bs;
+    writeCompressedValueRate(bs, compressionType, valueRate);
+    readCompressedValueRate(bs, compressionType, valueRate);
+    return valueRate;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
@@ -0,0 +1,76 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       CommandCodec.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef COMMANDCODEC_H
+#define COMMANDCODEC_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "NetworkTypes.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const float MAX_VALUE_RATE = 100.0f; //dead reckoning rate range for FLOAT16 (units per second)
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace RakNet {
+class BitStream;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FUNCTION DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Encoding of command values on the copilot network, one function per direction,
+so that every message carrying a value uses the same NetCompressionTypes rules.
+
+Only FLOAT16 and FLOAT32 values carry a dead reckoning rate. Whether a rate is
+present is up to the message: single command messages imply it from the bytes
+left over, batched frames store an explicit flag.
+*/
+
+namespace Network {
+
+///Returns true if values of this compression type can carry a dead reckoning rate
+bool hasValueRate(unsigned char compressionType);
+
+///Write a command value using the given NetCompressionTypes
+void writeCompressedValue(RakNet::BitStream& bsOut, unsigned char compressionType, float value);
+
+///Read a command value written by writeCompressedValue()
+bool readCompressedValue(RakNet::BitStream& bsIn, unsigned char compressionType, float& value);
+
+///Returns the value a receiver decodes after writeCompressedValue()
+float quantizeCompressedValue(unsigned char compressionType, float value);
+
+///Write a dead reckoning rate. Does nothing unless hasValueRate(compressionType).
+void writeCompressedValueRate(RakNet::BitStream& bsOut, unsigned char compressionType, float valueRate);
+
+///Read a dead reckoning rate written by writeCompressedValueRate()
+bool readCompressedValueRate(RakNet::BitStream& bsIn, unsigned char compressionType, float& valueRate);
+
+///Returns the rate a receiver decodes after writeCompressedValueRate(), 0 unless hasValueRate(compressionType)
+float quantizeCompressedValueRate(unsigned char compressionType, float valueRate);
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // COMMANDCODEC_H
@@ -0,0 +1,349 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       CommandCodecProfile.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      CommandCodecProfile Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Loading of aircraft codec profiles, and the linear and enum value codecs they
+select per command.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "CommandCodecProfile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "CommandCodec.h"
+#include "CommandTableReader.h"
+
+#include "BitStream.h"
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+const uint32_t FNV_OFFSET_BASIS = 2166136261u;
+const uint32_t FNV_PRIME = 16777619u;
+
+int bitsToRepresent(unsigned int value)
+{
+    int bits = 0;
+    while (value > 0)
+    {
+        bits++;
+        value >>= 1;
+    }
+    return bits;
+}
+
+void hashBytes(uint32_t& hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+}
+
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CODEC TRAITS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+template <CommandCodecKind Kind>
+struct CommandCodecTraits;
+
+template <>
+struct CommandCodecTraits<COMMAND_CODEC_LINEAR>
+{
+    static const bool HAS_VALUE_RATE = true;
+
+    static unsigned int encode(const CommandCodecSpec& spec, float value)
+    {
+        float clamped = std::min(std::max(value, spec.minimum), spec.maximum);
+        return (unsigned int)((clamped - spec.minimum) / (spec.maximum - spec.minimum) * (float)spec.steps + 0.5f);
+    }
+
+    static float decode(const CommandCodecSpec& spec, unsigned int step)
+    {
+        return spec.minimum + (spec.maximum - spec.minimum) * (float)step / (float)spec.steps;
+    }
+
+    static void write(RakNet::BitStream& bsOut, const CommandCodecSpec& spec, float value)
+    {
+        bsOut.WriteBitsFromIntegerRange(encode(spec, value), 0u, spec.steps, spec.bits);
+    }
+
+    static bool read(RakNet::BitStream& bsIn, const CommandCodecSpec& spec, float& value)
+    {
+        unsigned int step = 0;
+        if (!bsIn.ReadBitsFromIntegerRange(step, 0u, spec.steps, spec.bits))
+            return false;
+        value = decode(spec, step);
+        return true;
+    }
+
+    static float quantize(const CommandCodecSpec& spec, float value)
+    {
+        return decode(spec, encode(spec, value));
+    }
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+template <>
+struct CommandCodecTraits<COMMAND_CODEC_ENUM>
+{
+    static const bool HAS_VALUE_RATE = false;
+
+    static unsigned int encode(const CommandCodecSpec& spec, float value)
+    {
+        unsigned int nearest = 0;
+        for (unsigned int i = 1; i < spec.values.size(); i++)
+        {
+            if (fabsf(spec.values[i] - value) < fabsf(spec.values[nearest] - value))
+                nearest = i;
+        }
+        return nearest;
+    }
+
+    static void write(RakNet::BitStream& bsOut, const CommandCodecSpec& spec, float value)
+    {
+        bsOut.WriteBitsFromIntegerRange(encode(spec, value), 0u, spec.steps, spec.bits);
+    }
+
+    static bool read(RakNet::BitStream& bsIn, const CommandCodecSpec& spec, float& value)
+    {
+        unsigned int index = 0;
+        if (!bsIn.ReadBitsFromIntegerRange(index, 0u, spec.steps, spec.bits) || index > spec.steps)
+            return false;
+        value = spec.values[index];
+        return true;
+    }
+
+    static float quantize(const CommandCodecSpec& spec, float value)
+    {
+        return spec.values[encode(spec, value)];
+    }
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+template <CommandCodecKind Kind>
+void bindCommandCodec(CommandCodecSpec& spec)
+{
+    spec.kind = Kind;
+    spec.write = &CommandCodecTraits<Kind>::write;
+    spec.read = &CommandCodecTraits<Kind>::read;
+    spec.quantize = &CommandCodecTraits<Kind>::quantize;
+    spec.hasValueRate = CommandCodecTraits<Kind>::HAS_VALUE_RATE;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+CommandCodecProfile::CommandCodecProfile()
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CommandCodecProfile::load(const std::string& path)
+{
+    const char* expected = "expected \"command codec\" or \"first-last codec\"";
+    std::vector<CommandCodecSpec> loadedSpecs;
+    std::vector<uint16_t> loadedIndex(COMMAND_TABLE_SIZE, NO_COMMAND_CODEC);
+
+    CommandTableReader reader(path);
+    while (reader.nextLine())
+    {
+        const char* text = reader.getLine();
+        unsigned int first = 0;
+        unsigned int last = 0;
+        if (!reader.readRange(text, COMMAND_TABLE_SIZE - 1, expected, first, last))
+            break;
+
+        if (loadedSpecs.size() >= NO_COMMAND_CODEC)
+        {
+            reader.fail("too many entries");
+            break;
+        }
+
+        CommandCodecSpec spec;
+        std::string lineError;
+        if (!bind(spec, text, lineError))
+        {
+            reader.fail(lineError);
+            break;
+        }
+
+        std::fill(loadedIndex.begin() + first, loadedIndex.begin() + last + 1, (uint16_t)loadedSpecs.size());
+        loadedSpecs.push_back(spec);
+    }
+
+    error = reader.getError();
+    if (!error.empty())
+        return false;
+
+    specs.swap(loadedSpecs);
+    specIndex.swap(loadedIndex);
+    updateFingerprint();
+    return true;
+}
+
+const std::string& CommandCodecProfile::getError() const
+{
+    return error;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CommandCodecProfile::bind(CommandCodecSpec& spec, const char* codec, std::string& lineError) const
+{
+    char kind[16] = {0};
+    int valuesOffset = 0;
+    if (sscanf(codec, "%15s %n", kind, &valuesOffset) != 1)
+    {
+        lineError = "expected a codec";
+        return false;
+    }
+    const char* values = codec + valuesOffset;
+
+    if (strcmp(kind, "linear") == 0)
+    {
+        int fields = sscanf(values, "%f %f %d %f", &spec.minimum, &spec.maximum, &spec.bits, &spec.deadband);
+        if (fields < 3)
+        {
+            lineError = "expected \"linear minimum maximum bits [deadband]\"";
+            return false;
+        }
+        if (!(spec.minimum < spec.maximum) || spec.bits < 1 || spec.bits > COMMAND_CODEC_MAX_BITS)
+        {
+            lineError = "linear range or bits out of range";
+            return false;
+        }
+
+        spec.steps = (1u << spec.bits) - 1;
+        bindCommandCodec<COMMAND_CODEC_LINEAR>(spec);
+        return true;
+    }
+
+    if (strcmp(kind, "enum") == 0)
+    {
+        char* end = nullptr;
+        for (float value = strtof(values, &end); end != values; value = strtof(values, &end))
+        {
+            spec.values.push_back(value);
+            values = end;
+        }
+        if (spec.values.size() < 2 || spec.values.size() > (size_t)COMMAND_CODEC_MAX_ENUM_VALUES)
+        {
+            lineError = "expected \"enum value value ...\" with 2 to " + std::to_string(COMMAND_CODEC_MAX_ENUM_VALUES) + " values";
+            return false;
+        }
+
+        spec.steps = (unsigned int)spec.values.size() - 1;
+        spec.bits = bitsToRepresent(spec.steps);
+        bindCommandCodec<COMMAND_CODEC_ENUM>(spec);
+        return true;
+    }
+
+    lineError = std::string("unknown codec \"") + kind + "\"";
+    return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandCodecProfile::clear()
+{
+    specs.clear();
+    specIndex.clear();
+    fingerprint = 0;
+}
+
+bool CommandCodecProfile::empty() const
+{
+    return specs.empty();
+}
+
+uint32_t CommandCodecProfile::getFingerprint() const
+{
+    return fingerprint;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandCodecProfile::updateFingerprint()
+{
+    if (specs.empty())
+    {
+        fingerprint = 0;
+        return;
+    }
+
+    //hash what each command decodes to, so that the same codecs written differently match
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (unsigned int command = 0; command < COMMAND_TABLE_SIZE; command++)
+    {
+        if (specIndex[command] == NO_COMMAND_CODEC)
+            continue;
+
+        const CommandCodecSpec& spec = specs[specIndex[command]];
+        uint16_t id = (uint16_t)command;
+        uint8_t kind = (uint8_t)spec.kind;
+        hashBytes(hash, &id, sizeof(id));
+        hashBytes(hash, &kind, sizeof(kind));
+        hashBytes(hash, &spec.steps, sizeof(spec.steps));
+        hashBytes(hash, &spec.deadband, sizeof(spec.deadband));
+        if (spec.kind == COMMAND_CODEC_LINEAR)
+        {
+            hashBytes(hash, &spec.minimum, sizeof(spec.minimum));
+            hashBytes(hash, &spec.maximum, sizeof(spec.maximum));
+        }
+        else
+        {
+            hashBytes(hash, spec.values.data(), spec.values.size() * sizeof(float));
+        }
+    }
+
+    //0 means no profile
+    fingerprint = (hash != 0) ? hash : 1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const CommandCodecSpec* CommandCodecProfile::find(unsigned short command) const
+{
+    if (specIndex.empty() || specIndex[command] == NO_COMMAND_CODEC)
+        return nullptr;
+
+    return &specs[specIndex[command]];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+float CommandCodecProfile::quantize(unsigned short command, unsigned char compressionType, float value) const
+{
+    const CommandCodecSpec* spec = find(command);
+    return spec ? spec->quantize(*spec, value) : quantizeCompressedValue(compressionType, value);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
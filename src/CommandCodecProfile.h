@@ -0,0 +1,139 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       CommandCodecProfile.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef COMMANDCODECPROFILE_H
+#define COMMANDCODECPROFILE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const int COMMAND_CODEC_MAX_BITS = 16; //widest linear codec
+    static const int COMMAND_CODEC_MAX_ENUM_VALUES = 256;
+    static const uint16_t NO_COMMAND_CODEC = 0xFFFF;
+
+    enum CommandCodecKind
+    {
+        /// Evenly spaced steps between a minimum and a maximum, with a dead reckoning rate
+        COMMAND_CODEC_LINEAR = 0,
+        /// One of a listed set of values, stepped
+        COMMAND_CODEC_ENUM,
+    };
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace RakNet {
+class BitStream;
+}
+
+namespace Network {
+
+struct CommandCodecSpec
+{
+    CommandCodecKind kind = COMMAND_CODEC_LINEAR;
+    float minimum = 0.0f; //linear only
+    float maximum = 1.0f;
+    unsigned int steps = 1; //linear: 2^bits - 1, enum: values - 1
+    int bits = 1;
+    std::vector<float> values; //enum only, in file order
+    float deadband = -1.0f; //dead reckoning tolerance, negative for the sender's own
+
+    //bound to the CommandCodecTraits of kind when loaded, so encoding does not switch on it
+    void (*write)(RakNet::BitStream& bsOut, const CommandCodecSpec& spec, float value) = nullptr;
+    bool (*read)(RakNet::BitStream& bsIn, const CommandCodecSpec& spec, float& value) = nullptr;
+    float (*quantize)(const CommandCodecSpec& spec, float value) = nullptr;
+    bool hasValueRate = false;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Per command value codecs from an aircraft profile. Without a profile every
+value carries its 3 bit NetCompressionTypes and is encoded by CommandCodec; with
+one, both ends already know how each listed command is encoded, so batched
+values of those commands are written with only the bits their range needs.
+
+A profile is only used while every copilot in the session loaded one with the
+same fingerprint, which the host checks as clients join and leave.
+
+The profile file has one entry per line:
+
+    # command or first-last, then the codec
+    # linear minimum maximum bits [deadband]     bits 1..COMMAND_CODEC_MAX_BITS
+    # enum value value ...                       2..COMMAND_CODEC_MAX_ENUM_VALUES values
+    2001-2003 linear -1 1 10 0.002
+    3005 enum -1 0 1
+
+Linear values are clamped to their range and carry a dead reckoning rate like
+FLOAT16. The deadband, if given, replaces the dead reckoning tolerance of the
+command. Enum values are sent as the index of the nearest listed value.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class CommandCodecProfile
+{
+public:
+    /// Constructor
+    CommandCodecProfile();
+
+    ///Load a profile file. Returns false and keeps the current profile on error.
+    bool load(const std::string& path);
+    const std::string& getError() const;
+
+    ///Drop the profile, every command goes back to its NetCompressionTypes
+    void clear();
+
+    bool empty() const;
+
+    ///Hash of every command's codec, 0 without a profile
+    uint32_t getFingerprint() const;
+
+    ///Codec of a command, nullptr if the profile does not list it
+    const CommandCodecSpec* find(unsigned short command) const;
+
+    ///The value a receiver decodes, by the profile if it lists the command, otherwise by compressionType
+    float quantize(unsigned short command, unsigned char compressionType, float value) const;
+
+private:
+    bool bind(CommandCodecSpec& spec, const char* codec, std::string& lineError) const;
+    void updateFingerprint();
+
+    std::vector<CommandCodecSpec> specs;
+    std::vector<uint16_t> specIndex; //per command ID, NO_COMMAND_CODEC if not listed. Empty until loaded.
+    uint32_t fingerprint = 0;
+    std::string error;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // COMMANDCODECPROFILE_H
@@ -0,0 +1,134 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       CommandLatency.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      CommandLatency Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Per seat and per message class one-way command latency histograms.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "CommandLatency.h"
+
+#include <cstdio>
+
+#include "UiChannel.h"
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+const char* MESSAGE_CLASS_NAMES[Network::NUM_COMMAND_LATENCY_CLASSES] = { "command", "value", "correction", "event" };
+
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+CommandLatency::CommandLatency()
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandLatency::add(int seatNumber, CommandBatchEntryType messageClass, uint64_t latencyUS)
+{
+    seats[seatNumber][messageClass].add(latencyUS);
+    changed = true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandLatency::clear()
+{
+    changed = !seats.empty();
+    seats.clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CommandLatency::takeChanged()
+{
+    bool wasChanged = changed;
+    changed = false;
+    return wasChanged;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandLatency::getSummary(std::vector<CommandLatencySummary>& summary) const
+{
+    summary.clear();
+
+    for (const auto& seat : seats)
+    {
+        for (int messageClass = 0; messageClass < NUM_COMMAND_LATENCY_CLASSES; messageClass++)
+        {
+            const LatencyHistogram& histogram = seat.second[messageClass];
+            if (histogram.getCount() == 0)
+                continue;
+
+            CommandLatencySummary entry;
+            entry.seatNumber = seat.first;
+            entry.messageClass = messageClass;
+            entry.count = histogram.getCount();
+            entry.p50US = histogram.getPercentileUS(0.5);
+            entry.p99US = histogram.getPercentileUS(0.99);
+            entry.maxUS = histogram.getMaxUS();
+            summary.push_back(entry);
+        }
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CommandLatency::exportCsv(const std::string& path) const
+{
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file)
+        return false;
+
+    bool ok = fprintf(file, "seat,class,count,min_us,mean_us,p50_us,p90_us,p99_us,p999_us,max_us\n") > 0;
+
+    for (const auto& seat : seats)
+    {
+        for (int messageClass = 0; messageClass < NUM_COMMAND_LATENCY_CLASSES && ok; messageClass++)
+        {
+            const LatencyHistogram& histogram = seat.second[messageClass];
+            if (histogram.getCount() == 0)
+                continue;
+
+            ok = fprintf(file, "%d,%s,%llu,%llu,%.0f,%llu,%llu,%llu,%llu,%llu\n", seat.first, MESSAGE_CLASS_NAMES[messageClass],
+                         (unsigned long long)histogram.getCount(), (unsigned long long)histogram.getMinUS(), histogram.getMeanUS(),
+                         (unsigned long long)histogram.getPercentileUS(0.5), (unsigned long long)histogram.getPercentileUS(0.9),
+                         (unsigned long long)histogram.getPercentileUS(0.99), (unsigned long long)histogram.getPercentileUS(0.999),
+                         (unsigned long long)histogram.getMaxUS()) > 0;
+        }
+    }
+
+    return (fclose(file) == 0) && ok;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const char* CommandLatency::getMessageClassName(int messageClass)
+{
+    if (messageClass < 0 || messageClass >= NUM_COMMAND_LATENCY_CLASSES)
+        return "unknown";
+
+    return MESSAGE_CLASS_NAMES[messageClass];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
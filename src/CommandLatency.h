@@ -0,0 +1,103 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       CommandLatency.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef COMMANDLATENCY_H
+#define COMMANDLATENCY_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CommandBatch.h"
+#include "LatencyHistogram.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const int NUM_COMMAND_LATENCY_CLASSES = BATCH_EVENT + 1; //one per CommandBatchEntryType
+    static const int COMMAND_LATENCY_PUBLISH_INTERVAL_MS = 1000; //how often the GUI summary is refreshed
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+struct CommandLatencySummary;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** One-way latency of received commands, from the moment the sending copilot got
+them from DCS to the moment they are handed to our DCS, per source seat and per
+message class (command, command value, correction, event).
+
+The send time comes from the ID_TIMESTAMP stamp in front of every command
+message. RakNet shifts it into the local clock on each hop, so the latency is
+only as good as its clock differential estimate, which is refined by the
+occasional pings. Resolution is one millisecond.
+
+Histograms are created the first time a seat is heard from and live until
+clear(), which the Network calls when the session ends.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class CommandLatency
+{
+public:
+    /// Constructor
+    CommandLatency();
+
+    ///Record one received command
+    void add(int seatNumber, CommandBatchEntryType messageClass, uint64_t latencyUS);
+
+    void clear();
+
+    ///Returns true if anything was added since the last call
+    bool takeChanged();
+
+    ///Percentiles of every non-empty histogram, ordered by seat then class
+    void getSummary(std::vector<CommandLatencySummary>& summary) const;
+
+    ///Write every non-empty histogram's count and percentiles as CSV. Returns false if the file could not be written.
+    bool exportCsv(const std::string& path) const;
+
+    static const char* getMessageClassName(int messageClass);
+
+private:
+    typedef std::array<LatencyHistogram, NUM_COMMAND_LATENCY_CLASSES> SeatHistograms;
+
+    std::map<int, SeatHistograms> seats;
+    bool changed = false;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // COMMANDLATENCY_H
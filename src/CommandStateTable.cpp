@@ -0,0 +1,233 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       CommandStateTable.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      CommandStateTable Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+CommandStateTable keeps the latest value of each command and a hash tree over
+them for the master sync protocol.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+Values are hashed by their bit pattern, so both sides have to store exactly what
+went over the wire (see quantizeCompressedValue()). Hashes are FNV-1a, which is
+plenty to detect drift. They are not meant to resist deliberate collisions.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "CommandStateTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+const uint32_t FNV_OFFSET_BASIS = 2166136261u;
+const uint32_t FNV_PRIME = 16777619u;
+
+inline uint32_t hashBytes(uint32_t hash, const void* data, size_t length)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+inline bool commandLess(const Network::CommandState& state, unsigned short command)
+{
+    return state.command < command;
+}
+
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+CommandStateTable::CommandStateTable()
+{
+    clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandStateTable::set(unsigned short command, float value)
+{
+    unsigned int bucket = getBucketIndex(command);
+    std::vector<CommandState>& states = buckets[bucket];
+
+    auto it = std::lower_bound(states.begin(), states.end(), command, commandLess);
+    if (it != states.end() && it->command == command)
+    {
+        if (memcmp(&it->value, &value, sizeof(float)) == 0)
+            return;
+        it->value = value;
+    }
+    else
+    {
+        CommandState state;
+        state.command = command;
+        state.value = value;
+        states.insert(it, state);
+        numCommands++;
+    }
+
+    dirtyBuckets.set(bucket);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CommandStateTable::get(unsigned short command, float& value) const
+{
+    const std::vector<CommandState>& states = buckets[getBucketIndex(command)];
+
+    auto it = std::lower_bound(states.begin(), states.end(), command, commandLess);
+    if (it != states.end() && it->command == command)
+    {
+        value = it->value;
+        return true;
+    }
+
+    return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandStateTable::clear()
+{
+    for (auto& states : buckets) {
+        states.clear();
+    }
+    numCommands = 0;
+    dirtyBuckets.set();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+size_t CommandStateTable::size() const
+{
+    return numCommands;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+uint32_t CommandStateTable::getRootHash()
+{
+    updateHashes();
+    return rootHash;
+}
+
+uint32_t CommandStateTable::getGroupHash(unsigned int group)
+{
+    updateHashes();
+    return groupHashes[group % SYNC_GROUP_COUNT];
+}
+
+uint32_t CommandStateTable::getBucketHash(unsigned int bucket)
+{
+    updateHashes();
+    return bucketHashes[bucket % SYNC_BUCKET_COUNT];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const std::vector<CommandState>& CommandStateTable::getBucket(unsigned int bucket) const
+{
+    return buckets[bucket % SYNC_BUCKET_COUNT];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandStateTable::setBucket(unsigned int bucket, const std::vector<CommandState>& states)
+{
+    bucket = bucket % SYNC_BUCKET_COUNT;
+
+    numCommands -= buckets[bucket].size();
+    buckets[bucket].clear();
+
+    //go through set() so that stray or repeated IDs from a bad packet cannot break the sort order
+    for (const auto& state : states)
+    {
+        if (getBucketIndex(state.command) == bucket)
+            set(state.command, state.value);
+    }
+
+    dirtyBuckets.set(bucket);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandStateTable::getSnapshot(std::vector<CommandState>& states) const
+{
+    states.clear();
+    states.reserve(numCommands);
+    for (const auto& bucketStates : buckets) {
+        states.insert(states.end(), bucketStates.begin(), bucketStates.end());
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int CommandStateTable::getBucketIndex(unsigned short command)
+{
+    //consecutive IDs (one cockpit device) land in different buckets
+    return command % SYNC_BUCKET_COUNT;
+}
+
+unsigned int CommandStateTable::getGroupIndex(unsigned int bucket)
+{
+    return bucket / SYNC_BUCKETS_PER_GROUP;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandStateTable::updateHashes()
+{
+    if (dirtyBuckets.none())
+        return;
+
+    std::bitset<SYNC_GROUP_COUNT> dirtyGroups;
+    for (unsigned int bucket = 0; bucket < SYNC_BUCKET_COUNT; bucket++)
+    {
+        if (!dirtyBuckets.test(bucket))
+            continue;
+
+        uint32_t hash = FNV_OFFSET_BASIS;
+        for (const auto& state : buckets[bucket])
+        {
+            hash = hashBytes(hash, &state.command, sizeof(state.command));
+            hash = hashBytes(hash, &state.value, sizeof(state.value));
+        }
+        bucketHashes[bucket] = hash;
+        dirtyGroups.set(getGroupIndex(bucket));
+    }
+    dirtyBuckets.reset();
+
+    for (unsigned int group = 0; group < SYNC_GROUP_COUNT; group++)
+    {
+        if (dirtyGroups.test(group)) {
+            groupHashes[group] = hashBytes(FNV_OFFSET_BASIS, &bucketHashes[group * SYNC_BUCKETS_PER_GROUP], SYNC_BUCKETS_PER_GROUP * sizeof(uint32_t));
+        }
+    }
+
+    rootHash = hashBytes(FNV_OFFSET_BASIS, groupHashes.data(), SYNC_GROUP_COUNT * sizeof(uint32_t));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
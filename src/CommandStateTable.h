@@ -0,0 +1,121 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       CommandStateTable.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef COMMANDSTATETABLE_H
+#define COMMANDSTATETABLE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const unsigned int SYNC_GROUP_COUNT = 16;
+    static const unsigned int SYNC_BUCKETS_PER_GROUP = 16;
+    static const unsigned int SYNC_BUCKET_COUNT = SYNC_GROUP_COUNT * SYNC_BUCKETS_PER_GROUP;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+struct CommandState
+{
+    unsigned short command = 0;
+    float value = 0.0f;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Latest value of every command ID seen in the session, with a three level
+hash tree over it so two tables can be compared without sending either one.
+
+Commands are spread over SYNC_BUCKET_COUNT buckets by ID. Each bucket is hashed
+from its sorted (command, value) pairs, each group from its SYNC_BUCKETS_PER_GROUP
+bucket hashes, and the root from the group hashes. Comparing the root tells
+whether anything differs. Comparing group and then bucket hashes narrows it down
+to the buckets that actually have to be sent.
+
+Hashes are only recomputed for buckets changed since the last call.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class CommandStateTable
+{
+public:
+    /// Constructor
+    CommandStateTable();
+
+    ///Store the latest value of a command
+    void set(unsigned short command, float value);
+
+    ///Returns false if the command has no value yet
+    bool get(unsigned short command, float& value) const;
+
+    ///Remove every command
+    void clear();
+
+    ///Number of commands with a value
+    size_t size() const;
+
+    uint32_t getRootHash();
+    uint32_t getGroupHash(unsigned int group);
+    uint32_t getBucketHash(unsigned int bucket);
+
+    ///Commands in a bucket, sorted by ID
+    const std::vector<CommandState>& getBucket(unsigned int bucket) const;
+
+    ///Replace the contents of a bucket with the entries from another table
+    void setBucket(unsigned int bucket, const std::vector<CommandState>& states);
+
+    ///Copy out every command, sorted by bucket then ID
+    void getSnapshot(std::vector<CommandState>& states) const;
+
+    static unsigned int getBucketIndex(unsigned short command);
+    static unsigned int getGroupIndex(unsigned int bucket);
+
+private:
+    void updateHashes();
+
+    std::array<std::vector<CommandState>, SYNC_BUCKET_COUNT> buckets;
+    std::array<uint32_t, SYNC_BUCKET_COUNT> bucketHashes;
+    std::array<uint32_t, SYNC_GROUP_COUNT> groupHashes;
+    uint32_t rootHash;
+
+    std::bitset<SYNC_BUCKET_COUNT> dirtyBuckets;
+    size_t numCommands = 0;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // COMMANDSTATETABLE_H
@@ -0,0 +1,137 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       CommandTableReader.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      CommandTableReader Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Line and ID range parsing shared by the per command table files.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "CommandTableReader.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+CommandTableReader::CommandTableReader(const std::string& path_)
+    : path(path_)
+{
+    line[0] = 0;
+    file = fopen(path.c_str(), "r");
+    if (!file)
+        error = "could not open " + path;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+CommandTableReader::~CommandTableReader()
+{
+    if (file)
+        fclose(file);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CommandTableReader::nextLine()
+{
+    while (error.empty() && fgets(line, sizeof(line), file))
+    {
+        lineNumber++;
+
+        //the rest of a cut line would be read as an entry of its own
+        size_t length = strlen(line);
+        if (length == sizeof(line) - 1 && line[length - 1] != '\n' && !feof(file))
+        {
+            fail("line longer than " + std::to_string(COMMAND_TABLE_LINE_SIZE - 2) + " characters");
+            return false;
+        }
+
+        const char* text = line;
+        while (isspace((unsigned char)*text))
+            text++;
+        if (*text != 0 && *text != '#')
+            return true;
+    }
+    return false;
+}
+
+const char* CommandTableReader::getLine() const
+{
+    return line;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CommandTableReader::readRange(const char*& text, unsigned int maximum, const char* expected, unsigned int& first, unsigned int& last)
+{
+    const char* cursor = text;
+    while (isspace((unsigned char)*cursor))
+        cursor++;
+
+    //strtoul would take a sign, so the digits are checked first
+    if (!isdigit((unsigned char)*cursor))
+    {
+        fail(expected);
+        return false;
+    }
+    char* end = nullptr;
+    unsigned long readFirst = strtoul(cursor, &end, 10);
+    unsigned long readLast = readFirst;
+    cursor = end;
+
+    if (*cursor == '-' && isdigit((unsigned char)cursor[1]))
+    {
+        readLast = strtoul(cursor + 1, &end, 10);
+        cursor = end;
+    }
+
+    if (*cursor != 0 && !isspace((unsigned char)*cursor))
+    {
+        fail(expected);
+        return false;
+    }
+    if (readFirst > readLast || readLast > maximum)
+    {
+        fail("ID out of range, 0 to " + std::to_string(maximum));
+        return false;
+    }
+
+    while (isspace((unsigned char)*cursor))
+        cursor++;
+
+    first = (unsigned int)readFirst;
+    last = (unsigned int)readLast;
+    text = cursor;
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CommandTableReader::fail(const std::string& message)
+{
+    if (error.empty())
+        error = path + ":" + std::to_string(lineNumber) + ": " + message;
+}
+
+const std::string& CommandTableReader::getError() const
+{
+    return error;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
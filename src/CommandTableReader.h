@@ -0,0 +1,95 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       CommandTableReader.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef COMMANDTABLEREADER_H
+#define COMMANDTABLEREADER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstdio>
+#include <string>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const unsigned int COMMAND_TABLE_SIZE = 65536; //one entry per command ID
+    static const int COMMAND_TABLE_LINE_SIZE = 1024;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Reads the per command table files (ordering channels, dead reckoning
+tolerances, codec profiles, seat interests). They share one layout: an entry
+per line, blank lines and lines starting with # skipped, and each entry naming
+a single ID or a "first-last" range, followed by what the table sets for it.
+The table parses that rest of the line itself and calls fail() if it is wrong.
+
+Errors are "path:line: message", ready to show. A table is only applied if
+getError() is empty after the last nextLine().
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class CommandTableReader
+{
+public:
+    /// Constructor. Opens the file, check getError().
+    explicit CommandTableReader(const std::string& path_);
+    /// Destructor. Closes the file.
+    ~CommandTableReader();
+
+    ///Advance to the next entry. Returns false at the end of the file or once the table failed.
+    bool nextLine();
+    const char* getLine() const;
+
+    ///Read "first-last" or a single ID at text, then the blanks after it, leaving text at the rest of the line.
+    ///Returns false and fails the table with expected if there is none, or if the range is not within 0..maximum.
+    bool readRange(const char*& text, unsigned int maximum, const char* expected, unsigned int& first, unsigned int& last);
+
+    ///Stop reading, with the current line's position in front of message
+    void fail(const std::string& message);
+    const std::string& getError() const;
+
+private:
+    std::string path;
+    FILE* file = nullptr;
+    char line[COMMAND_TABLE_LINE_SIZE];
+    int lineNumber = 0;
+    std::string error;
+
+    // Make this object be noncopyable because it holds a file
+    CommandTableReader(const CommandTableReader&);
+    const CommandTableReader &operator =(const CommandTableReader &);
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // COMMANDTABLEREADER_H
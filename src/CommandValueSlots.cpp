@@ -0,0 +1,89 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       CommandValueSlots.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      CommandValueSlots Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+CommandValueSlots keeps the newest analog value per command until it is sent.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+clear() only resets the index entries of the slots in use, so it costs the
+number of values waiting and not the size of the index.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "CommandValueSlots.h"
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+CommandValueSlots::CommandValueSlots()
+    : slotIndex(COMMAND_VALUE_SLOT_TABLE_SIZE, NO_COMMAND_VALUE_SLOT)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CommandValueSlots::set(unsigned short command, float value, bool deadReckoned, float valueRate)
+{
+    uint16_t index = slotIndex[command];
+    if (index != NO_COMMAND_VALUE_SLOT)
+    {
+        CommandValueSlot& slot = pending[index];
+        slot.value = value;
+        slot.deadReckoned = deadReckoned;
+        slot.valueRate = valueRate;
+        coalesced++;
+        return true;
+    }
+
+    CommandValueSlot slot;
+    slot.command = command;
+    slot.value = value;
+    slot.deadReckoned = deadReckoned;
+    slot.valueRate = valueRate;
+    slotIndex[command] = (uint16_t)pending.size();
+    pending.push_back(slot);
+    return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const std::vector<CommandValueSlot>& CommandValueSlots::getSlots() const
+{
+    return pending;
+}
+
+bool CommandValueSlots::empty() const
+{
+    return pending.empty();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int CommandValueSlots::clear()
+{
+    for (const auto& slot : pending)
+        slotIndex[slot.command] = NO_COMMAND_VALUE_SLOT;
+    pending.clear();
+
+    unsigned int coalescedSinceClear = coalesced;
+    coalesced = 0;
+    return coalescedSinceClear;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
@@ -28,15 +28,39 @@ SOURCES += main.cpp\
     banlistwindow.cpp \
         mainwindow.cpp \
     NetworkLocal.cpp \
+    OrderingChannels.cpp \
+    CommandTableReader.cpp \
     settingswindow.cpp \
     serverstart.cpp \
     connectionwindow.cpp \
     aboutwindow.cpp \
     clickableimage.cpp \
-    Network.cpp
+    statisticsgraph.cpp \
+    Network.cpp \
+    ClientInfo.cpp \
+    ClientTable.cpp \
+    AnimationStream.cpp \
+    CommandBatch.cpp \
+    CommandLatency.cpp \
+    LatencyHistogram.cpp \
+    CommandStateTable.cpp \
+    CommandValueSlots.cpp \
+    DeadReckoning.cpp \
+    CommandCodec.cpp \
+    CommandCodecProfile.cpp \
+    SeatInterest.cpp \
+    StatisticsSampler.cpp \
+    NetworkThread.cpp \
+    UiChannel.cpp \
+    Logger.cpp \
+    PacketTrace.cpp \
+    SessionRecorder.cpp \
+    LocalSharedMemory.cpp
 
 HEADERS  += mainwindow.h \
     NetworkLocal.h \
+    OrderingChannels.h \
+    CommandTableReader.h \
     NetworkTypes.h \
     banlistwindow.h \
     settingswindow.h \
@@ -45,7 +69,32 @@ HEADERS  += mainwindow.h \
     aboutwindow.h \
     version.h \
     clickableimage.h \
-    Network.h
+    statisticsgraph.h \
+    Network.h \
+    ClientInfo.h \
+    ClientTable.h \
+    AnimationStream.h \
+    CommandBatch.h \
+    CommandLatency.h \
+    LatencyHistogram.h \
+    CommandStateTable.h \
+    CommandValueSlots.h \
+    DeadReckoning.h \
+    CommandCodec.h \
+    CommandCodecProfile.h \
+    SeatInterest.h \
+    StatisticsSampler.h \
+    NetworkThread.h \
+    UiChannel.h \
+    Logger.h \
+    PacketTrace.h \
+    SessionRecorder.h \
+    LocalSharedMemory.h \
+    DcsShm.h \
+    LockFree.h
+
+# qmake CONFIG+=packet_trace records command packets to packet_trace.bin (see PacketTrace.h)
+packet_trace: DEFINES += DCS_COPILOT_PACKET_TRACE
 
 INCLUDEPATH +=$$PWD/../3rdparty/RakNet/Source
 INCLUDEPATH += $$PWD/.
@@ -62,16 +111,28 @@ FORMS    += mainwindow.ui \
 CONFIG += static
 LIBS += Ws2_32.lib
 CONFIG(release, debug|release): {
+    RAKNET_CONFIG = release
+    RAKNET_LIB = $$PWD/../3rdparty/RakNet/Lib/RakNetStatic_x64.lib
     LIBS += -L$$PWD/../3rdparty/RakNet/Lib/ -lRakNetStatic_x64
-    PRE_TARGETDEPS += $$PWD/../3rdparty/RakNet/Lib/RakNetStatic_x64.lib
     message("64-bit STATIC release")
 }
 else:CONFIG(debug, debug|release): {
+    RAKNET_CONFIG = debug
+    RAKNET_LIB = $$PWD/../3rdparty/RakNet/Lib/RakNetStatic_x64d.lib
     LIBS += -L$$PWD/../3rdparty/RakNet/Lib/ -lRakNetStatic_x64d
-    PRE_TARGETDEPS += $$PWD/../3rdparty/RakNet/Lib/RakNetStatic_x64d.lib
     message("64-bit STATIC debug")
 }
 
+# RakNet is built from 3rdparty/RakNet/Source on every build, make only recompiles what changed. Its Source carries
+# API the application uses, so a library built elsewhere from stock RakNet will not link.
+raknettarget.target = $$RAKNET_LIB
+raknettarget.commands = $$QMAKE_QMAKE -o Makefile.RakNet.$$RAKNET_CONFIG CONFIG-=debug_and_release CONFIG+=$$RAKNET_CONFIG \
+                        $$shell_path($$PWD/../3rdparty/RakNet/RakNetLibStatic.pro) && $(MAKE) -f Makefile.RakNet.$$RAKNET_CONFIG
+raknettarget.depends = FORCE
+
+PRE_TARGETDEPS += $$RAKNET_LIB
+QMAKE_EXTRA_TARGETS += raknettarget
+
 RESOURCES += \
     resource.qrc
 
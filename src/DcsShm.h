@@ -0,0 +1,411 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       DcsShm.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef DCSSHM_H
+#define DCSSHM_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/* Shared memory link between a DCS aircraft module and DCS Copilot, the
+alternative to the RakNet listener on port 37820. Plain C, header only, so it
+can be copied into an EFM or any other aircraft module as is.
+
+DCS Copilot creates a named shared memory block holding two single-producer,
+single-consumer byte rings, one per direction. A message is the same bytes the
+aircraft would pass to RakPeer::Send() on the RakNet listener, starting with
+its ID_LOCAL_* message ID, so the aircraft's encode and decode code is shared
+between the two links. Nothing is acknowledged or resent: a full ring refuses
+the message and the sender decides whether to retry next frame.
+
+Aircraft side, from the simulation thread:
+
+    DcsShm shm;
+    dcsShmInit(&shm);
+
+    every frame:
+        if (!dcsShmIsOpen(&shm))
+            dcsShmOpen(&shm);            //0 until the copilot listener runs
+
+        dcsShmSend(&shm, data, length);  //any number of messages
+        dcsShmSignal(&shm);              //once, wakes the copilot and counts as a heartbeat
+
+        while ((length = dcsShmReceive(&shm, buffer, DCS_SHM_MAX_MESSAGE_SIZE)) > 0)
+            handle(buffer, length);
+
+    on exit:
+        dcsShmClose(&shm);
+
+The copilot counts the aircraft as lost when dcsShmSignal() has not been called
+for DCS_SHM_TIMEOUT_MS.
+
+On Windows, include this header after winsock2.h if the module uses it. */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define DCS_SHM_MAGIC 0x4D534344u /* "DCSM", written last by the copilot once the block is ready */
+#define DCS_SHM_VERSION 1u
+#define DCS_SHM_RING_SIZE (256u * 1024u) /* bytes per direction, a power of two */
+#define DCS_SHM_MAX_MESSAGE_SIZE (16u * 1024u) /* longest message, and the buffer size dcsShmReceive() needs */
+#define DCS_SHM_TIMEOUT_MS 1000 /* same as the RakNet listener's timeout */
+
+#if defined(_WIN32)
+#define DCS_SHM_NAME "Local\\DCSCopilotShm"
+#define DCS_SHM_WAKE_EVENT_NAME "Local\\DCSCopilotShmWake"
+#else
+#define DCS_SHM_NAME "/dcs_copilot_shm"
+#endif
+
+#if defined(_MSC_VER)
+#define DCS_SHM_INLINE static __inline
+#else
+#define DCS_SHM_INLINE static inline
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+LAYOUT
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/* head and tail count bytes ever written and read, so head - tail is the fill
+level even after they wrap. Each sits on its own cache line. A message is a
+uint32_t length followed by the data, padded to 4 bytes, so a length never
+straddles the end of the ring. */
+typedef struct DcsShmRing
+{
+    volatile uint32_t head; /* written by the producer only */
+    uint8_t headPadding[60];
+    volatile uint32_t tail; /* written by the consumer only */
+    uint8_t tailPadding[60];
+    uint8_t data[DCS_SHM_RING_SIZE];
+} DcsShmRing;
+
+typedef struct DcsShmLayout
+{
+    volatile uint32_t magic;
+    uint32_t version;
+    volatile uint32_t copilotHeartbeat; /* bumped by the copilot every loop */
+    volatile uint32_t dcsHeartbeat; /* bumped by dcsShmSignal() */
+    volatile uint32_t dcsSession; /* bumped by dcsShmOpen(), tells the copilot a new aircraft attached */
+    volatile uint32_t dcsAttached; /* 1 between dcsShmOpen() and dcsShmClose() */
+    uint8_t padding[40];
+    DcsShmRing toCopilot;
+    DcsShmRing toDcs;
+} DcsShmLayout;
+
+typedef struct DcsShm
+{
+    DcsShmLayout* layout;
+#if defined(_WIN32)
+    HANDLE mapping;
+    HANDLE wakeEvent;
+#else
+    int file;
+#endif
+} DcsShm;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+RINGS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/* Acquire load and release store. DCS only runs on x64, where MSVC needs no
+more than a compiler barrier. */
+#if defined(_MSC_VER)
+DCS_SHM_INLINE uint32_t dcsShmLoad(const volatile uint32_t* value)
+{
+    uint32_t result = *value;
+    _ReadWriteBarrier();
+    return result;
+}
+
+DCS_SHM_INLINE void dcsShmStore(volatile uint32_t* value, uint32_t newValue)
+{
+    _ReadWriteBarrier();
+    *value = newValue;
+}
+#else
+DCS_SHM_INLINE uint32_t dcsShmLoad(const volatile uint32_t* value)
+{
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+DCS_SHM_INLINE void dcsShmStore(volatile uint32_t* value, uint32_t newValue)
+{
+    __atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+}
+#endif
+
+DCS_SHM_INLINE uint32_t dcsShmPaddedSize(uint32_t length)
+{
+    return (uint32_t)sizeof(uint32_t) + ((length + 3u) & ~3u);
+}
+
+DCS_SHM_INLINE void dcsShmCopyIn(DcsShmRing* ring, uint32_t position, const void* data, uint32_t length)
+{
+    uint32_t offset = position & (DCS_SHM_RING_SIZE - 1u);
+    uint32_t first = DCS_SHM_RING_SIZE - offset;
+
+    if (first >= length) {
+        memcpy(ring->data + offset, data, length);
+    }
+    else {
+        memcpy(ring->data + offset, data, first);
+        memcpy(ring->data, (const uint8_t*)data + first, length - first);
+    }
+}
+
+DCS_SHM_INLINE void dcsShmCopyOut(const DcsShmRing* ring, uint32_t position, void* data, uint32_t length)
+{
+    uint32_t offset = position & (DCS_SHM_RING_SIZE - 1u);
+    uint32_t first = DCS_SHM_RING_SIZE - offset;
+
+    if (first >= length) {
+        memcpy(data, ring->data + offset, length);
+    }
+    else {
+        memcpy(data, ring->data + offset, first);
+        memcpy((uint8_t*)data + first, ring->data, length - first);
+    }
+}
+
+/* Producer only. Returns 1 if the message was queued, 0 if the ring is full or the message is empty or too long. */
+DCS_SHM_INLINE int dcsShmWrite(DcsShmRing* ring, const void* data, uint32_t length)
+{
+    uint32_t head = ring->head;
+    uint32_t tail = dcsShmLoad(&ring->tail);
+
+    if (length == 0 || length > DCS_SHM_MAX_MESSAGE_SIZE || dcsShmPaddedSize(length) > DCS_SHM_RING_SIZE - (head - tail))
+        return 0;
+
+    dcsShmCopyIn(ring, head, &length, (uint32_t)sizeof(uint32_t));
+    dcsShmCopyIn(ring, head + (uint32_t)sizeof(uint32_t), data, length);
+    dcsShmStore(&ring->head, head + dcsShmPaddedSize(length));
+    return 1;
+}
+
+/* Consumer only. Copies the oldest message into buffer and returns its length, or 0 if the ring is empty.
+A length the producer could not have written means the ring is corrupt, and it is emptied. */
+DCS_SHM_INLINE uint32_t dcsShmRead(DcsShmRing* ring, void* buffer, uint32_t capacity)
+{
+    uint32_t tail = ring->tail;
+    uint32_t head = dcsShmLoad(&ring->head);
+    uint32_t length = 0;
+
+    if (head == tail)
+        return 0;
+
+    dcsShmCopyOut(ring, tail, &length, (uint32_t)sizeof(uint32_t));
+    if (length == 0 || length > DCS_SHM_MAX_MESSAGE_SIZE || length > capacity || dcsShmPaddedSize(length) > head - tail)
+    {
+        dcsShmStore(&ring->tail, head);
+        return 0;
+    }
+
+    dcsShmCopyOut(ring, tail + (uint32_t)sizeof(uint32_t), buffer, length);
+    dcsShmStore(&ring->tail, tail + dcsShmPaddedSize(length));
+    return length;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+MAPPING
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+DCS_SHM_INLINE void dcsShmInit(DcsShm* shm)
+{
+    shm->layout = NULL;
+#if defined(_WIN32)
+    shm->mapping = NULL;
+    shm->wakeEvent = NULL;
+#else
+    shm->file = -1;
+#endif
+}
+
+DCS_SHM_INLINE int dcsShmIsOpen(const DcsShm* shm)
+{
+    return shm->layout != NULL;
+}
+
+/* Map the block. The copilot creates it, the aircraft only opens an existing one. Returns 1 on success. */
+DCS_SHM_INLINE int dcsShmMap(DcsShm* shm, int create)
+{
+    void* view = NULL;
+
+#if defined(_WIN32)
+    if (create)
+        shm->mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)sizeof(DcsShmLayout), DCS_SHM_NAME);
+    else
+        shm->mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, DCS_SHM_NAME);
+    if (shm->mapping == NULL)
+        return 0;
+
+    view = MapViewOfFile(shm->mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(DcsShmLayout));
+    if (view == NULL)
+    {
+        CloseHandle(shm->mapping);
+        shm->mapping = NULL;
+        return 0;
+    }
+#else
+    shm->file = shm_open(DCS_SHM_NAME, create ? (O_RDWR | O_CREAT) : O_RDWR, 0600);
+    if (shm->file < 0)
+        return 0;
+
+    if (create && ftruncate(shm->file, (off_t)sizeof(DcsShmLayout)) != 0)
+    {
+        close(shm->file);
+        shm->file = -1;
+        return 0;
+    }
+
+    view = mmap(NULL, sizeof(DcsShmLayout), PROT_READ | PROT_WRITE, MAP_SHARED, shm->file, 0);
+    if (view == MAP_FAILED)
+    {
+        close(shm->file);
+        shm->file = -1;
+        return 0;
+    }
+#endif
+
+    shm->layout = (DcsShmLayout*)view;
+    return 1;
+}
+
+DCS_SHM_INLINE void dcsShmUnmap(DcsShm* shm)
+{
+    if (shm->layout == NULL)
+        return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile((void*)shm->layout);
+    CloseHandle(shm->mapping);
+    shm->mapping = NULL;
+    if (shm->wakeEvent != NULL)
+        CloseHandle(shm->wakeEvent);
+    shm->wakeEvent = NULL;
+#else
+    munmap((void*)shm->layout, sizeof(DcsShmLayout));
+    close(shm->file);
+    shm->file = -1;
+#endif
+
+    shm->layout = NULL;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+AIRCRAFT SIDE
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/* Attach to a running copilot listener. Returns 0 if it is not running (yet), 1 when attached. */
+DCS_SHM_INLINE int dcsShmOpen(DcsShm* shm)
+{
+    DcsShmLayout* layout;
+
+    if (!dcsShmMap(shm, 0))
+        return 0;
+
+    layout = shm->layout;
+    if (dcsShmLoad(&layout->magic) != DCS_SHM_MAGIC || layout->version != DCS_SHM_VERSION)
+    {
+        dcsShmUnmap(shm);
+        return 0;
+    }
+
+#if defined(_WIN32)
+    shm->wakeEvent = OpenEventA(EVENT_MODIFY_STATE, FALSE, DCS_SHM_WAKE_EVENT_NAME);
+#endif
+
+    /* drop what was queued for a previous aircraft */
+    dcsShmStore(&layout->toDcs.tail, dcsShmLoad(&layout->toDcs.head));
+    dcsShmStore(&layout->dcsAttached, 1u);
+    dcsShmStore(&layout->dcsSession, layout->dcsSession + 1u);
+    return 1;
+}
+
+DCS_SHM_INLINE void dcsShmClose(DcsShm* shm)
+{
+    if (shm->layout == NULL)
+        return;
+
+    dcsShmStore(&shm->layout->dcsAttached, 0u);
+    dcsShmUnmap(shm);
+}
+
+/* Queue one message for the copilot. Returns 1 if queued, 0 if not attached, the ring is full or the message is too long. */
+DCS_SHM_INLINE int dcsShmSend(DcsShm* shm, const void* data, uint32_t length)
+{
+    if (shm->layout == NULL)
+        return 0;
+
+    return dcsShmWrite(&shm->layout->toCopilot, data, length);
+}
+
+/* Wake the copilot to read what was sent. Call once per frame, also without messages, as it is the heartbeat.
+Closes the link if the copilot listener has stopped, so the next dcsShmOpen() finds a restarted one. */
+DCS_SHM_INLINE void dcsShmSignal(DcsShm* shm)
+{
+    if (shm->layout == NULL)
+        return;
+
+    if (dcsShmLoad(&shm->layout->magic) != DCS_SHM_MAGIC)
+    {
+        dcsShmClose(shm);
+        return;
+    }
+
+    dcsShmStore(&shm->layout->dcsHeartbeat, shm->layout->dcsHeartbeat + 1u);
+#if defined(_WIN32)
+    if (shm->wakeEvent != NULL)
+        SetEvent(shm->wakeEvent);
+#endif
+}
+
+/* Copy the next message from the copilot into buffer (DCS_SHM_MAX_MESSAGE_SIZE bytes). Returns its length, 0 if none. */
+DCS_SHM_INLINE uint32_t dcsShmReceive(DcsShm* shm, void* buffer, uint32_t capacity)
+{
+    if (shm->layout == NULL)
+        return 0;
+
+    return dcsShmRead(&shm->layout->toDcs, buffer, capacity);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // DCSSHM_H
@@ -0,0 +1,340 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       DeadReckoning.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      DeadReckoningSender and DeadReckoningReceiver Classes
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Send side thresholding and receive side extrapolation of analog command values.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "DeadReckoning.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "CommandCodec.h"
+#include "CommandCodecProfile.h"
+#include "CommandTableReader.h"
+#include "CommandValueSlots.h"
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+float extrapolate(float value, float valueRate, RakNet::Time from, RakNet::Time to)
+{
+    return value + valueRate * (float)(to - from) / 1000.0f;
+}
+
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+DeadReckoningSender::DeadReckoningSender() : trackIndex(COMMAND_TABLE_SIZE, NO_DEAD_RECKONING_TRACK)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void DeadReckoningSender::setEnabled(bool enabled_)
+{
+    enabled = enabled_;
+    clear();
+}
+
+bool DeadReckoningSender::isEnabled() const
+{
+    return enabled;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool DeadReckoningSender::loadTolerances(const std::string& path)
+{
+    const char* expected = "expected \"command tolerance\" or \"first-last tolerance\"";
+    std::vector<float> loaded(COMMAND_TABLE_SIZE, DEAD_RECKONING_DEFAULT_TOLERANCE);
+
+    CommandTableReader reader(path);
+    while (reader.nextLine())
+    {
+        const char* text = reader.getLine();
+        unsigned int first = 0;
+        unsigned int last = 0;
+        float tolerance = 0.0f;
+        if (!reader.readRange(text, COMMAND_TABLE_SIZE - 1, expected, first, last))
+            break;
+        if (sscanf(text, "%f", &tolerance) != 1)
+        {
+            reader.fail(expected);
+            break;
+        }
+
+        std::fill(loaded.begin() + first, loaded.begin() + last + 1, tolerance);
+    }
+
+    error = reader.getError();
+    if (!error.empty())
+        return false;
+
+    tolerances.swap(loaded);
+    clear();
+    return true;
+}
+
+void DeadReckoningSender::clearTolerances()
+{
+    tolerances.clear();
+    clear();
+}
+
+const std::string& DeadReckoningSender::getError() const
+{
+    return error;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void DeadReckoningSender::setCodecProfile(const CommandCodecProfile* codecProfile_)
+{
+    codecProfile = codecProfile_;
+    clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool DeadReckoningSender::update(unsigned short command, unsigned char compressionType, float value, bool& deadReckoned, float& valueRate,
+                                 float& sentValue, RakNet::Time currentTime)
+{
+    //profile codecs send the rate as FLOAT16
+    const CommandCodecSpec* spec = codecProfile ? codecProfile->find(command) : nullptr;
+    float quantized = spec ? spec->quantize(*spec, value) : quantizeCompressedValue(compressionType, value);
+    sentValue = quantized;
+
+    float tolerance = getTolerance(command);
+    if (!enabled || tolerance < 0.0f)
+        return true;
+
+    bool isNew = (trackIndex[command] == NO_DEAD_RECKONING_TRACK);
+    if (isNew)
+    {
+        trackIndex[command] = (uint16_t)tracks.size();
+        tracks.push_back(Track());
+        tracks.back().command = command;
+    }
+    Track& track = tracks[trackIndex[command]];
+
+    //the rate is measured from the start of the previous window, so it always spans at least one window
+    if (isNew)
+    {
+        track.windowValue = track.previousWindowValue = value;
+        track.windowTime = track.previousWindowTime = currentTime;
+    }
+    else if (currentTime - track.windowTime >= (RakNet::Time)DEAD_RECKONING_RATE_WINDOW_MS)
+    {
+        track.previousWindowValue = track.windowValue;
+        track.previousWindowTime = track.windowTime;
+        track.windowValue = value;
+        track.windowTime = currentTime;
+    }
+
+    bool withRate = spec ? spec->hasValueRate : hasValueRate(compressionType);
+    unsigned char rateType = spec ? (unsigned char)FLOAT16 : compressionType;
+
+    float rate = 0.0f;
+    if (withRate)
+    {
+        if (deadReckoned)
+            rate = valueRate;
+        else if (currentTime > track.previousWindowTime)
+            rate = (value - track.previousWindowValue) * 1000.0f / (float)(currentTime - track.previousWindowTime);
+    }
+    else
+    {
+        //stepped values are not extrapolated, any change is sent
+        tolerance = 0.0f;
+    }
+
+    if (!isNew && currentTime - track.sentTime < (RakNet::Time)DEAD_RECKONING_HEARTBEAT_MS)
+    {
+        float predicted = extrapolate(track.sentValue, track.sentRate, track.sentTime, currentTime);
+        if (fabsf(quantized - predicted) <= tolerance)
+        {
+            if (!track.hasSkipped)
+                numWithSkipped++;
+            track.hasSkipped = true;
+            track.skippedValue = value;
+            skipped++;
+            return false;
+        }
+    }
+
+    if (track.hasSkipped)
+        numWithSkipped--;
+    track.hasSkipped = false;
+
+    //what a receiver decodes, so both extrapolate alike
+    track.sentValue = quantized;
+    track.sentRate = withRate ? quantizeCompressedValueRate(rateType, rate) : 0.0f;
+    track.sentTime = currentTime;
+
+    deadReckoned = withRate;
+    valueRate = rate;
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void DeadReckoningSender::flush(RakNet::Time currentTime, std::vector<DeadReckoningSample>& flushed)
+{
+    if (numWithSkipped == 0)
+        return;
+
+    for (auto& track : tracks)
+    {
+        if (!track.hasSkipped || currentTime - track.sentTime < (RakNet::Time)DEAD_RECKONING_HEARTBEAT_MS)
+            continue;
+
+        DeadReckoningSample sample;
+        sample.command = track.command;
+        sample.value = track.skippedValue;
+        flushed.push_back(sample);
+
+        track.hasSkipped = false;
+        track.sentValue = track.skippedValue;
+        track.sentRate = 0.0f;
+        track.sentTime = currentTime;
+        numWithSkipped--;
+    }
+}
+
+void DeadReckoningSender::clear()
+{
+    numWithSkipped = 0;
+    tracks.clear();
+    std::fill(trackIndex.begin(), trackIndex.end(), NO_DEAD_RECKONING_TRACK);
+}
+
+unsigned int DeadReckoningSender::takeSkippedCount()
+{
+    unsigned int count = skipped;
+    skipped = 0;
+    return count;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+float DeadReckoningSender::getTolerance(unsigned short command) const
+{
+    const CommandCodecSpec* spec = codecProfile ? codecProfile->find(command) : nullptr;
+    if (spec && spec->deadband >= 0.0f)
+        return spec->deadband;
+
+    return tolerances.empty() ? DEAD_RECKONING_DEFAULT_TOLERANCE : tolerances[command];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+DeadReckoningReceiver::DeadReckoningReceiver() : trackIndex(COMMAND_TABLE_SIZE, NO_DEAD_RECKONING_TRACK)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void DeadReckoningReceiver::set(unsigned short command, float value, float valueRate, RakNet::Time currentTime)
+{
+    if (valueRate == 0.0f)
+    {
+        remove(command);
+        return;
+    }
+
+    if (trackIndex[command] == NO_DEAD_RECKONING_TRACK)
+    {
+        trackIndex[command] = (uint16_t)tracks.size();
+        tracks.push_back(Track());
+    }
+
+    Track& track = tracks[trackIndex[command]];
+    track.command = command;
+    track.value = value;
+    track.valueRate = valueRate;
+    track.time = currentTime;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void DeadReckoningReceiver::update(RakNet::Time currentTime, CommandValueSlots& values)
+{
+    if (tracks.empty() || currentTime - lastOutputTime < (RakNet::Time)DEAD_RECKONING_OUTPUT_INTERVAL_MS)
+        return;
+    lastOutputTime = currentTime;
+
+    size_t i = 0;
+    while (i < tracks.size())
+    {
+        const Track& track = tracks[i];
+        if (track.time == currentTime)
+        {
+            //just received, the value itself is already waiting
+            i++;
+            continue;
+        }
+
+        if (currentTime - track.time >= (RakNet::Time)DEAD_RECKONING_MAX_EXTRAPOLATION_MS)
+        {
+            //the sender went quiet, hold the value where the extrapolation ends
+            values.set(track.command, extrapolate(track.value, track.valueRate, track.time, track.time + DEAD_RECKONING_MAX_EXTRAPOLATION_MS), false, 0.0f);
+            remove(track.command);
+            continue;
+        }
+
+        values.set(track.command, extrapolate(track.value, track.valueRate, track.time, currentTime), false, 0.0f);
+        i++;
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool DeadReckoningReceiver::isExtrapolating() const
+{
+    return !tracks.empty();
+}
+
+void DeadReckoningReceiver::clear()
+{
+    for (const auto& track : tracks)
+        trackIndex[track.command] = NO_DEAD_RECKONING_TRACK;
+    tracks.clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void DeadReckoningReceiver::remove(unsigned short command)
+{
+    uint16_t index = trackIndex[command];
+    if (index == NO_DEAD_RECKONING_TRACK)
+        return;
+
+    //move the last track into the gap
+    tracks[index] = tracks.back();
+    trackIndex[tracks[index].command] = index;
+    tracks.pop_back();
+    trackIndex[command] = NO_DEAD_RECKONING_TRACK;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
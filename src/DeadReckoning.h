@@ -0,0 +1,208 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       DeadReckoning.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef DEADRECKONING_H
+#define DEADRECKONING_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RakNetTime.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const float DEAD_RECKONING_DEFAULT_TOLERANCE = 0.005f; //largest extrapolation error a receiver may show, in value units
+    static const int DEAD_RECKONING_HEARTBEAT_MS = 1000; //a value is sent at least this often while DCS reports it
+    static const int DEAD_RECKONING_RATE_WINDOW_MS = 20; //shortest interval a rate is estimated over
+    static const int DEAD_RECKONING_MAX_EXTRAPOLATION_MS = 2 * DEAD_RECKONING_HEARTBEAT_MS; //receivers hold the value after this
+    static const int DEAD_RECKONING_OUTPUT_INTERVAL_MS = 10; //how often receivers hand extrapolated values to DCS
+    static const uint16_t NO_DEAD_RECKONING_TRACK = 0xFFFF;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+class CommandCodecProfile;
+class CommandValueSlots;
+
+struct DeadReckoningSample
+{
+    unsigned short command = 0;
+    float value = 0.0f;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Decides which analog values from DCS are worth sending. It keeps, per
+command, the value and rate receivers were last sent and extrapolates them the
+way DeadReckoningReceiver does. A new value is only sent when it is further
+than the command's tolerance from that extrapolation, or when the last one is
+DEAD_RECKONING_HEARTBEAT_MS old.
+
+DCS may stop reporting a value, for example one it only sends on change. So
+that receivers do not go on extrapolating a rate it no longer has, flush() hands
+out the last skipped sample of every command nothing was sent for within the
+heartbeat, to be sent without a rate.
+
+Values of compression types with a rate (hasValueRate()) are sent with one: the
+aircraft's if it passed one, otherwise estimated from the samples over at least
+DEAD_RECKONING_RATE_WINDOW_MS. Other compression types are stepped, so they are
+sent when the decoded value changes.
+
+Tolerances default to DEAD_RECKONING_DEFAULT_TOLERANCE and can be set per
+command from a table file, one entry per line:
+
+    # command or first-last, then tolerance. A negative tolerance sends every sample.
+    2001-2003 0.01
+    2010 -1
+
+While the session uses a CommandCodecProfile, the commands it lists are
+quantized by their profile codec, and a deadband there replaces the tolerance.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class DeadReckoningSender
+{
+public:
+    /// Constructor
+    DeadReckoningSender();
+
+    ///When disabled every sample is sent as the aircraft passed it
+    void setEnabled(bool enabled_);
+    bool isEnabled() const;
+
+    ///Load per command tolerances. Returns false and keeps the current ones on error.
+    bool loadTolerances(const std::string& path);
+    ///Go back to DEAD_RECKONING_DEFAULT_TOLERANCE for every command
+    void clearTolerances();
+    const std::string& getError() const;
+
+    ///Profile the session encodes values with, nullptr for none. Clears what receivers were sent.
+    void setCodecProfile(const CommandCodecProfile* codecProfile_);
+
+    ///Returns true if this sample must be sent. valueRate is the rate to send it with, deadReckoned whether it has one,
+    ///and sentValue the value receivers decode from it.
+    bool update(unsigned short command, unsigned char compressionType, float value, bool& deadReckoned, float& valueRate,
+                float& sentValue, RakNet::Time currentTime);
+
+    ///Append the last skipped sample of every command that was not sent for DEAD_RECKONING_HEARTBEAT_MS to
+    ///flushed, and count it as sent without a rate. Call once per update, then send them.
+    void flush(RakNet::Time currentTime, std::vector<DeadReckoningSample>& flushed);
+
+    ///Forget what receivers were sent, the next sample of every command is sent
+    void clear();
+
+    ///Returns the number of samples skipped since the last call
+    unsigned int takeSkippedCount();
+
+private:
+    struct Track
+    {
+        unsigned short command = 0;
+        bool hasSkipped = false; //a sample came in after the last one sent
+        float skippedValue = 0.0f;
+        float sentValue = 0.0f;
+        float sentRate = 0.0f;
+        RakNet::Time sentTime = 0;
+        float windowValue = 0.0f; //first sample of the current rate window
+        RakNet::Time windowTime = 0;
+        float previousWindowValue = 0.0f; //first sample of the window before, the rate is measured from here
+        RakNet::Time previousWindowTime = 0;
+    };
+
+    float getTolerance(unsigned short command) const;
+
+    std::vector<Track> tracks;
+    std::vector<uint16_t> trackIndex; //per command ID, NO_DEAD_RECKONING_TRACK if none
+    std::vector<float> tolerances; //per command ID. Empty until loaded.
+    const CommandCodecProfile* codecProfile = nullptr;
+    std::string error;
+    unsigned int skipped = 0;
+    unsigned int numWithSkipped = 0; //tracks with hasSkipped set
+    bool enabled = true;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Extrapolates received analog values with their rate, so DCS gets a smooth
+value every DEAD_RECKONING_OUTPUT_INTERVAL_MS between the sparse updates a
+DeadReckoningSender lets through. A value without a rate, or with a zero rate,
+is passed on once and not extrapolated. Extrapolation stops after
+DEAD_RECKONING_MAX_EXTRAPOLATION_MS without an update, which only happens when
+the sender went away, as it sends a heartbeat well before that.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class DeadReckoningReceiver
+{
+public:
+    /// Constructor
+    DeadReckoningReceiver();
+
+    ///A value received from the copilots
+    void set(unsigned short command, float value, float valueRate, RakNet::Time currentTime);
+
+    ///Write the extrapolated value of every moving command into values, at most every DEAD_RECKONING_OUTPUT_INTERVAL_MS
+    void update(RakNet::Time currentTime, CommandValueSlots& values);
+
+    ///Returns true while any command is being extrapolated
+    bool isExtrapolating() const;
+
+    void clear();
+
+private:
+    struct Track
+    {
+        unsigned short command = 0;
+        float value = 0.0f;
+        float valueRate = 0.0f;
+        RakNet::Time time = 0;
+    };
+
+    void remove(unsigned short command);
+
+    std::vector<Track> tracks;
+    std::vector<uint16_t> trackIndex; //per command ID, NO_DEAD_RECKONING_TRACK if none
+    RakNet::Time lastOutputTime = 0;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // DEADRECKONING_H
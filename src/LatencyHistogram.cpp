@@ -0,0 +1,162 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       LatencyHistogram.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      LatencyHistogram Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Log-linear latency histogram.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+const uint64_t MAX_LATENCY_US = 0xFFFFFFFFull; //longer latencies (over an hour) are counted as this
+const unsigned int LINEAR_BITS = 10; //log2(LATENCY_HISTOGRAM_LINEAR_US)
+const unsigned int SUB_BUCKET_BITS = 9; //log2(LATENCY_HISTOGRAM_SUB_BUCKETS)
+const size_t NUM_BUCKETS = Network::LATENCY_HISTOGRAM_LINEAR_US + (32 - LINEAR_BITS) * Network::LATENCY_HISTOGRAM_SUB_BUCKETS;
+
+static_assert((1u << LINEAR_BITS) == Network::LATENCY_HISTOGRAM_LINEAR_US, "LINEAR_BITS");
+static_assert((1u << SUB_BUCKET_BITS) == Network::LATENCY_HISTOGRAM_SUB_BUCKETS, "SUB_BUCKET_BITS");
+
+inline unsigned int mostSignificantBit(uint64_t value)
+{
+    unsigned int bit = 0;
+    while (value >>= 1)
+        bit++;
+    return bit;
+}
+
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+LatencyHistogram::LatencyHistogram() : buckets(NUM_BUCKETS, 0)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+size_t LatencyHistogram::bucketIndex(uint64_t latencyUS)
+{
+    if (latencyUS < LATENCY_HISTOGRAM_LINEAR_US)
+        return (size_t)latencyUS;
+
+    //keep the top SUB_BUCKET_BITS + 1 bits: [512, 1023] after the shift
+    unsigned int shift = mostSignificantBit(latencyUS) - SUB_BUCKET_BITS;
+    size_t subBucket = (size_t)(latencyUS >> shift) - LATENCY_HISTOGRAM_SUB_BUCKETS;
+    return LATENCY_HISTOGRAM_LINEAR_US + (shift - 1) * LATENCY_HISTOGRAM_SUB_BUCKETS + subBucket;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+uint64_t LatencyHistogram::bucketValue(size_t index)
+{
+    if (index < LATENCY_HISTOGRAM_LINEAR_US)
+        return index;
+
+    //middle of the bucket
+    unsigned int shift = (unsigned int)((index - LATENCY_HISTOGRAM_LINEAR_US) / LATENCY_HISTOGRAM_SUB_BUCKETS) + 1;
+    uint64_t subBucket = (index - LATENCY_HISTOGRAM_LINEAR_US) % LATENCY_HISTOGRAM_SUB_BUCKETS + LATENCY_HISTOGRAM_SUB_BUCKETS;
+    return (subBucket << shift) + ((1ull << shift) >> 1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void LatencyHistogram::add(uint64_t latencyUS)
+{
+    latencyUS = std::min(latencyUS, MAX_LATENCY_US);
+
+    buckets[bucketIndex(latencyUS)]++;
+    count++;
+    sumUS += latencyUS;
+    minUS = std::min(minUS, latencyUS);
+    maxUS = std::max(maxUS, latencyUS);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void LatencyHistogram::add(const LatencyHistogram& other)
+{
+    for (size_t i = 0; i < NUM_BUCKETS; i++)
+        buckets[i] += other.buckets[i];
+
+    count += other.count;
+    sumUS += other.sumUS;
+    minUS = std::min(minUS, other.minUS);
+    maxUS = std::max(maxUS, other.maxUS);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void LatencyHistogram::clear()
+{
+    std::fill(buckets.begin(), buckets.end(), 0);
+    count = 0;
+    sumUS = 0;
+    minUS = UINT64_MAX;
+    maxUS = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return count;
+}
+
+uint64_t LatencyHistogram::getMinUS() const
+{
+    return (count > 0) ? minUS : 0;
+}
+
+uint64_t LatencyHistogram::getMaxUS() const
+{
+    return maxUS;
+}
+
+double LatencyHistogram::getMeanUS() const
+{
+    return (count > 0) ? (double)sumUS / (double)count : 0.0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+uint64_t LatencyHistogram::getPercentileUS(double fraction) const
+{
+    if (count == 0)
+        return 0;
+
+    fraction = std::min(std::max(fraction, 0.0), 1.0);
+    uint64_t rank = std::max((uint64_t)1, (uint64_t)(fraction * (double)count + 0.5));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; i++)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+            return std::min(std::max(bucketValue(i), minUS), maxUS);
+    }
+
+    return maxUS;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
@@ -0,0 +1,93 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       LatencyHistogram.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const unsigned int LATENCY_HISTOGRAM_LINEAR_US = 1024; //exact below this, then 1/512 relative precision
+    static const unsigned int LATENCY_HISTOGRAM_SUB_BUCKETS = 512;
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Fixed size histogram of latencies in microseconds, for percentiles over
+millions of samples without storing them.
+
+Buckets are 1 us wide up to LATENCY_HISTOGRAM_LINEAR_US, then each power of two
+is split into LATENCY_HISTOGRAM_SUB_BUCKETS buckets, so a percentile is within
+0.2% of the true value. add() is a few shifts and an increment and never allocates.
+
+Not thread safe. Merge per thread histograms with add(const LatencyHistogram&).
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class LatencyHistogram
+{
+public:
+    /// Constructor
+    LatencyHistogram();
+
+    ///Record one latency
+    void add(uint64_t latencyUS);
+
+    ///Merge another histogram into this one
+    void add(const LatencyHistogram& other);
+
+    void clear();
+
+    uint64_t getCount() const;
+    uint64_t getMinUS() const;
+    uint64_t getMaxUS() const;
+    double getMeanUS() const;
+
+    ///Latency below which the given fraction (0.0 to 1.0) of the samples lie. 0 if empty.
+    uint64_t getPercentileUS(double fraction) const;
+
+private:
+    static size_t bucketIndex(uint64_t latencyUS);
+    static uint64_t bucketValue(size_t index);
+
+    std::vector<uint64_t> buckets;
+    uint64_t count = 0;
+    uint64_t sumUS = 0;
+    uint64_t minUS = UINT64_MAX;
+    uint64_t maxUS = 0;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // LATENCYHISTOGRAM_H
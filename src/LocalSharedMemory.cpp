@@ -0,0 +1,187 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       LocalSharedMemory.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      LocalSharedMemory and SharedSignaledEvent Classes
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Copilot side of the shared memory link to the DCS aircraft.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+A block left behind by a copilot that crashed is reused and cleared. An aircraft
+still holding the old block sees the magic cleared by destroy() and reopens.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "LocalSharedMemory.h"
+
+//after the RakNet headers, which bring winsock2.h before windows.h
+#include "DcsShm.h"
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+LocalSharedMemory::LocalSharedMemory()
+{
+    shm = new DcsShm;
+    dcsShmInit(shm);
+    buffer.resize(DCS_SHM_MAX_MESSAGE_SIZE);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+LocalSharedMemory::~LocalSharedMemory()
+{
+    destroy();
+    delete shm;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool LocalSharedMemory::create()
+{
+    if (isCreated())
+        return true;
+
+    if (!dcsShmMap(shm, 1))
+        return false;
+
+    DcsShmLayout* layout = shm->layout;
+    dcsShmStore(&layout->magic, 0u);
+    memset((void*)layout, 0, sizeof(DcsShmLayout));
+    layout->version = DCS_SHM_VERSION;
+    dcsShmStore(&layout->magic, DCS_SHM_MAGIC);
+
+    dcsAttached = false;
+    dcsSession = 0;
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void LocalSharedMemory::destroy()
+{
+    if (!isCreated())
+        return;
+
+    dcsShmStore(&shm->layout->magic, 0u);
+    dcsShmUnmap(shm);
+#if !defined(_WIN32)
+    //Windows removes the mapping with its last handle
+    shm_unlink(DCS_SHM_NAME);
+#endif
+
+    dcsAttached = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool LocalSharedMemory::isCreated() const
+{
+    return dcsShmIsOpen(shm) != 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+LocalSharedMemoryChange LocalSharedMemory::update(RakNet::Time currentTime)
+{
+    if (!isCreated())
+        return SHARED_MEMORY_NO_CHANGE;
+
+    DcsShmLayout* layout = shm->layout;
+    dcsShmStore(&layout->copilotHeartbeat, layout->copilotHeartbeat + 1u);
+
+    bool attached = dcsShmLoad(&layout->dcsAttached) != 0;
+    uint32_t session = dcsShmLoad(&layout->dcsSession);
+    uint32_t heartbeat = dcsShmLoad(&layout->dcsHeartbeat);
+
+    if (attached && session != dcsSession)
+    {
+        //also an aircraft that reattached between two loops
+        dcsSession = session;
+        dcsAttached = true;
+        dcsHeartbeat = heartbeat;
+        dcsHeartbeatTime = currentTime;
+        return SHARED_MEMORY_DCS_ATTACHED;
+    }
+
+    if (!dcsAttached)
+        return SHARED_MEMORY_NO_CHANGE;
+
+    if (!attached)
+    {
+        dcsAttached = false;
+        return SHARED_MEMORY_DCS_DETACHED;
+    }
+
+    if (heartbeat != dcsHeartbeat)
+    {
+        dcsHeartbeat = heartbeat;
+        dcsHeartbeatTime = currentTime;
+    }
+    else if (currentTime - dcsHeartbeatTime > (RakNet::Time)DCS_SHM_TIMEOUT_MS)
+    {
+        dcsAttached = false;
+        return SHARED_MEMORY_DCS_LOST;
+    }
+
+    return SHARED_MEMORY_NO_CHANGE;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool LocalSharedMemory::isDcsAttached() const
+{
+    return dcsAttached;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool LocalSharedMemory::read(const unsigned char*& data, unsigned int& length)
+{
+    if (!isCreated())
+        return false;
+
+    length = dcsShmRead(&shm->layout->toCopilot, &buffer[0], (uint32_t)buffer.size());
+    data = &buffer[0];
+    return length > 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool LocalSharedMemory::write(const unsigned char* data, unsigned int length)
+{
+    if (!dcsAttached)
+        return false;
+
+    return dcsShmWrite(&shm->layout->toDcs, data, length) != 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void SharedSignaledEvent::InitSharedEvent()
+{
+#if defined(_WIN32)
+    //auto-reset like InitEvent(), opened instead of created if the aircraft got there first
+    eventList = CreateEventA(NULL, FALSE, FALSE, DCS_SHM_WAKE_EVENT_NAME);
+    if (eventList == NULL)
+        InitEvent();
+#else
+    InitEvent();
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
@@ -0,0 +1,140 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       LocalSharedMemory.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef LOCALSHAREDMEMORY_H
+#define LOCALSHAREDMEMORY_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstdint>
+#include <vector>
+
+#include "RakNetTime.h"
+#include "SignaledEvent.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+#if defined(_WIN32)
+    static const bool LOCAL_SHARED_MEMORY_WAKES = true; //the aircraft sets the network thread's wake event by name
+#else
+    static const bool LOCAL_SHARED_MEMORY_WAKES = false; //no cross-process wake, the network thread polls
+#endif
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+struct DcsShm;
+
+namespace Network {
+
+enum LocalSharedMemoryChange
+{
+    SHARED_MEMORY_NO_CHANGE = 0,
+    SHARED_MEMORY_DCS_ATTACHED,
+    SHARED_MEMORY_DCS_DETACHED, //closed the link
+    SHARED_MEMORY_DCS_LOST, //stopped signaling for DCS_SHM_TIMEOUT_MS
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Copilot side of the shared memory link to the aircraft (see DcsShm.h).
+Creates the named block, reads the messages DCS queued and queues the ones for
+DCS, and follows the aircraft attaching, detaching and going quiet.
+
+Network thread only.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class LocalSharedMemory
+{
+public:
+    /// Constructor
+    LocalSharedMemory();
+    /// Destructor. Removes the block.
+    ~LocalSharedMemory();
+
+    ///Create the block and its rings. Returns false if it could not be created.
+    bool create();
+
+    ///Tell the aircraft the listener stopped and remove the block
+    void destroy();
+
+    bool isCreated() const;
+
+    ///Heartbeat and attach check, once per loop. Returns what changed since the last call.
+    LocalSharedMemoryChange update(RakNet::Time currentTime);
+
+    bool isDcsAttached() const;
+
+    ///Returns the next message from DCS, or false if there is none. data stays valid until the next call.
+    bool read(const unsigned char*& data, unsigned int& length);
+
+    ///Queue a message for DCS. Returns false if not attached or the ring is full.
+    bool write(const unsigned char* data, unsigned int length);
+
+private:
+    DcsShm* shm;
+    std::vector<unsigned char> buffer;
+
+    bool dcsAttached = false;
+    uint32_t dcsSession = 0;
+    uint32_t dcsHeartbeat = 0;
+    RakNet::Time dcsHeartbeatTime = 0;
+
+    // Make this object be noncopyable because it holds a mapping
+    LocalSharedMemory(const LocalSharedMemory&);
+    const LocalSharedMemory &operator =(const LocalSharedMemory &);
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** SignaledEvent that the aircraft can also set, by DCS_SHM_WAKE_EVENT_NAME, so
+the network thread wakes for shared memory messages like it does for packets.
+Only on Windows (LOCAL_SHARED_MEMORY_WAKES). Elsewhere it is a plain
+SignaledEvent.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class SharedSignaledEvent : public RakNet::SignaledEvent
+{
+public:
+    ///InitEvent() for the event the aircraft sets by name
+    void InitSharedEvent();
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // LOCALSHAREDMEMORY_H
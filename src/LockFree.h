@@ -0,0 +1,147 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       LockFree.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef LOCKFREE_H
+#define LOCKFREE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const size_t CACHE_LINE_SIZE = 64;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Lock-free containers used to hand data between the network thread and the
+GUI thread without either side ever blocking on the other.
+
+SpscQueue is a bounded single-producer/single-consumer ring. Capacity must be a
+power of two and all slots are allocated up front.
+
+TripleBuffer holds the latest value of a struct written by one thread and read
+by another. The writer never waits and the reader only ever sees complete values,
+intermediate values are silently dropped (latest value wins).
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue() : buffer(Capacity) {}
+
+    ///Producer only. Returns false (and drops the item) if the queue is full.
+    bool push(T item)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= Capacity)
+            return false;
+
+        buffer[t & (Capacity - 1)] = std::move(item);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    ///Consumer only. Returns false if there is nothing to read.
+    bool pop(T& item)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+
+        item = std::move(buffer[h & (Capacity - 1)]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    ///Approximate when called from neither side.
+    bool empty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{0};
+    alignas(CACHE_LINE_SIZE) std::vector<T> buffer;
+
+    SpscQueue(const SpscQueue&);
+    const SpscQueue &operator =(const SpscQueue &);
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() {}
+
+    ///Writer only. Publishes a new value, replacing any value not yet read.
+    void write(const T& value)
+    {
+        buffers[back] = value;
+        back = middle.exchange(back | DIRTY_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    ///Reader only. Returns false if nothing new was written since the last read.
+    bool read(T& value)
+    {
+        if ((middle.load(std::memory_order_relaxed) & DIRTY_BIT) == 0)
+            return false;
+
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        value = buffers[front];
+        return true;
+    }
+
+private:
+    static const unsigned DIRTY_BIT = 4;
+    static const unsigned INDEX_MASK = 3;
+
+    T buffers[3];
+    unsigned back = 0; //writer owned
+    unsigned front = 1; //reader owned
+    alignas(CACHE_LINE_SIZE) std::atomic<unsigned> middle{2};
+
+    TripleBuffer(const TripleBuffer&);
+    const TripleBuffer &operator =(const TripleBuffer &);
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // LOCKFREE_H
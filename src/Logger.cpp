@@ -0,0 +1,274 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       Logger.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      Logger Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Lock-free log ring for the network thread, drained in batches to the GUI, the
+console and an optional log file.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+The producer never signals the consumer, which would cost a system call per
+line. The consumer wakes on its own every LOG_FLUSH_INTERVAL_MS instead.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstring>
+#include <iostream>
+
+#include "UiChannel.h"
+
+#include <QDateTime>
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+inline int64_t currentTimeMS()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+const char* levelPrefix(unsigned char level)
+{
+    switch (level)
+    {
+        case Network::LOG_WARNING:
+            return "Warning: ";
+        case Network::LOG_ERROR:
+            return "Error: ";
+        default:
+            return "";
+    }
+}
+
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+Logger::Logger(UiChannel* uiChannel_) : uiChannel(uiChannel_)
+{
+    wakeEvent.InitEvent();
+
+    for (int i = 0; i < NUM_LOG_CATEGORIES; i++)
+    {
+        levels[i] = LOG_INFO;
+        windowStartMS[i] = 0;
+        linesInWindow[i] = 0;
+        suppressedLines[i] = 0;
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Logger::~Logger()
+{
+    stop();
+    setLogFile(std::string());
+    wakeEvent.CloseEvent();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Logger::write(LogLevel level, LogCategory category, const char* format, ...)
+{
+    if (!isEnabled(level, category))
+        return;
+
+    char text[LOG_LINE_LENGTH];
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, LOG_LINE_LENGTH, format, args);
+    va_end(args);
+
+    if (length < 0)
+        return;
+
+    push(level, category, text, std::min((size_t)length, LOG_LINE_LENGTH - 1));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Logger::write(LogLevel level, LogCategory category, const QString& text)
+{
+    if (!isEnabled(level, category))
+        return;
+
+    QByteArray utf8 = text.toUtf8();
+    push(level, category, utf8.constData(), std::min((size_t)utf8.size(), LOG_LINE_LENGTH - 1));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Logger::setLevel(LogCategory category, LogLevel level)
+{
+    if (category < NUM_LOG_CATEGORIES)
+        levels[category].store(level, std::memory_order_relaxed);
+}
+
+void Logger::setLevel(LogLevel level)
+{
+    for (int i = 0; i < NUM_LOG_CATEGORIES; i++)
+        levels[i].store(level, std::memory_order_relaxed);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool Logger::setLogFile(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+
+    if (file != nullptr)
+    {
+        fclose(file);
+        file = nullptr;
+    }
+
+    if (path.empty())
+        return true;
+
+    file = fopen(path.c_str(), "a");
+    return file != nullptr;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Logger::stop()
+{
+    stopRequested = true;
+    wakeEvent.SetEvent();
+    wait();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int Logger::getDroppedLineCount() const
+{
+    return droppedLines.load(std::memory_order_relaxed);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Logger::push(LogLevel level, LogCategory category, const char* text, size_t length)
+{
+    int64_t timeMS = currentTimeMS();
+    if (!checkRateLimit(category, timeMS))
+        return;
+
+    LogRecord record;
+    record.timeMS = timeMS;
+    record.level = (unsigned char)level;
+    record.category = (unsigned char)category;
+    memcpy(record.text, text, length);
+    record.text[length] = '\0';
+
+    if (!records.push(record))
+        droppedLines.fetch_add(1, std::memory_order_relaxed);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool Logger::checkRateLimit(LogCategory category, int64_t timeMS)
+{
+    if (timeMS - windowStartMS[category] >= LOG_RATE_LIMIT_WINDOW_MS)
+    {
+        windowStartMS[category] = timeMS;
+        linesInWindow[category] = 0;
+
+        if (suppressedLines[category] > 0)
+        {
+            LogRecord record;
+            record.timeMS = timeMS;
+            record.level = LOG_WARNING;
+            record.category = (unsigned char)category;
+            snprintf(record.text, LOG_LINE_LENGTH, "%d similar lines suppressed", suppressedLines[category]);
+            suppressedLines[category] = 0;
+
+            if (!records.push(record))
+                droppedLines.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (linesInWindow[category] >= LOG_RATE_LIMIT_LINES)
+    {
+        suppressedLines[category]++;
+        return false;
+    }
+
+    linesInWindow[category]++;
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Logger::flush()
+{
+    QString batch;
+
+    LogRecord record;
+    while (records.pop(record))
+    {
+        QString line = QDateTime::fromMSecsSinceEpoch(record.timeMS).toString("hh:mm:ss") + "   "
+                + levelPrefix(record.level) + QString::fromUtf8(record.text);
+
+        if (!batch.isEmpty())
+            batch += '\n';
+        batch += line;
+    }
+
+    if (batch.isEmpty())
+        return;
+
+    std::string text = batch.toStdString();
+    std::cout << text << '\n';
+    std::cout.flush();
+
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (file != nullptr)
+        {
+            fputs(text.c_str(), file);
+            fputc('\n', file);
+            fflush(file);
+        }
+    }
+
+    uiChannel->logBatch(batch);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Logger::run()
+{
+    while (!stopRequested)
+    {
+        wakeEvent.WaitOnEvent(LOG_FLUSH_INTERVAL_MS);
+        flush();
+    }
+
+    //lines written right before the stop
+    flush();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
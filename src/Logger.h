@@ -0,0 +1,186 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       Logger.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+#include "LockFree.h"
+
+#include "SignaledEvent.h"
+
+#include <QString>
+#include <QThread>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const size_t LOG_QUEUE_SIZE = 4096;
+    static const size_t LOG_LINE_LENGTH = 244; //longer lines are cut, keeps a record at four cache lines
+    static const int LOG_FLUSH_INTERVAL_MS = 100; //how often queued lines go to the GUI and the log file
+    static const int LOG_RATE_LIMIT_LINES = 50; //per category and second, further lines are counted and dropped
+    static const int LOG_RATE_LIMIT_WINDOW_MS = 1000;
+}
+
+///Log a line only if its level is enabled for the category. The arguments are
+///not evaluated otherwise, so filtered lines on the packet path cost one load and compare.
+#define NETWORK_LOG(logger, level, category, ...) \
+    do { \
+        if ((logger) != nullptr && (logger)->isEnabled((level), (category))) \
+            (logger)->write((level), (category), __VA_ARGS__); \
+    } while (0)
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+class UiChannel;
+
+enum LogLevel
+{
+    LOG_DEBUG = 0,
+    LOG_INFO,
+    LOG_WARNING,
+    LOG_ERROR,
+    LOG_NONE, //as a threshold, turns a category off
+};
+
+enum LogCategory
+{
+    LOG_GENERAL = 0,
+    LOG_COMMANDS, //every command and value, from DCS and from the network
+    LOG_EVENTS,
+    LOG_SYNC, //master sync
+    NUM_LOG_CATEGORIES
+};
+
+struct LogRecord
+{
+    int64_t timeMS = 0; //since the epoch
+    unsigned char level = LOG_INFO;
+    unsigned char category = LOG_GENERAL;
+    char text[LOG_LINE_LENGTH];
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Log for the network thread that never blocks it.
+
+write() formats into a fixed size record in a preallocated ring and returns.
+Timestamps are formatted, lines are joined and handed to the GUI (and the log
+file, if one is set) in batches on this object's own thread, every
+LOG_FLUSH_INTERVAL_MS.
+
+Each category has its own level threshold, which the GUI may change at any time,
+and its own rate limit. Lines over the limit are dropped and reported as a count
+once the window ends, so a burst of packets cannot flood the ring.
+
+write() is for the network thread only (single producer).
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class Logger : public QThread
+{
+    Q_OBJECT
+
+public:
+    /// Constructor
+    Logger(UiChannel* uiChannel_);
+    /// Destructor. Stops the thread if it is still running.
+    ~Logger();
+
+    ///Returns true if lines of this level are kept for the category
+    inline bool isEnabled(LogLevel level, LogCategory category) const
+    {
+        return (int)level >= levels[category].load(std::memory_order_relaxed);
+    }
+
+    ///Queue a printf style line. Network thread only.
+    void write(LogLevel level, LogCategory category, const char* format, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 4, 5)))
+#endif
+        ;
+
+    ///Queue a line. Network thread only.
+    void write(LogLevel level, LogCategory category, const QString& text);
+
+    ///Set the lowest level kept for one category, or for all of them
+    void setLevel(LogCategory category, LogLevel level);
+    void setLevel(LogLevel level);
+
+    ///Append every line to the given file as well. An empty path closes the file.
+    ///Returns false if the file could not be opened.
+    bool setLogFile(const std::string& path);
+
+    ///Write out what is queued and end the thread
+    void stop();
+
+    ///Number of lines dropped because the ring was full
+    unsigned int getDroppedLineCount() const;
+
+protected:
+    void run() override;
+
+private:
+    void push(LogLevel level, LogCategory category, const char* text, size_t length);
+    bool checkRateLimit(LogCategory category, int64_t timeMS);
+    void flush();
+
+    UiChannel* uiChannel = nullptr;
+
+    SpscQueue<LogRecord, LOG_QUEUE_SIZE> records;
+    std::atomic<int> levels[NUM_LOG_CATEGORIES];
+    std::atomic<unsigned int> droppedLines{0};
+    std::atomic<bool> stopRequested{false};
+    RakNet::SignaledEvent wakeEvent;
+
+    //producer side rate limiting
+    int64_t windowStartMS[NUM_LOG_CATEGORIES];
+    int linesInWindow[NUM_LOG_CATEGORIES];
+    int suppressedLines[NUM_LOG_CATEGORIES];
+
+    //consumer side
+    std::mutex fileMutex;
+    FILE* file = nullptr;
+
+    // Make this object be noncopyable because it holds pointers
+    Logger(const Logger&);
+    const Logger &operator =(const Logger &);
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // LOGGER_H
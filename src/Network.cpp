@@ -26,16 +26,33 @@ INCLUDES
 
 #include <string>
 #include <map>
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <memory>
 
 #include "RakPeerInterface.h"
 #include "RakNetStatistics.h"
 #include "MessageIdentifiers.h"
 #include "BitStream.h"
 #include "GetTime.h"
-
-#include "mainwindow.h"
+#include "TickScheduler.h"
+
+#include "AnimationStream.h"
+#include "ClientInfo.h"
+#include "CommandBatch.h"
+#include "CommandCodec.h"
+#include "CommandCodecProfile.h"
+#include "CommandLatency.h"
+#include "CommandStateTable.h"
+#include "DeadReckoning.h"
+#include "Logger.h"
+#include "OrderingChannels.h"
+#include "PacketTrace.h"
+#include "SeatInterest.h"
+#include "SessionRecorder.h"
+#include "StatisticsSampler.h"
+#include "UiChannel.h"
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
@@ -63,6 +80,8 @@ enum CustomNetworkMessages
     ID_NET_EXTERNAL_ANIMATION_CORRECTION,
     ID_NET_COCKPIT_ANIMATION,
     ID_NET_COCKPIT_ANIMATION_CORRECTION,
+    ID_NET_COMMAND_BATCH,
+    ID_NET_CODEC_PROFILE,
 };
 
 namespace Network {
@@ -71,8 +90,6 @@ namespace Network {
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
-const float Network::maxValueRate = 100.0f;
-
 class Network::Impl
 {
 public:
@@ -85,10 +102,10 @@ public:
         peer->SetOccasionalPing(true);
         myGUID = peer->GetMyGUID();
 
-        hostClientIndexList.fill(RakNet::UNASSIGNED_RAKNET_GUID);
         currentTime = RakNet::GetTime();
-        pingTimeCtr = currentTime;
         hostPingTimeCtr = currentTime;
+        masterSyncTimeCtr = currentTime;
+        commandLatencyTimeCtr = currentTime;
         myStatistics = new RakNet::RakNetStatistics;
     }
 
@@ -108,48 +125,107 @@ public:
         isHost = false;
         serverGUID = RakNet::UNASSIGNED_RAKNET_GUID;
 
-        clientNameMap.clear();
-        clientMap.clear();
-        clientInfoList.clear();
-
-        for (int i = 0; i < MAX_CLIENTS; i++) {
-            hostClientIndexList[i] = RakNet::UNASSIGNED_RAKNET_GUID;
+        clientTable.clear();
+        clientInfo.clear();
+        commandBatches.clear();
+        commandState.clear();
+        changedSinceSyncRequest.reset();
+        for (auto& view : seatViews)
+            view.reset();
+        for (auto& otherCrew : crews)
+            otherCrew.reset();
+        myCrew = crewSetting;
+        packetCrew = myCrew;
+        statisticsSampler.clear();
+        setSessionCodecProfile(0);
+
+        for (int i = 0; i < NUM_ANIMATION_TYPES; i++)
+        {
+            animationSenders[i].reset();
+            animationReceivers[i].clear();
+            animationOwners[i].clear();
         }
     }
 
     //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-    //remove the given client from lists and return the client's name
-    std::string removeClient(RakNet::RakNetGUID guid)
+    //remove the client in the given slot and return the client's name
+    RakNet::RakString removeClient(int slot)
     {
+        RakNet::RakString clientName = "Unknown Client";
+        if (clientTable.isUsed(slot))
         {
-            auto it = clientMap.find(guid);
-            if (it != clientMap.end()) {
-                //client found in list, so remove
-                clientMap.erase(it);
-            }
-        }
-        std::string clientNameStr = "Unknown Client";
-        {
-            auto it = clientNameMap.find(guid);
-            if (it != clientNameMap.end()) {
-                //client found in list, so remove
-                clientNameStr = it->second;
-                clientNameMap.erase(it);
-            }
+            clientName = clientTable.get(slot).name;
+            clientTable.remove(slot);
+            clientInfo.removeSlot(slot);
+            seatViews[slot].reset();
         }
 
-        return clientNameStr;
+        return clientName;
+    }
+
+    //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+    //clients do not know the host's system indices, so everyone else goes in the first free slot
+    int addRemoteClient(const RakNet::RakNetGUID& guid)
+    {
+        int slot = clientTable.findSlot(guid);
+        if (slot < 0)
+            slot = clientTable.getFreeSlot();
+        if (slot >= 0)
+            clientTable.add(slot, guid);
+        return slot;
+    }
+
+    //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+    //fingerprint of the profile every seat announced, 0 if they differ
+    void setSessionCodecProfile(uint32_t fingerprint)
+    {
+        sessionCodecProfile = fingerprint;
+        deadReckoning.setCodecProfile(useCodecProfile() ? &codecProfile : nullptr);
+    }
+
+    bool useCodecProfile() const
+    {
+        return sessionCodecProfile != 0 && sessionCodecProfile == codecProfile.getFingerprint();
     }
 
     //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-    void addClient(Client client)
+    //host only, the state of a crew other than mine, created when first used. nullptr for mine or no crew.
+    struct Crew;
+    Crew* getOtherCrew(int crew)
+    {
+        if (crew < 0 || crew >= MAX_CREWS || crew == myCrew)
+            return nullptr;
+        if (!crews[crew])
+            crews[crew].reset(new Crew);
+        return crews[crew].get();
+    }
+
+    //command state of a crew, nullptr for no crew
+    CommandStateTable* getCommandState(int crew)
     {
-        clientMap.insert(std::pair<RakNet::RakNetGUID, Client>(client.ID, client));
+        if (crew == myCrew)
+            return &commandState;
+        Crew* otherCrew = getOtherCrew(crew);
+        return otherCrew ? &otherCrew->commandState : nullptr;
+    }
+
+    //seat owning each animation argument in a crew, nullptr for no crew
+    std::map<unsigned short, int>* getAnimationOwners(int crew, unsigned char animationType)
+    {
+        if (crew == myCrew)
+            return &animationOwners[animationType];
+        Crew* otherCrew = getOtherCrew(crew);
+        return otherCrew ? &otherCrew->animationOwners[animationType] : nullptr;
+    }
 
-        if (client.name != "Unknown Client")
-            clientNameMap.insert(std::pair<RakNet::RakNetGUID, std::string>(client.ID, std::string(client.name.C_String())));
+    //whether the packet being handled is for my aircraft, which on the host is only true for my crew
+    bool fromMyCrew() const
+    {
+        return !isHost || packetCrew == myCrew;
     }
 
     //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -164,7 +240,6 @@ public:
 
     bool isAttemptingConnection = false;
     bool isHost = false;
-    bool statisticsUpdated = false;
     RakNet::RakNetGUID myGUID = RakNet::UNASSIGNED_RAKNET_GUID;
     int mySeat = 0;
     int myPing = -1;
@@ -174,38 +249,112 @@ public:
     std::string client_name = "UnknownClient";
     unsigned long long max_outgoing_speed_per_connection = 256 * 1024; //256kbps
 
-    RakNet::Time pingTimeCtr;
     RakNet::Time hostPingTimeCtr;
+    RakNet::Time masterSyncTimeCtr;
+    RakNet::Time commandLatencyTimeCtr;
     RakNet::Time currentTime;
     RakNet::Time serverStartTime;
-    unsigned short lastClientIndexUpdated = MAX_CLIENTS - 1;
 
     ConnectionState lastStatus = IS_NOT_CONNECTED;
     ConnectionState currentStatus = IS_NOT_CONNECTED;
 
     double modelTime = 0;
 
-    //live information about the connected server and its clients
-    std::map<RakNet::RakNetGUID, std::string> clientNameMap;
-    std::map<RakNet::RakNetGUID, Client> clientMap;
-    std::vector<ClientInfo> clientInfoList; //updated for each client in ID_NET_CLIENT_INFO packet
+    //live information about the connected server and its clients. On the host a client's slot is its RakNet system index,
+    //so the client can still be found from a packet of an already disconnected one.
+    static const int LOCAL_SLOT = MAX_CLIENTS;
+    ClientTable clientTable{MAX_CLIENTS + 1, MAX_CLIENTS + 2, MAX_CREWS};
+    //host only, the pings each remote client has yet to be told
+    ClientInfoTracker clientInfo{MAX_CLIENTS};
+
+    //commands from DCS waiting for the end of update(), one batch per priority/reliability/ordering channel
+    std::vector<CommandBatch> commandBatches;
+
+    //latest value of every command in the session, authoritative on the host
+    CommandStateTable commandState;
+    //client only, commands set since the last master sync hash request, which a sync reply must not roll back
+    std::bitset<65536> changedSinceSyncRequest;
+
+    //one stream per AnimationType for my seat, and one per AnimationType and remote seat
+    std::array<AnimationSender, NUM_ANIMATION_TYPES> animationSenders;
+    std::array<std::map<int, AnimationReceiver>, NUM_ANIMATION_TYPES> animationReceivers;
+    //host only, seat owning each animation argument
+    std::array<std::map<unsigned short, int>, NUM_ANIMATION_TYPES> animationOwners;
+    std::vector<AnimationArgument> animationArguments; //reused between frames
+    std::vector<AnimationArgument> changedAnimationArguments; //reused between frames
+
+    //one-way latency of received commands, kept after a disconnect so the last session can be exported
+    CommandLatency commandLatency;
+    std::vector<CommandLatencySummary> commandLatencySummary; //reused between GUI updates
+    //command stamp of the packet being handled. The stamped packet is what a relay forwards.
+    RakNet::Packet* stampedPacket = nullptr;
+    RakNet::Time stampIngressTime = 0;
+    int stampSeat = 0;
+
+    //analog values from DCS are only sent when receivers' extrapolation of the last one is off
+    DeadReckoningSender deadReckoning;
+    std::vector<DeadReckoningSample> deadReckoningFlushed; //reused between updates
+
+    //per command value codecs, used in batches while the whole session loaded the same profile
+    CommandCodecProfile codecProfile;
+    uint32_t sessionCodecProfile = 0;
+
+    //a host serves several crews over the one peer, each with its own seats, command state and relay set.
+    //The fields above are my crew's, the others are kept here.
+    struct Crew
+    {
+        CommandStateTable commandState;
+        std::array<std::map<unsigned short, int>, NUM_ANIMATION_TYPES> animationOwners;
+        uint32_t sessionCodecProfile = 0;
+    };
+    std::array<std::unique_ptr<Crew>, MAX_CREWS> crews;
+    int crewSetting = 0; //used from the next session
+    int myCrew = 0;
+    int packetCrew = 0; //host only, crew of the sender of the packet being handled, mine outside the receive loop
+
+    int updateWorkers = 0; //host only, used from the next session
+
+    //commands and events my seat consumes, sent with seat requests
+    SeatInterest myInterest;
+    //host only, the interest and command state of every seat that does not want everything, by client slot
+    struct SeatView
+    {
+        SeatInterest interest;
+        CommandStateTable commandState;
+    };
+    std::array<std::unique_ptr<SeatView>, MAX_CLIENTS + 1> seatViews;
+    unsigned int interestSkipped = 0; //sends left out since the last statistics update
+
+    //connection statistics, read a few times a second for the GUI
+    StatisticsSampler statisticsSampler;
+    std::vector<StatisticsSample> statisticsHistory; //reused between samples
 
-    //special for host so that GUID can be determined from an already disconnected client
-    std::array<RakNet::RakNetGUID, MAX_CLIENTS> hostClientIndexList;
+    //ordering channel of every command from DCS, and how often each channel waited for a resend
+    OrderingChannelMap orderingChannelMap;
+    OrderingStalls orderingStalls;
+    std::vector<OrderingStallSummary> orderingStallSummary; //reused between GUI updates
+
+#if defined(DCS_COPILOT_PACKET_TRACE)
+    PacketTrace packetTrace;
+#endif
 
 };
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-Network::Network(MainWindow* window_) : mImpl(new Impl)
+Network::Network(UiChannel* uiChannel_) : mImpl(new Impl)
 {
-    window = window_;
+    uiChannel = uiChannel_;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 Network::~Network()
 {
+#if defined(DCS_COPILOT_PACKET_TRACE)
+    mImpl->packetTrace.dump(PACKET_TRACE_FILE);
+#endif
+
     delete mImpl;
     mImpl = 0;
 }
@@ -222,15 +371,78 @@ bool Network::ping(const char *ip, unsigned short port)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void Network::setPacketReadyEvent(RakNet::SignaledEvent* event)
+{
+    if (mImpl->peer)
+        mImpl->peer->SetPacketReadyEvent(event);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::setLogger(Logger* logger_)
+{
+    logger = logger_;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::setSessionRecorder(SessionRecorder* sessionRecorder_)
+{
+    sessionRecorder = sessionRecorder_;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool Network::replayPacket(const unsigned char* data, unsigned int length)
+{
+    if (!mImpl->peer->IsActive() || length == 0)
+        return false;
+
+    //look past the command stamp
+    unsigned int offset = (data[0] == ID_TIMESTAMP) ? COMMAND_STAMP_SIZE : 0;
+    if (length <= offset)
+        return false;
+
+    switch (data[offset])
+    {
+    case ID_NET_COMMAND:
+    case ID_NET_COMMAND_VALUE:
+    case ID_NET_COMMAND_VALUE_CORRECTION:
+    case ID_NET_EVENT:
+    case ID_NET_COMMAND_BATCH:
+    case ID_NET_EXTERNAL_ANIMATION:
+    case ID_NET_EXTERNAL_ANIMATION_CORRECTION:
+    case ID_NET_COCKPIT_ANIMATION:
+    case ID_NET_COCKPIT_ANIMATION_CORRECTION:
+        break;
+    default:
+        return false;
+    }
+
+    //no sender, so a host relays it to every client
+    RakNet::Packet* replayed = mImpl->peer->AllocatePacket(length);
+    memcpy(replayed->data, data, length);
+    replayed->systemAddress = RakNet::UNASSIGNED_SYSTEM_ADDRESS;
+    replayed->guid = RakNet::UNASSIGNED_RAKNET_GUID;
+    mImpl->peer->PushBackPacket(replayed, false);
+    return true;
+}
+
 void Network::writeOutput(const QString& q) const
 {
-    std::cout << q.toStdString().c_str() << std::endl;
-    window->logMessage(q);
+    if (logger != nullptr) {
+        logger->write(LOG_INFO, LOG_GENERAL, q);
+    }
+    else
+    {
+        std::cout << q.toStdString().c_str() << std::endl;
+        uiChannel->logMessage(q);
+    }
 }
 
 void Network::updateServerStatus(int status) const
 {
-    window->updateServerStatus(status);
+    uiChannel->updateServerStatus(status);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -240,12 +452,16 @@ bool Network::startServer(unsigned short port, std::string clientName, std::stri
     //cancel any ongoing connections
     mImpl->peer->Shutdown(100);
     mImpl->resetServerInfo();
+    mImpl->commandLatency.clear();
+    mImpl->orderingStalls.clear();
+    mImpl->deadReckoning.clear();
 
     mImpl->client_name = clientName;
     mImpl->serverConfig.port = port;
 
     RakNet::SocketDescriptor sd(mImpl->serverConfig.port, 0);
     int maxClients = mImpl->serverConfig.max_clients;
+    mImpl->peer->SetUpdateWorkers((unsigned int)mImpl->updateWorkers);
     RakNet::StartupResult result = mImpl->peer->Startup(maxClients, mImpl->serverConfig.tick_time_ms, &sd, 1);
 
     if (result == RakNet::RAKNET_STARTED)
@@ -254,7 +470,6 @@ bool Network::startServer(unsigned short port, std::string clientName, std::stri
         mImpl->serverGUID = mImpl->myGUID;
 
         writeOutput(QString("Server started successfully on port: %1").arg(mImpl->serverConfig.port));
-        //QLabel* label =  window->findChild<QLabel*>("Listener_status_label");
         updateServerStatus(SS_HOSTING);
 
         mImpl->peer->SetMaximumIncomingConnections(mImpl->serverConfig.max_clients);
@@ -269,20 +484,21 @@ bool Network::startServer(unsigned short port, std::string clientName, std::stri
         mImpl->serverStartTime = RakNet::GetTime();
 
         //add self
-        Client client;
-        client.ID = mImpl->myGUID;
+        Client& client = mImpl->clientTable.add(Impl::LOCAL_SLOT, mImpl->myGUID);
         client.name = mImpl->client_name.c_str();
         client.ping = -1;
+        client.codecProfile = mImpl->codecProfile.getFingerprint();
+        mImpl->clientTable.setCrew(Impl::LOCAL_SLOT, mImpl->myCrew);
 
-        mImpl->clientMap.insert(std::pair<RakNet::RakNetGUID, Client>(client.ID, client));        
+        mImpl->setSessionCodecProfile(client.codecProfile);
 
         std::string clientListName = mImpl->client_name.c_str();
         clientListName += " (Host)";
 
-        window->addClient(client.ID.ToString(), clientListName.c_str());
+        uiChannel->addClient(client.ID.ToString(), clientListName.c_str());
 
-        window->setServerIP(getServerAddress().c_str());
-        window->setMaxSeats(getMaxClients()+1);
+        uiChannel->setServerIP(getServerAddress().c_str());
+        uiChannel->setMaxSeats(getMaxClients()+1);
 
         return true;
     }
@@ -342,10 +558,15 @@ bool Network::connect(const char *ip, unsigned short port, std::string clientNam
         //cancel any ongoing connections
         mImpl->peer->Shutdown(100);
         mImpl->resetServerInfo();
+        mImpl->commandLatency.clear();
+        mImpl->orderingStalls.clear();
+        mImpl->deadReckoning.clear();
 
 
+        //one connection, nothing to share with update workers
         RakNet::SocketDescriptor sd;
-        mImpl->peer->Startup(1, 10, &sd, 1);
+        mImpl->peer->SetUpdateWorkers(0);
+        mImpl->peer->Startup(1, mImpl->serverConfig.tick_time_ms, &sd, 1);
 
         mImpl->client_name = clientName;
 
@@ -408,8 +629,8 @@ void Network::disconnect()
     updateServerStatus(SS_NOT_CONNECTED);
     writeOutput("Disconnecting from the server ...");
     mImpl->resetServerInfo();
-    window->clearClients();
-    window->resetStatistics();
+    uiChannel->clearClients();
+    uiChannel->resetStatistics();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -422,41 +643,33 @@ void Network::requestSeat(int seatNumber)
         {
             //Host has authority to grant its own permission
 
-            auto it = mImpl->clientMap.find(mImpl->myGUID);
-            if (it != mImpl->clientMap.end())
+            if (mImpl->clientTable.isUsed(Impl::LOCAL_SLOT))
             {
                 bool seatRequestAccepted = true;
-                if (it->second.seatNumber == seatNumber) {
+                if (mImpl->clientTable.get(Impl::LOCAL_SLOT).seatNumber == seatNumber) {
                     seatRequestAccepted = false;
                 }
-                else if (seatNumber > 0)
-                {
-                    for (auto& it2 : mImpl->clientMap)
-                    {
-                        if (it2.second.seatNumber == seatNumber)
-                        {
-                            //Someone already occupying the seat requested
-                            seatRequestAccepted = false;
-                            break;
-                        }
-                    }
+                else if (mImpl->clientTable.getSeatSlot(mImpl->myCrew, seatNumber) >= 0) {
+                    //Someone already occupying the seat requested
+                    seatRequestAccepted = false;
                 }
 
                 if (seatRequestAccepted)
                 {
-                    it->second.seatNumber = seatNumber;
+                    mImpl->clientTable.setSeat(Impl::LOCAL_SLOT, seatNumber);
                     emit receivedSeatChange(seatNumber);
                     mImpl->mySeat = seatNumber;
+                    resetAnimationSeat(seatNumber);
 
-                    window->setSeat(mImpl->myGUID.ToString(), seatNumber);
+                    uiChannel->setSeat(mImpl->myGUID.ToString(), seatNumber);
 
-                    //Inform all clients except ourselves
+                    //Inform all clients of my crew
                     {
                         RakNet::BitStream bsOut;
                         bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_SEAT_BROADCAST);
                         bsOut.Write(mImpl->myGUID);
                         bsOut.WriteBitsFromIntegerRange(seatNumber, 0, (MAX_CLIENTS+1));
-                        mImpl->peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, mImpl->serverAddress, true);
+                        sendToCrew(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, mImpl->myCrew, RakNet::UNASSIGNED_SYSTEM_ADDRESS);
                     }
                 }
             }
@@ -471,7 +684,8 @@ void Network::requestSeat(int seatNumber)
             RakNet::BitStream bsOut;
             bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_SEAT_REQUEST);
             bsOut.WriteBitsFromIntegerRange(seatNumber, 0, (MAX_CLIENTS+1));
-            mImpl->peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, mImpl->serverAddress, false);
+            mImpl->myInterest.write(bsOut);
+            send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, mImpl->serverAddress, false);
         }
     }
 }
@@ -491,23 +705,24 @@ void Network::kickClientFromSeat(const std::string& guidStr)
         // Else if another client, inform all clients of seat change
         else
         {
-            auto it = mImpl->clientMap.find(guid);
-            if (it != mImpl->clientMap.end())
+            int slot = mImpl->clientTable.findSlot(guid);
+            if (slot >= 0)
             {
-                it->second.seatNumber = 0;
-                window->setSeat(guid.ToString(), 0);
+                mImpl->clientTable.setSeat(slot, 0);
+                updateSeatView(slot, 0, SeatInterest());
+                uiChannel->setSeat(guid.ToString(), 0);
 
-                //Inform all clients except myself
+                //Inform all clients of the kicked client's crew
                 {
                     RakNet::BitStream bsOut;
                     bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_SEAT_BROADCAST);
                     bsOut.Write(guid);
                     bsOut.WriteBitsFromIntegerRange(0, 0, (MAX_CLIENTS+1));
-                    mImpl->peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, mImpl->myGUID, true);
+                    sendToCrew(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, mImpl->clientTable.get(slot).crew, RakNet::UNASSIGNED_SYSTEM_ADDRESS);
                 }
             }
-            std::string clientName = getClientNameByGUID(guid);
-            writeOutput(QString("\"%1\" has been kicked from their seat - GUID: %2").arg(clientName.c_str(), guid.ToString()));
+            const char* clientName = getClientNameByGUID(guid);
+            writeOutput(QString("\"%1\" has been kicked from their seat - GUID: %2").arg(clientName, guid.ToString()));
         }
     }
 }
@@ -524,9 +739,9 @@ void Network::kickClientFromServer(const std::string& guidStr)
         if (address != RakNet::UNASSIGNED_SYSTEM_ADDRESS)
         {
             std::string addressStr = address.ToString(false);
-            std::string clientName = getClientNameByGUID(guid);
+            const char* clientName = getClientNameByGUID(guid);
             mImpl->peer->CloseConnection(address, true);
-            writeOutput(QString("\"%1\" has been kicked from the server - IP: %2    GUID: %3").arg(clientName.c_str(), addressStr.c_str(), guid.ToString()));
+            writeOutput(QString("\"%1\" has been kicked from the server - IP: %2    GUID: %3").arg(clientName, addressStr.c_str(), guid.ToString()));
         }
     }
 }
@@ -559,8 +774,8 @@ bool Network::banClientFromServer(const std::string& guidStr)
             mImpl->peer->CloseConnection(address, true);
             std::string addressStr = address.ToString(false);
             mImpl->peer->AddToBanList(addressStr.c_str());
-            std::string clientName = getClientNameByGUID(guid);
-            writeOutput(QString("\"%1\" has been banned from the server - IP: %2    GUID: %3").arg(clientName.c_str(), addressStr.c_str(), guid.ToString()));
+            const char* clientName = getClientNameByGUID(guid);
+            writeOutput(QString("\"%1\" has been banned from the server - IP: %2    GUID: %3").arg(clientName, addressStr.c_str(), guid.ToString()));
             return true;
         }
     }
@@ -588,229 +803,751 @@ const char* Network::readBitStreamCharArray(RakNet::Packet *packet)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void Network::update()
+void Network::send(const RakNet::BitStream* bitStream, PacketPriority priority, PacketReliability reliability, char orderingChannel,
+                   const RakNet::AddressOrGUID systemIdentifier, bool broadcast)
 {
-    //shortcuts
-    RakNet::Packet* packet = mImpl->packet;
-    RakNet::RakPeerInterface* peer = mImpl->peer;
+    if (sessionRecorder != nullptr)
+        sessionRecorder->record(SESSION_NET_OUT, bitStream->GetData(), bitStream->GetNumberOfBytesUsed());
 
-    //packet checking loop
-    for (packet = peer->Receive(); packet; peer->DeallocatePacket(packet), packet = peer->Receive())
+    mImpl->peer->Send(bitStream, priority, reliability, orderingChannel, systemIdentifier, broadcast);
+}
+
+void Network::send(const char* data, int length, PacketPriority priority, PacketReliability reliability, char orderingChannel,
+                   const RakNet::AddressOrGUID systemIdentifier, bool broadcast)
+{
+    if (sessionRecorder != nullptr)
+        sessionRecorder->record(SESSION_NET_OUT, (const unsigned char*)data, (unsigned int)length);
+
+    mImpl->peer->Send(data, length, priority, reliability, orderingChannel, systemIdentifier, broadcast);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::relayPacket(RakNet::Packet *packet, PacketPriority priority, PacketReliability reliability, char orderingChannel,
+                          const CommandBatchEntry* entries, size_t numEntries)
+{
+    //the payload is already in wire format, so forward the received bytes untouched, including the command stamp
+    if (mImpl->stampedPacket != nullptr)
+        packet = mImpl->stampedPacket;
+
+    fanOut((const char*)packet->data, (int)packet->length, priority, reliability, orderingChannel, mImpl->packetCrew, packet->systemAddress, entries, numEntries);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::relayCommandPacket(RakNet::Packet *packet, const CommandBatchEntry* entries, size_t numEntries)
+{
+    //ID_NET_COMMAND, ID_NET_COMMAND_VALUE and ID_NET_COMMAND_BATCH start with [MessageID][orderingChannel][packetInfo]
+    if (packet->length < COMMAND_HEADER_SIZE)
+        return;
+
+    char orderingChannel = (char)packet->data[1];
+    unsigned char packetInfo = packet->data[2];
+    unsigned char priority = READFROM(packetInfo,0,2);
+    unsigned char reliability = READFROM(packetInfo,2,3);
+
+    //the header comes from the sender, so relay with what the protocol allows only. A receipt would come back to the host,
+    //and a channel past RakNet's last one would index past its ordering state.
+    if (priority > LOW_PRIORITY)
+        priority = LOW_PRIORITY;
+    if (reliability == UNRELIABLE_WITH_ACK_RECEIPT)
+        reliability = UNRELIABLE;
+    else if (reliability == RELIABLE_WITH_ACK_RECEIPT)
+        reliability = RELIABLE;
+    else if (reliability > RELIABLE_SEQUENCED)
+        reliability = RELIABLE_ORDERED;
+    if ((unsigned char)orderingChannel >= NUM_ORDERING_CHANNELS)
+        orderingChannel = ORDERING_CHANNEL_DEFAULT;
+
+    PACKET_TRACE(mImpl->packetTrace, PACKET_TRACE_RELAY, packet->data[0], orderingChannel, packetInfo, PACKET_TRACE_NO_COMMAND, 0, packet->length);
+    relayPacket(packet, static_cast<PacketPriority>(priority), static_cast<PacketReliability>(reliability), orderingChannel, entries, numEntries);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::fanOut(const char* data, int length, PacketPriority priority, PacketReliability reliability, char orderingChannel,
+                     int crew, const RakNet::SystemAddress& skipAddress, const CommandBatchEntry* entries, size_t numEntries)
+{
+    if (sessionRecorder != nullptr)
+        sessionRecorder->record(SESSION_NET_OUT, (const unsigned char*)data, (unsigned int)length);
+
+    //a command batch also carries the pings its recipient is owed, in a copy for that recipient. writePending() empties
+    //the queue, so only batches RakNet neither drops nor discards as out of sequence may take them.
+    unsigned int offset = (length > 0 && (unsigned char)data[0] == ID_TIMESTAMP) ? COMMAND_STAMP_SIZE : 0;
+    bool deliversAll = reliability == RELIABLE || reliability == RELIABLE_ORDERED ||
+                       reliability == RELIABLE_WITH_ACK_RECEIPT || reliability == RELIABLE_ORDERED_WITH_ACK_RECEIPT;
+    bool isBatch = length >= (int)(offset + COMMAND_HEADER_SIZE) && (unsigned char)data[offset] == ID_NET_COMMAND_BATCH;
+    bool canCarryClientInfo = deliversAll && isBatch && ((unsigned char)data[offset + 2] & BATCH_CLIENT_INFO) == 0;
+
+    //recipients without the codec profile a batch was coded by get the entries written again without it, once for all of
+    //them, or nothing if the host could not read them either
+    uint32_t batchProfile = 0;
+    if (isBatch && ((unsigned char)data[offset + 2] & BATCH_CODEC_PROFILE) != 0)
     {
-        mImpl->isAttemptingConnection = false;
-        switch (packet->data[0])
+        RakNet::BitStream bsProfile((unsigned char*)data + offset + COMMAND_HEADER_SIZE, (unsigned int)length - offset - COMMAND_HEADER_SIZE, false);
+        if (!bsProfile.Read(batchProfile))
+            return;
+    }
+    RakNet::BitStream recoded;
+
+    //RakNet has no multicast groups, so every recipient gets its own send of the same bytes.
+    //Remote clients only ever use the slots below max_clients.
+    const ClientTable& clientTable = mImpl->clientTable;
+    for (int slot = 0; slot < mImpl->serverConfig.max_clients; slot++)
+    {
+        if (!clientTable.isUsed(slot))
+            continue;
+
+        const Client& client = clientTable.get(slot);
+        if (client.crew != crew || client.seatNumber == 0 || client.address == RakNet::UNASSIGNED_SYSTEM_ADDRESS || client.address == skipAddress)
+            continue;
+
+        const Impl::SeatView* view = mImpl->seatViews[slot].get();
+        if (entries != nullptr && view != nullptr && !view->interest.wantsAny(entries, numEntries))
         {
-        case ID_UNCONNECTED_PONG:
+            mImpl->interestSkipped++;
+            continue;
+        }
+
+        const char* sendData = data;
+        int sendLength = length;
+        if (batchProfile != 0 && client.codecProfile != batchProfile)
         {
-            //unsigned int dataLength;
-            RakNet::TimeMS time;
-            RakNet::BitStream bsIn(packet->data, packet->length, false);
-            bsIn.IgnoreBytes(1);
-            bsIn.Read(time);
-            //dataLength = packet->length - sizeof(unsigned char) - sizeof(RakNet::TimeMS);
-            //printf("ID_UNCONNECTED_PONG from SystemAddress %s.\n", packet->systemAddress.ToString(true));
-            //printf("Time is %i\n", time);
-            writeOutput(QString("Ping: %1 ms").arg((unsigned int)(RakNet::GetTimeMS() - time)));
-            //printf("Data is %i bytes long.\n", dataLength);
-            //if (dataLength > 0)
-            //	printf("Data is %s\n", packet->data + sizeof(unsigned char) + sizeof(RakNet::TimeMS));
+            if (entries == nullptr)
+                continue;
 
-            break;
+            if (recoded.GetNumberOfBytesUsed() == 0)
+            {
+                recoded.Write(data, offset + COMMAND_HEADER_SIZE);
+                recoded.GetData()[offset + 2] &= ~BATCH_CODEC_PROFILE;
+                CommandBatch::writeEntries(recoded, entries, numEntries);
+            }
+            sendData = (const char*)recoded.GetData();
+            sendLength = (int)recoded.GetNumberOfBytesUsed();
         }
-        case ID_CONNECTED_PING:
-            //Core::FSLog::message("Ping from %s", packet->systemAddress.ToString(true));
-            break;
-        case ID_UNCONNECTED_PING:
-            //Core::FSLog::message("Ping from %s", packet->systemAddress.ToString(true));
-            break;
-        case ID_CONNECTION_REQUEST_ACCEPTED:
+
+        if (canCarryClientInfo && mImpl->clientInfo.hasPending(slot))
         {
-            writeOutput("CONNECTION SUCCESS: Connection request has been accepted.");
-            updateServerStatus(SS_CONNECTED);
+            RakNet::BitStream bsOut((unsigned char*)sendData, (unsigned int)sendLength, true);
+            bsOut.GetData()[offset + 2] |= BATCH_CLIENT_INFO;
+            mImpl->clientInfo.writePending(clientTable, slot, bsOut);
+            mImpl->peer->Send(&bsOut, priority, reliability, orderingChannel, client.address, false);
+            continue;
+        }
 
-            //add myself to client map
-            Client client;
-            client.ID = mImpl->myGUID;
-            client.name = mImpl->client_name.c_str();
-            mImpl->clientMap.insert(std::pair<RakNet::RakNetGUID, Client>(client.ID, client));
-            mImpl->clientNameMap.insert(std::pair<RakNet::RakNetGUID, std::string>(client.ID, std::string(client.name.C_String())));
+        mImpl->peer->Send(sendData, sendLength, priority, reliability, orderingChannel, client.address, false);
+    }
+}
 
-            window->addClient(client.ID.ToString(), client.name.C_String());
+void Network::sendToCrew(const RakNet::BitStream* bitStream, PacketPriority priority, PacketReliability reliability, char orderingChannel,
+                         int crew, const RakNet::SystemAddress& skipAddress)
+{
+    if (sessionRecorder != nullptr)
+        sessionRecorder->record(SESSION_NET_OUT, bitStream->GetData(), bitStream->GetNumberOfBytesUsed());
 
-            mImpl->serverAddress = mImpl->currentConnectionAttemptAddress;
-            mImpl->serverGUID = mImpl->peer->GetGuidFromSystemAddress(mImpl->serverAddress);
+    const ClientTable& clientTable = mImpl->clientTable;
+    for (int slot = 0; slot < mImpl->serverConfig.max_clients; slot++)
+    {
+        if (!clientTable.isUsed(slot))
+            continue;
 
-            //pass the server our name
-            RakNet::BitStream bsOut;
-            bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_CONNECTED_NAME);
-            bsOut.Write(mImpl->client_name.c_str());
-            peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, packet->systemAddress, false);
-            break;
-        }
-        case ID_NEW_INCOMING_CONNECTION:
-        {
-            //received by the host only
-            if (mImpl->isHost) {
-                Client client;
-                client.ID = peer->GetGuidFromSystemAddress(packet->systemAddress);
+        const Client& client = clientTable.get(slot);
+        if (client.crew != crew || client.address == RakNet::UNASSIGNED_SYSTEM_ADDRESS || client.address == skipAddress)
+            continue;
 
-                mImpl->addClient(client);
+        mImpl->peer->Send(bitStream, priority, reliability, orderingChannel, client.address, false);
+    }
+}
 
-                //mImpl->clientMap.insert(std::pair<RakNet::RakNetGUID, Client>(client.ID, client));
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-                //mImpl->newClientConnectList.push_back(client.ID);
+void Network::updateClientInfo()
+{
+    ClientTable& clientTable = mImpl->clientTable;
+    RakNet::Time now = mImpl->currentTime;
 
-                int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
-                mImpl->hostClientIndexList[index] = client.ID;
-                writeOutput("A client has connected.");
-                //////////////////////////////////////////
-                //inform new client of all other clients
-                RakNet::BitStream bsOut;
-                bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_LIST);
-                unsigned short numberOfClients = (unsigned short)mImpl->clientMap.size();
-                bsOut.Write(numberOfClients);
-                for (auto& it : mImpl->clientMap) {
-                    Client *client = &it.second;
-                    bsOut.Write(client->ID);
-                    bsOut.Write(client->name);
-                    bsOut.WriteBitsFromIntegerRange(client->seatNumber, 0, (MAX_CLIENTS+1));
-                }
+    //the host's own ping stays -1
+    for (int slot = 0; slot < mImpl->serverConfig.max_clients; slot++)
+    {
+        if (!clientTable.isUsed(slot))
+            continue;
 
-                peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, packet->systemAddress, false);
-            }
-            break;
-        }
-        case ID_CONNECTION_ATTEMPT_FAILED:
-            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAILURE: Unable to connect to server.");
-            updateServerStatus(SS_NOT_CONNECTED);
-            break;
-        case ID_ALREADY_CONNECTED:
-            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAILURE: Already connected to server.");
-            updateServerStatus(SS_NOT_CONNECTED);
-            break;
-        case ID_NO_FREE_INCOMING_CONNECTIONS:
-            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAIULRE: Server is full.");
-            updateServerStatus(SS_NOT_CONNECTED);
-            break;
-        case ID_CONNECTION_BANNED:
-            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAIULRE: You are banned from this server.");
-            updateServerStatus(SS_NOT_CONNECTED);
-            break;
-        case ID_INVALID_PASSWORD:
-            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAIULRE: Wrong password!");
-            updateServerStatus(SS_NOT_CONNECTED);
-            break;
-        case ID_INCOMPATIBLE_PROTOCOL_VERSION:
-            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAILURE: Incompatible Protocol Version with the server.");
-            updateServerStatus(SS_NOT_CONNECTED);
-            break;
-        case ID_DISCONNECTION_NOTIFICATION:
-        {
-            if (mImpl->isHost)
-            {
-                int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
-                RakNet::RakNetGUID guid = mImpl->hostClientIndexList[index];
-                mImpl->hostClientIndexList[index] = RakNet::UNASSIGNED_RAKNET_GUID;
+        Client& client = clientTable.get(slot);
+        client.ping = mImpl->peer->GetLastPing(client.address);
+        uiChannel->setPing(client.ID.ToString(), client.ping);
+        mImpl->clientInfo.updatePing(clientTable, slot, client.ping, now);
+    }
 
-                //mImpl->newClientDisconnectList.push_back(guid);
+    mImpl->clientInfo.refresh(clientTable, now);
 
-                if (guid != RakNet::UNASSIGNED_RAKNET_GUID)
-                {
-                    std::string clientNameStr = mImpl->removeClient(guid);
+    //entries no batch picked up in time go out on their own, which is always the case for clients without a seat.
+    //writePending() empties the queue, so they are sent reliably, which at a few per second costs little.
+    for (int slot = 0; slot < mImpl->serverConfig.max_clients; slot++)
+    {
+        if (!clientTable.isUsed(slot) || !mImpl->clientInfo.isOverdue(slot, now))
+            continue;
 
-                    window->removeClient(guid.ToString());
+        RakNet::BitStream bsOut;
+        bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_INFO);
+        mImpl->clientInfo.writePending(clientTable, slot, bsOut);
+        send(&bsOut, LOW_PRIORITY, RELIABLE, 0, clientTable.get(slot).address, false);
+    }
+}
 
-                    writeOutput(QString("\"%1\" has disconnected - GUID: %2").arg(clientNameStr.c_str(), guid.ToString()));
-                    //////////////////////////////////////////
-                    //inform all clients of the disconnection
-                    RakNet::BitStream bsOut;
-                    bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_DISCONNECTED_BROADCAST);
-                    bsOut.Write(guid);
-                    peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, packet->systemAddress, true);
-                }
-            }
-            else {
-                mImpl->resetServerInfo();
-                writeOutput("Disconnected from the server.");
-                updateServerStatus(SS_NOT_CONNECTED);
-                window->clearClients();
-                window->resetStatistics();
-            }
-            break;
-        }
-        case ID_CONNECTION_LOST:
+void Network::receiveClientInfo(RakNet::BitStream& bsIn)
+{
+    std::vector<ClientInfoEntry> entries;
+    ClientInfoTracker::readEntries(bsIn, entries);
+    for (const auto& entry : entries)
+    {
+        if (entry.guid == mImpl->myGUID)
         {
-            if (mImpl->isHost)
-            {
-                int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
-                RakNet::RakNetGUID guid = mImpl->hostClientIndexList[index];
-                mImpl->hostClientIndexList[index] = RakNet::UNASSIGNED_RAKNET_GUID;
+            mImpl->myPing = entry.ping;
+            uiChannel->setMyPing(mImpl->myPing);
+        }
 
-                //mImpl->newClientDisconnectList.push_back(guid);
+        //add latest ping to the client table
+        int slot = mImpl->clientTable.findSlot(entry.guid);
+        if (slot >= 0) {
+            mImpl->clientTable.get(slot).ping = entry.ping;
+        }
 
-                if (guid != RakNet::UNASSIGNED_RAKNET_GUID)
-                {
-                    std::string clientNameStr = mImpl->removeClient(guid);
+        uiChannel->setPing(entry.guid.ToString(), entry.ping);
+    }
+}
 
-                    window->removeClient(guid.ToString());
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-                    writeOutput(QString("\"%1\" has lost the connection - GUID: %2").arg(clientNameStr.c_str(), guid.ToString()));
-                    //////////////////////////////////////////
-                    //inform all clients of the lost connection
-                    RakNet::BitStream bsOut;
-                    bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_LOST_CONNECTION_BROADCAST);
-                    bsOut.Write(guid);
-                    peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, packet->systemAddress, true);
-                }
-            }
-            else
-            {
-                mImpl->resetServerInfo();
-                writeOutput("<font color='red'>ERROR:</font> Connection to the server was lost.");
-                updateServerStatus(SS_NOT_CONNECTED);
-                window->clearClients();
-                window->resetStatistics();
-            }
-            break;
-        }
+void Network::updateSeatView(int slot, int seatNumber, const SeatInterest& interest)
+{
+    if (slot < 0 || slot >= (int)mImpl->seatViews.size())
+        return;
 
-        ////////////////////////////////////////////////
-        ///////////    CUSTOM MESSAGE IDS    ///////////
-        ////////////////////////////////////////////////
+    if (seatNumber == 0 || interest.isAll())
+    {
+        mImpl->seatViews[slot].reset();
+        return;
+    }
 
-        case ID_NET_CLIENT_CONNECTED_NAME:
-        {
-            //received by the host only
-            if (mImpl->isHost)
-            {
-                int clientIndex = peer->GetIndexFromSystemAddress(packet->systemAddress);
-                if (clientIndex >= 0)
-                {
-                    RakNet::RakString rs = readBitStreamString(packet);
-                    const char * clientName = rs.C_String();
-                    std::string clientNameStr = std::string(clientName);
-                    const RakNet::RakNetGUID& guid = peer->GetGuidFromSystemAddress(packet->systemAddress);
+    //the seat's master sync compares against the commands it wants, starting from what the session has now
+    if (!mImpl->seatViews[slot])
+        mImpl->seatViews[slot].reset(new Impl::SeatView);
+    Impl::SeatView& view = *mImpl->seatViews[slot];
+    view.interest = interest;
+    view.commandState.clear();
 
-                    mImpl->clientNameMap.insert(std::pair<RakNet::RakNetGUID, std::string>(guid, clientNameStr));
+    CommandStateTable* crewState = mImpl->getCommandState(mImpl->clientTable.get(slot).crew);
+    if (crewState == nullptr)
+        return;
 
-                    Client *client = getClientByGUID(guid);
-                    if (client) {
-                        client->name = clientNameStr.c_str();
-                    }
+    std::vector<CommandState> states;
+    crewState->getSnapshot(states);
+    for (const auto& state : states)
+    {
+        if (interest.wantsCommand(state.command))
+            view.commandState.set(state.command, state.value);
+    }
+}
 
-                    window->addClient(guid.ToString(), clientNameStr.c_str());
+CommandStateTable& Network::getSyncState(int slot)
+{
+    if (slot >= 0 && slot < (int)mImpl->seatViews.size() && mImpl->seatViews[slot])
+        return mImpl->seatViews[slot]->commandState;
 
-                    writeOutput(QString("\"%1\" has joined the server - IP: %2    GUID: %3").arg(clientName, packet->systemAddress.ToString(false), guid.ToString()));
+    //a client of another crew compares against that crew's state
+    CommandStateTable* crewState = mImpl->clientTable.isUsed(slot) ? mImpl->getCommandState(mImpl->clientTable.get(slot).crew) : nullptr;
+    return crewState ? *crewState : mImpl->commandState;
+}
 
-                    //////////////////////////////////////////
-                    //inform all clients of the new client connection with name and GUID
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+RakNet::Packet* Network::readCommandStamp(RakNet::Packet *packet, RakNet::Packet& unstamped)
+{
+    mImpl->stampedPacket = nullptr;
+
+    if (packet->data[0] != ID_TIMESTAMP || packet->length <= COMMAND_STAMP_SIZE)
+        return packet;
+
+    //RakNet has already shifted the time into our clock
+    RakNet::BitStream bsIn(packet->data, packet->length, false);
+    bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+    unsigned char seatNumber = 0;
+    bsIn.Read(mImpl->stampIngressTime);
+    bsIn.Read(seatNumber);
+    mImpl->stampSeat = seatNumber;
+    mImpl->stampedPacket = packet;
+
+    unstamped = *packet;
+    unstamped.data = packet->data + COMMAND_STAMP_SIZE;
+    unstamped.length = packet->length - COMMAND_STAMP_SIZE;
+    unstamped.bitSize = unstamped.length * 8;
+    return &unstamped;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::recordCommandLatency(int messageClass)
+{
+    if (mImpl->stampedPacket == nullptr)
+        return;
+
+    //a clock differential still settling can put the stamp slightly in the future
+    RakNet::Time now = RakNet::GetTime();
+    uint64_t latencyMS = (now > mImpl->stampIngressTime) ? (uint64_t)(now - mImpl->stampIngressTime) : 0;
+    mImpl->commandLatency.add(mImpl->stampSeat, static_cast<CommandBatchEntryType>(messageClass), latencyMS * 1000);
+}
+
+void Network::recordOrderingStall(char orderingChannel, unsigned char reliability)
+{
+    //only ordered messages are held back for an earlier one
+    if (mImpl->stampedPacket == nullptr || (reliability != RELIABLE_ORDERED && reliability != RELIABLE_ORDERED_WITH_ACK_RECEIPT))
+        return;
+
+    RakNet::Time now = RakNet::GetTime();
+    uint64_t latencyMS = (now > mImpl->stampIngressTime) ? (uint64_t)(now - mImpl->stampIngressTime) : 0;
+    int roundTripMS = mImpl->peer->GetAveragePing(mImpl->stampedPacket->systemAddress);
+    mImpl->orderingStalls.add(mImpl->stampSeat, orderingChannel, latencyMS, roundTripMS);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool Network::exportCommandLatency(const std::string& path) const
+{
+    if (!mImpl->commandLatency.exportCsv(path))
+    {
+        writeOutput(QString("<font color='red'>ERROR:</font> Could not write the command latency to %1").arg(path.c_str()));
+        return false;
+    }
+
+    writeOutput(QString("Command latency written to %1").arg(path.c_str()));
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool Network::setOrderingChannels(const std::string& setting)
+{
+    if (setting.empty() || setting == "hashed")
+    {
+        mImpl->orderingChannelMap.setMode(ORDERING_CHANNELS_HASHED);
+        return true;
+    }
+    if (setting == "aircraft")
+    {
+        mImpl->orderingChannelMap.setMode(ORDERING_CHANNELS_AIRCRAFT);
+        return true;
+    }
+
+    if (!mImpl->orderingChannelMap.loadTable(setting))
+    {
+        writeOutput(QString("<font color='red'>ERROR:</font> Cannot load the ordering channel table: %1").arg(mImpl->orderingChannelMap.getError().c_str()));
+        return false;
+    }
+
+    writeOutput(QString("Ordering channels assigned from %1").arg(setting.c_str()));
+    return true;
+}
+
+bool Network::setDeadReckoning(const std::string& setting)
+{
+    if (setting.empty() || setting == "on" || setting == "off")
+    {
+        mImpl->deadReckoning.clearTolerances();
+        mImpl->deadReckoning.setEnabled(setting != "off");
+        return true;
+    }
+
+    if (!mImpl->deadReckoning.loadTolerances(setting))
+    {
+        writeOutput(QString("<font color='red'>ERROR:</font> Cannot load the dead reckoning tolerances: %1").arg(mImpl->deadReckoning.getError().c_str()));
+        return false;
+    }
+
+    mImpl->deadReckoning.setEnabled(true);
+    writeOutput(QString("Dead reckoning tolerances loaded from %1").arg(setting.c_str()));
+    return true;
+}
+
+bool Network::setCodecProfile(const std::string& path)
+{
+    if (path.empty())
+    {
+        mImpl->codecProfile.clear();
+    }
+    else if (!mImpl->codecProfile.load(path))
+    {
+        writeOutput(QString("<font color='red'>ERROR:</font> Cannot load the aircraft codec profile: %1").arg(mImpl->codecProfile.getError().c_str()));
+        return false;
+    }
+    else
+    {
+        writeOutput(QString("Aircraft codec profile loaded from %1 (%2)").arg(path.c_str()).arg(mImpl->codecProfile.getFingerprint(), 8, 16, QChar('0')));
+    }
+
+    //a running session keeps the profile it agreed on, which no longer matches unless the new one is the same
+    mImpl->setSessionCodecProfile(mImpl->sessionCodecProfile);
+    return true;
+}
+
+void Network::setStatisticsRate(int rateHz)
+{
+    mImpl->statisticsSampler.setRate(rateHz);
+}
+
+bool Network::setSeatInterest(const std::string& setting)
+{
+    if (setting.empty() || setting == "all")
+    {
+        mImpl->myInterest.setAll();
+        return true;
+    }
+
+    if (!mImpl->myInterest.load(setting))
+    {
+        writeOutput(QString("<font color='red'>ERROR:</font> Cannot load the seat interest table: %1").arg(mImpl->myInterest.getError().c_str()));
+        return false;
+    }
+
+    writeOutput(QString("Seat interest loaded from %1, used from the next seat request").arg(setting.c_str()));
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::updateSessionCodecProfile(int crew, const RakNet::SystemAddress& joined)
+{
+    //a client joins a crew with its codec profile. The host decodes every crew's batches, so it must have the profile too.
+    uint32_t fingerprint = mImpl->codecProfile.getFingerprint();
+    for (int slot = 0; slot < mImpl->clientTable.getNumSlots(); slot++)
+    {
+        if (!mImpl->clientTable.isUsed(slot))
+            continue;
+
+        const Client& client = mImpl->clientTable.get(slot);
+        if (client.crew == crew && client.codecProfile != fingerprint)
+        {
+            fingerprint = 0;
+            break;
+        }
+    }
+
+    Impl::Crew* otherCrew = mImpl->getOtherCrew(crew);
+    if (crew != mImpl->myCrew && otherCrew == nullptr)
+        return;
+
+    uint32_t& sessionCodecProfile = otherCrew ? otherCrew->sessionCodecProfile : mImpl->sessionCodecProfile;
+    bool changed = (fingerprint != sessionCodecProfile);
+    if (changed)
+    {
+        if (otherCrew)
+        {
+            sessionCodecProfile = fingerprint;
+        }
+        else
+        {
+            mImpl->setSessionCodecProfile(fingerprint);
+            if (!mImpl->codecProfile.empty()) {
+                writeOutput(fingerprint != 0 ? "Aircraft codec profile in use." : "Aircraft codec profile not in use, not every seat loaded the same one.");
+            }
+        }
+    }
+    else if (joined == RakNet::UNASSIGNED_SYSTEM_ADDRESS)
+    {
+        return;
+    }
+
+    RakNet::BitStream bsOut;
+    bsOut.Write((RakNet::MessageID)ID_NET_CODEC_PROFILE);
+    bsOut.Write(fingerprint);
+    if (changed)
+        sendToCrew(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, crew, RakNet::UNASSIGNED_SYSTEM_ADDRESS);
+    else
+        send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, joined, false);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::update()
+{
+    //shortcuts
+    RakNet::Packet* packet = mImpl->packet;
+    RakNet::RakPeerInterface* peer = mImpl->peer;
+
+    RakNet::Packet unstamped;
+
+    //packet checking loop
+    for (RakNet::Packet* received = peer->Receive(); received; peer->DeallocatePacket(received), received = peer->Receive())
+    {
+        mImpl->isAttemptingConnection = false;
+
+        if (sessionRecorder != nullptr)
+            sessionRecorder->record(SESSION_NET_IN, received->data, received->length);
+
+        //command messages carry a stamp, the cases below see the message after it
+        packet = readCommandStamp(received, unstamped);
+
+        //on the host everything a client sends stays within its crew. Replayed messages are my crew's.
+        if (mImpl->isHost)
+        {
+            int slot = peer->GetIndexFromSystemAddress(packet->systemAddress);
+            mImpl->packetCrew = (slot >= 0 && mImpl->clientTable.isUsed(slot)) ? mImpl->clientTable.get(slot).crew : mImpl->myCrew;
+        }
+
+        switch (packet->data[0])
+        {
+        case ID_UNCONNECTED_PONG:
+        {
+            //unsigned int dataLength;
+            RakNet::TimeMS time;
+            RakNet::BitStream bsIn(packet->data, packet->length, false);
+            bsIn.IgnoreBytes(1);
+            bsIn.Read(time);
+            //dataLength = packet->length - sizeof(unsigned char) - sizeof(RakNet::TimeMS);
+            //printf("ID_UNCONNECTED_PONG from SystemAddress %s.\n", packet->systemAddress.ToString(true));
+            //printf("Time is %i\n", time);
+            writeOutput(QString("Ping: %1 ms").arg((unsigned int)(RakNet::GetTimeMS() - time)));
+            //printf("Data is %i bytes long.\n", dataLength);
+            //if (dataLength > 0)
+            //	printf("Data is %s\n", packet->data + sizeof(unsigned char) + sizeof(RakNet::TimeMS));
+
+            break;
+        }
+        case ID_CONNECTED_PING:
+            //Core::FSLog::message("Ping from %s", packet->systemAddress.ToString(true));
+            break;
+        case ID_UNCONNECTED_PING:
+            //Core::FSLog::message("Ping from %s", packet->systemAddress.ToString(true));
+            break;
+        case ID_CONNECTION_REQUEST_ACCEPTED:
+        {
+            writeOutput("CONNECTION SUCCESS: Connection request has been accepted.");
+            updateServerStatus(SS_CONNECTED);
+
+            //add myself to the client table
+            Client& client = mImpl->clientTable.add(Impl::LOCAL_SLOT, mImpl->myGUID);
+            client.name = mImpl->client_name.c_str();
+
+            uiChannel->addClient(client.ID.ToString(), client.name.C_String());
+
+            mImpl->serverAddress = mImpl->currentConnectionAttemptAddress;
+            mImpl->serverGUID = mImpl->peer->GetGuidFromSystemAddress(mImpl->serverAddress);
+
+            //pass the server our name, codec profile, crew and protocol version
+            RakNet::BitStream bsOut;
+            bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_CONNECTED_NAME);
+            bsOut.Write(mImpl->client_name.c_str());
+            bsOut.Write(mImpl->codecProfile.getFingerprint());
+            bsOut.Write((unsigned char)mImpl->myCrew);
+            bsOut.Write(PROTOCOL_VERSION);
+            send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, packet->systemAddress, false);
+            break;
+        }
+        case ID_NEW_INCOMING_CONNECTION:
+        {
+            //received by the host only
+            int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
+            if (mImpl->isHost && index >= 0 && index < Impl::LOCAL_SLOT) {
+                Client& client = mImpl->clientTable.add(index, peer->GetGuidFromSystemAddress(packet->systemAddress));
+                client.address = packet->systemAddress;
+                client.crew = NO_CREW;
+                mImpl->seatViews[index].reset();
+
+                //mImpl->newClientConnectList.push_back(client.ID);
+
+                //the client list follows the client's name, which says what crew it joins
+                writeOutput("A client has connected.");
+            }
+            break;
+        }
+        case ID_CONNECTION_ATTEMPT_FAILED:
+            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAILURE: Unable to connect to server.");
+            updateServerStatus(SS_NOT_CONNECTED);
+            break;
+        case ID_ALREADY_CONNECTED:
+            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAILURE: Already connected to server.");
+            updateServerStatus(SS_NOT_CONNECTED);
+            break;
+        case ID_NO_FREE_INCOMING_CONNECTIONS:
+            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAIULRE: Server is full.");
+            updateServerStatus(SS_NOT_CONNECTED);
+            break;
+        case ID_CONNECTION_BANNED:
+            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAIULRE: You are banned from this server.");
+            updateServerStatus(SS_NOT_CONNECTED);
+            break;
+        case ID_INVALID_PASSWORD:
+            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAIULRE: Wrong password!");
+            updateServerStatus(SS_NOT_CONNECTED);
+            break;
+        case ID_INCOMPATIBLE_PROTOCOL_VERSION:
+            writeOutput("<font color='red'>ERROR:</font> CONNECTION FAILURE: Incompatible Protocol Version with the server.");
+            updateServerStatus(SS_NOT_CONNECTED);
+            break;
+        case ID_DISCONNECTION_NOTIFICATION:
+        {
+            if (mImpl->isHost)
+            {
+                int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
+
+                //mImpl->newClientDisconnectList.push_back(guid);
+
+                if (mImpl->clientTable.isUsed(index))
+                {
+                    RakNet::RakNetGUID guid = mImpl->clientTable.get(index).ID;
+                    int crew = mImpl->clientTable.get(index).crew;
+                    RakNet::RakString clientName = mImpl->removeClient(index);
+
+                    uiChannel->removeClient(guid.ToString());
+
+                    writeOutput(QString("\"%1\" has disconnected - GUID: %2").arg(clientName.C_String(), guid.ToString()));
+                    //////////////////////////////////////////
+                    //inform all clients of the crew of the disconnection
+                    RakNet::BitStream bsOut;
+                    bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_DISCONNECTED_BROADCAST);
+                    bsOut.Write(guid);
+                    sendToCrew(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, crew, packet->systemAddress);
+
+                    updateSessionCodecProfile(crew, RakNet::UNASSIGNED_SYSTEM_ADDRESS);
+                }
+            }
+            else {
+                mImpl->resetServerInfo();
+                writeOutput("Disconnected from the server.");
+                updateServerStatus(SS_NOT_CONNECTED);
+                uiChannel->clearClients();
+                uiChannel->resetStatistics();
+            }
+            break;
+        }
+        case ID_CONNECTION_LOST:
+        {
+            if (mImpl->isHost)
+            {
+                int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
+
+                //mImpl->newClientDisconnectList.push_back(guid);
+
+                if (mImpl->clientTable.isUsed(index))
+                {
+                    RakNet::RakNetGUID guid = mImpl->clientTable.get(index).ID;
+                    int crew = mImpl->clientTable.get(index).crew;
+                    RakNet::RakString clientName = mImpl->removeClient(index);
+
+                    uiChannel->removeClient(guid.ToString());
+
+                    writeOutput(QString("\"%1\" has lost the connection - GUID: %2").arg(clientName.C_String(), guid.ToString()));
+                    //////////////////////////////////////////
+                    //inform all clients of the crew of the lost connection
+                    RakNet::BitStream bsOut;
+                    bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_LOST_CONNECTION_BROADCAST);
+                    bsOut.Write(guid);
+                    sendToCrew(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, crew, packet->systemAddress);
+
+                    updateSessionCodecProfile(crew, RakNet::UNASSIGNED_SYSTEM_ADDRESS);
+                }
+            }
+            else
+            {
+                mImpl->resetServerInfo();
+                writeOutput("<font color='red'>ERROR:</font> Connection to the server was lost.");
+                updateServerStatus(SS_NOT_CONNECTED);
+                uiChannel->clearClients();
+                uiChannel->resetStatistics();
+            }
+            break;
+        }
+
+        ////////////////////////////////////////////////
+        ///////////    CUSTOM MESSAGE IDS    ///////////
+        ////////////////////////////////////////////////
+
+        case ID_NET_CLIENT_CONNECTED_NAME:
+        {
+            //received by the host only
+            if (mImpl->isHost)
+            {
+                int clientIndex = peer->GetIndexFromSystemAddress(packet->systemAddress);
+                if (mImpl->clientTable.isUsed(clientIndex))
+                {
+                    RakNet::RakString rs;
+                    uint32_t codecProfile = 0;
+                    unsigned char crew = 0;
+                    unsigned short protocolVersion = 0; //clients from before the version was sent only send their name
+                    RakNet::BitStream bsIn(packet->data, packet->length, false);
+                    bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+                    bsIn.Read(rs);
+                    bsIn.Read(codecProfile);
+                    bsIn.Read(crew);
+                    bsIn.Read(protocolVersion);
+                    if (crew >= MAX_CREWS)
+                        crew = 0;
+                    const char * clientName = rs.C_String();
+
+                    if (protocolVersion != PROTOCOL_VERSION)
+                    {
+                        //the client cannot read our messages, its disconnection removes it from the table
+                        RakNet::BitStream bsOut;
+                        bsOut.Write((RakNet::MessageID)ID_NET_VERSION_MISMATCH);
+                        bsOut.Write(PROTOCOL_VERSION);
+                        send(&bsOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, 0, packet->systemAddress, false);
+                        peer->CloseConnection(packet->systemAddress, true);
+                        writeOutput(QString("<font color='orange'>WARNING:</font> \"%1\" was turned away, it uses protocol version %2 and the server %3 - IP: %4")
+                                    .arg(clientName).arg(protocolVersion).arg(PROTOCOL_VERSION).arg(packet->systemAddress.ToString(false)));
+                        break;
+                    }
+
+                    Client& client = mImpl->clientTable.get(clientIndex);
+                    client.name = rs;
+                    client.codecProfile = codecProfile;
+                    mImpl->clientTable.setCrew(clientIndex, crew);
+                    mImpl->clientInfo.joinCrew(mImpl->clientTable, clientIndex, mImpl->currentTime);
+                    const RakNet::RakNetGUID& guid = client.ID;
+
+                    std::string clientListName = clientName;
+                    if (crew != 0) {
+                        clientListName += QString(" (Crew %1)").arg(crew).toStdString();
+                    }
+                    uiChannel->addClient(guid.ToString(), clientListName.c_str());
+
+                    writeOutput(QString("\"%1\" has joined the server - IP: %2    GUID: %3").arg(clientListName.c_str(), packet->systemAddress.ToString(false), guid.ToString()));
+
+                    //////////////////////////////////////////
+                    //inform the new client of the other clients of its crew and the host, who is only seated in its own crew
+                    {
+                        RakNet::BitStream bsOut;
+                        bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_LIST);
+                        unsigned short numberOfClients = 0;
+                        for (int slot = 0; slot < mImpl->clientTable.getNumSlots(); slot++) {
+                            if (mImpl->clientTable.isUsed(slot) && (slot == Impl::LOCAL_SLOT || mImpl->clientTable.get(slot).crew == crew))
+                                numberOfClients++;
+                        }
+                        bsOut.Write(numberOfClients);
+                        for (int slot = 0; slot < mImpl->clientTable.getNumSlots(); slot++) {
+                            if (!mImpl->clientTable.isUsed(slot))
+                                continue;
+                            const Client& listed = mImpl->clientTable.get(slot);
+                            if (slot != Impl::LOCAL_SLOT && listed.crew != crew)
+                                continue;
+                            bsOut.Write(listed.ID);
+                            bsOut.Write(listed.name);
+                            bsOut.WriteBitsFromIntegerRange((listed.crew == crew) ? listed.seatNumber : 0, 0, (MAX_CLIENTS+1));
+                        }
+                        bsOut.Write(PROTOCOL_VERSION);
+
+                        send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, packet->systemAddress, false);
+                    }
+
+                    //////////////////////////////////////////
+                    //inform the crew of the new client connection with name and GUID
                     {
                         RakNet::BitStream bsOut;
                         bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_CONNECTED_BROADCAST);
                         bsOut.Write(guid);
                         bsOut.Write(rs);
-                        peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, packet->systemAddress, true);
+                        sendToCrew(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, crew, packet->systemAddress);
                     }
+
+                    updateSessionCodecProfile(crew, packet->systemAddress);
                 }
             }
             break;
@@ -825,20 +1562,22 @@ void Network::update()
             //received by clients only
             if (!mImpl->isHost)
             {
-                Client client;
+                RakNet::RakNetGUID guid;
                 RakNet::RakString rs;
                 RakNet::BitStream bsIn(packet->data, packet->length, false);
                 bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
-                bsIn.Read(client.ID);
+                bsIn.Read(guid);
                 bsIn.Read(rs);
                 const char * clientName = rs.C_String();
-                client.name = rs;
 
-                mImpl->addClient(client);
+                int slot = mImpl->addRemoteClient(guid);
+                if (slot >= 0) {
+                    mImpl->clientTable.get(slot).name = rs;
+                }
 
-                window->addClient(client.ID.ToString(), clientName);
+                uiChannel->addClient(guid.ToString(), clientName);
 
-                writeOutput(QString("\"%1\" has joined the server - GUID: %2").arg(clientName, client.ID.ToString()));
+                writeOutput(QString("\"%1\" has joined the server - GUID: %2").arg(clientName, guid.ToString()));
             }
             break;
         }
@@ -854,11 +1593,11 @@ void Network::update()
 
                 //mImpl->newClientDisconnectList.push_back(guid);
 
-                std::string clientNameStr = mImpl->removeClient(guid);
+                RakNet::RakString clientName = mImpl->removeClient(mImpl->clientTable.findSlot(guid));
 
-                window->removeClient(guid.ToString());
+                uiChannel->removeClient(guid.ToString());
 
-                writeOutput(QString("\"%1\" has disconnected - GUID: %2").arg(clientNameStr.c_str(), guid.ToString()));
+                writeOutput(QString("\"%1\" has disconnected - GUID: %2").arg(clientName.C_String(), guid.ToString()));
             }
             break;
         }
@@ -874,11 +1613,11 @@ void Network::update()
 
                 //mImpl->newClientDisconnectList.push_back(guid);
 
-                std::string clientNameStr = mImpl->removeClient(guid);
+                RakNet::RakString clientName = mImpl->removeClient(mImpl->clientTable.findSlot(guid));
 
-                window->removeClient(guid.ToString());
+                uiChannel->removeClient(guid.ToString());
 
-                writeOutput(QString("\"%1\" has lost connection - GUID: %2").arg(clientNameStr.c_str(), guid.ToString()));
+                writeOutput(QString("\"%1\" has lost connection - GUID: %2").arg(clientName.C_String(), guid.ToString()));
             }
             break;
         }
@@ -889,31 +1628,62 @@ void Network::update()
             {
                 RakNet::BitStream bsIn(packet->data, packet->length, false);
                 bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
-                unsigned short numberOfClients;
+                unsigned short numberOfClients = 0;
                 bsIn.Read(numberOfClients);
-                for (unsigned short us = 0; us < numberOfClients; us++)
+                std::vector<Client> clients(std::min<unsigned short>(numberOfClients, MAX_CLIENTS+1));
+                for (auto& client : clients)
                 {
-                    Client client;
                     bsIn.Read(client.ID);
                     bsIn.Read(client.name);
                     bsIn.ReadBitsFromIntegerRange(client.seatNumber, 0, (MAX_CLIENTS+1));
+                }
+
+                //the host's version follows the list, hosts from before it was sent end with the list
+                unsigned short protocolVersion = 0;
+                bsIn.Read(protocolVersion);
+                if (protocolVersion != PROTOCOL_VERSION)
+                {
+                    writeOutput(QString("<font color='red'>ERROR:</font> CONNECTION FAILURE: The server uses protocol version %1 and this client %2. "
+                                        "Use the same DCS Copilot version as the host.").arg(protocolVersion).arg(PROTOCOL_VERSION));
+                    peer->CloseConnection(packet->systemAddress, true);
+                    break;
+                }
 
+                for (const auto& client : clients)
+                {
                     //skip my own client, as this is stored at connection
                     if (client.ID != mImpl->myGUID)
                     {
-                        mImpl->clientMap.insert(std::pair<RakNet::RakNetGUID, Client>(client.ID, client));
-                        mImpl->clientNameMap.insert(std::pair<RakNet::RakNetGUID, std::string>(client.ID, std::string(client.name.C_String())));
+                        int slot = mImpl->addRemoteClient(client.ID);
+                        if (slot >= 0) {
+                            mImpl->clientTable.get(slot).name = client.name;
+                            mImpl->clientTable.setSeat(slot, client.seatNumber);
+                        }
 
                         std::string clientListName = client.name.C_String();
                         if (client.ID == mImpl->serverGUID) {
                             clientListName += " (Host)";
                         }
 
-                        window->addClient(client.ID.ToString(), clientListName.c_str(), client.seatNumber);
+                        uiChannel->addClient(client.ID.ToString(), clientListName.c_str(), client.seatNumber);
                     }
                 }
 
-                window->setServerIP(getServerAddress().c_str());
+                uiChannel->setServerIP(getServerAddress().c_str());
+            }
+            break;
+        }
+        case ID_NET_VERSION_MISMATCH:
+        {
+            //received by clients only, the host disconnects us after it
+            if (!mImpl->isHost)
+            {
+                unsigned short protocolVersion = 0;
+                RakNet::BitStream bsIn(packet->data, packet->length, false);
+                bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+                bsIn.Read(protocolVersion);
+                writeOutput(QString("<font color='red'>ERROR:</font> CONNECTION FAILURE: The server uses protocol version %1 and this client %2. "
+                                    "Use the same DCS Copilot version as the host.").arg(protocolVersion).arg(PROTOCOL_VERSION));
             }
             break;
         }
@@ -922,39 +1692,9 @@ void Network::update()
             //received by clients only
             if (!mImpl->isHost)
             {
-                mImpl->clientInfoList.clear();
                 RakNet::BitStream bsIn(packet->data, packet->length, false);
                 bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
-                unsigned short numberOfClients;
-                bsIn.Read(numberOfClients);
-                //printf("\n\n\n-------------------\n");
-                //printf("Client Information:\n");
-                //printf("-------------------\n");
-                //printf(" # Name (ID)\t\t\tPing (ms)\n");
-                for (unsigned short us = 0; us < numberOfClients; us++)
-                {
-                    ClientInfo clientInfo;
-                    bsIn.Read(clientInfo.ID);
-                    bsIn.ReadBitsFromIntegerRange(clientInfo.ping, -1, 2046);
-                    if (clientInfo.ping >= 2046) clientInfo.ping = 9999;
-                    clientInfo.name = getClientNameByGUID(clientInfo.ID);
-                    mImpl->clientInfoList.push_back(clientInfo);
-                    //printf("[%hu] %s (%s)\t\t%d\n", us, clientInfo.name.c_str(), clientInfo.ID.ToString(), clientInfo.ping);
-
-                    if (clientInfo.ID == mImpl->myGUID)
-                    {
-                        mImpl->myPing = clientInfo.ping;
-                        window->setMyPing(mImpl->myPing);
-                    }
-
-                    //add latest ping to client map info
-                    auto it = mImpl->clientMap.find(clientInfo.ID);
-                    if (it != mImpl->clientMap.end()) {
-                        it->second.ping = clientInfo.ping;
-                    }
-
-                    window->setPing(clientInfo.ID.ToString(), clientInfo.ping);
-                }
+                receiveClientInfo(bsIn);
             }
             break;
         }
@@ -964,52 +1704,53 @@ void Network::update()
             if (mImpl->isHost)
             {
                 int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
-                RakNet::RakNetGUID guid = mImpl->hostClientIndexList[index];
+                bool known = mImpl->clientTable.isUsed(index);
+                RakNet::RakNetGUID guid = known ? mImpl->clientTable.get(index).ID : RakNet::UNASSIGNED_RAKNET_GUID;
 
                 RakNet::BitStream bsIn(packet->data, packet->length, false);
                 bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
                 int seatNumber = 0;
                 bsIn.ReadBitsFromIntegerRange(seatNumber, 0, (MAX_CLIENTS+1));
+                //an interest that cannot be read is taken as everything
+                SeatInterest interest;
+                interest.read(bsIn);
                 writeOutput(QString("Seat Request (%1) by: ").arg(seatNumber)+guid.ToString());
 
-                if (guid != RakNet::UNASSIGNED_RAKNET_GUID)
+                if (known)
                 {
                     //add latest seat info to client
                     if (seatNumber <= (getMaxClients()+1))
                     {
-                        auto it = mImpl->clientMap.find(guid);
-                        if (it != mImpl->clientMap.end())
+                        int crew = mImpl->clientTable.get(index).crew;
+                        bool seatRequestAccepted = true;
+                        if (crew == NO_CREW) {
+                            //the client has not said which aircraft it is in yet
+                            seatRequestAccepted = false;
+                        }
+                        else if (mImpl->clientTable.get(index).seatNumber == seatNumber) {
+                            seatRequestAccepted = false;
+                        }
+                        else if (mImpl->clientTable.getSeatSlot(crew, seatNumber) >= 0) {
+                            //Someone already occupying the seat requested
+                            seatRequestAccepted = false;
+                        }
+
+                        if (seatRequestAccepted)
                         {
-                            bool seatRequestAccepted = true;
-                            if (it->second.seatNumber == seatNumber) {
-                                seatRequestAccepted = false;
-                            }
-                            else if (seatNumber > 0)
-                            {
-                                for (auto& it2 : mImpl->clientMap)
-                                {
-                                    if (it2.second.seatNumber == seatNumber)
-                                    {
-                                        //Someone already occupying the seat requested
-                                        seatRequestAccepted = false;
-                                        break;
-                                    }
-                                }
+                            mImpl->clientTable.setSeat(index, seatNumber);
+                            updateSeatView(index, seatNumber, interest);
+                            uiChannel->setSeat(guid.ToString(), seatNumber);
+                            if (crew == mImpl->myCrew) {
+                                resetAnimationSeat(seatNumber);
                             }
 
-                            if (seatRequestAccepted)
+                            //Inform all clients of the crew, even the requestor
                             {
-                                it->second.seatNumber = seatNumber;
-                                window->setSeat(guid.ToString(), seatNumber);
-
-                                //Inform all clients, even the requestor
-                                {
-                                    RakNet::BitStream bsOut;
-                                    bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_SEAT_BROADCAST);
-                                    bsOut.Write(guid);
-                                    bsOut.WriteBitsFromIntegerRange(seatNumber, 0, (MAX_CLIENTS+1));
-                                    peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, RakNet::UNASSIGNED_RAKNET_GUID, true);
-                                }
+                                RakNet::BitStream bsOut;
+                                bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_SEAT_BROADCAST);
+                                bsOut.Write(guid);
+                                bsOut.WriteBitsFromIntegerRange(seatNumber, 0, (MAX_CLIENTS+1));
+                                sendToCrew(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, crew, RakNet::UNASSIGNED_SYSTEM_ADDRESS);
                             }
                         }
                     }
@@ -1034,9 +1775,16 @@ void Network::update()
                 {
                     emit receivedSeatChange(seatNumber);
                     mImpl->mySeat = seatNumber;
+
+                    //catch up on everything set while we were not seated
+                    if (seatNumber > 0) {
+                        requestMasterSyncHash();
+                    }
                 }
 
-                window->setSeat(guid.ToString(), seatNumber);
+                mImpl->clientTable.setSeat(mImpl->clientTable.findSlot(guid), seatNumber);
+                resetAnimationSeat(seatNumber);
+                uiChannel->setSeat(guid.ToString(), seatNumber);
             }
             break;
         }
@@ -1062,22 +1810,20 @@ void Network::update()
                 priority = READFROM(packetInfo,0,2);
                 reliability = READFROM(packetInfo,2,3);
 
-                emit receivedNetCommand(command);
-                writeOutput(QString("Net Command (%1)").arg(command));
+                if (mImpl->isHost) {
+                    //pass along to all other clients except the sender that want it
+                    CommandBatchEntry entry;
+                    entry.command = command;
+                    relayCommandPacket(packet, &entry, 1);
+                }
 
-                if (mImpl->isHost)
-                {
-                    //pass along to all other clients except the sender
-                    RakNet::BitStream bsOut;
-                    bsOut.Write((RakNet::MessageID)ID_NET_COMMAND);
-                    bsOut.Write(command);
-                    bsOut.Write(orderingChannel);
-                    //bsOut.WriteBits((const unsigned char *)&priorityChar, 2);
-                    //bsOut.WriteBits((const unsigned char *)&reliabilityChar, 3);
-                    //packetInfo = priorityChar | (unsigned char)(reliabilityChar << 2);
-                    bsOut.Write(packetInfo);
-                    mImpl->peer->Send(&bsOut, static_cast<PacketPriority>(priority), static_cast<PacketReliability>(reliability), orderingChannel, packet->systemAddress, true);
+                PACKET_TRACE(mImpl->packetTrace, PACKET_TRACE_RECEIVE, ID_NET_COMMAND, orderingChannel, packetInfo, command, 1, packet->length);
+                recordCommandLatency(BATCH_COMMAND);
+                recordOrderingStall(orderingChannel, reliability);
+                if (mImpl->fromMyCrew()) {
+                    emit receivedNetCommand(command);
                 }
+                NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, "Net Command (%u)", (unsigned int)command);
             }
             break;
         }
@@ -1086,7 +1832,6 @@ void Network::update()
            if (mImpl->mySeat > 0 || mImpl->isHost)
            {
                unsigned short command = 0;
-               unsigned char bitValue = 0;
                float value = 0.f;
                float valueRate = 0.f;
                char orderingChannel = 0;
@@ -1108,211 +1853,29 @@ void Network::update()
                reliability = READFROM(packetInfo,2,3);
                compressionTypeChar = READFROM(packetInfo,5,3);
 
-               NetCompressionTypes compressionType = static_cast<NetCompressionTypes>(compressionTypeChar);
-
-               switch (compressionType)
+               readCompressedValue(bsIn, compressionTypeChar, value);
+               if (hasValueRate(compressionTypeChar) && bsIn.GetNumberOfUnreadBits() > 7)
                {
-                   case BINARY:
-                       bitValue = bsIn.ReadBit();
-                       value = (bitValue > 0) ? 1.0f : 0.0f;
-                       break;
-                   case FLOAT16:
-                       bsIn.ReadFloat16(value, -1.0f, 1.0f);
-                       if (bsIn.GetNumberOfUnreadBits() > 7)
-                       {
-                           deadReckoned = true;
-                           bsIn.ReadFloat16(valueRate, -maxValueRate, maxValueRate);
-                           if (fabsf(valueRate) < 0.002f) {
-                               valueRate = 0.0f;
-                           }
-                       }
-                       break;
-                   case FLOAT32:
-                       bsIn.Read(value);
-                       if (bsIn.GetNumberOfUnreadBits() > 7)
-                       {
-                           deadReckoned = true;
-                           bsIn.Read(valueRate);
-                       }
-                       break;
-                   //case FLOAT64:
-                   //	bsIn.Read(dValue);
-                   //	break;
-                   case NEG_ONE_ZERO_ONE:
-                   {
-                       bsIn.ReadBits((unsigned char *)(&(bitValue)), 2);
-                       if (bitValue == 0) {
-                           value = -1.0f;
-                       }
-                       else if (bitValue == 1) {
-                           value = 0.0f;
-                       }
-                       else {
-                           value = 1.0f;
-                       }
-                       break;
-                   }
-                   case ZERO_HALF_ONE:
-                   {
-                       bsIn.ReadBits((unsigned char *)(&(bitValue)), 2);
-                       if (bitValue == 0) {
-                           value = 0.0f;
-                       }
-                       else if (bitValue == 1) {
-                           value = 0.5f;
-                       }
-                       else {
-                           value = 1.0f;
-                       }
-                       break;
-                   }
-                   case NEG_ONE_ZERO_HALF_ONE:
-                   {
-                       bsIn.ReadBits((unsigned char *)(&(bitValue)), 3);
-                       if (bitValue == 0) {
-                           value = -1.0f;
-                       }
-                       else if (bitValue == 1) {
-                           value = 0.0f;
-                       }
-                       else if (bitValue == 2) {
-                           value = 0.5f;
-                       }
-                       else {
-                           value = 1.0f;
-                       }
-                       break;
-                   }
-                   case NEG_TWO_NEG_ONE_ZERO_ONE:
-                   {
-                       bsIn.ReadBits((unsigned char *)(&(bitValue)), 3);
-                       if (bitValue == 0) {
-                           value = -2.0f;
-                       }
-                       else if (bitValue == 1) {
-                           value = -1.0f;
-                       }
-                       else if (bitValue == 2) {
-                           value = 0.0f;
-                       }
-                       else {
-                           value = 1.0f;
-                       }
-                       break;
-                   }
-                   default:
-                       bsIn.Read(value);
-                       break;
+                   deadReckoned = true;
+                   readCompressedValueRate(bsIn, compressionTypeChar, valueRate);
                }
 
-               emit receivedNetCommandValue(command, value, deadReckoned, valueRate);
-               writeOutput(QString("Net Command (%1): ").arg(command)+QString::number((double)value)+(deadReckoned ? QString(", ") + QString::number((double)valueRate) : ""));
+               if (mImpl->isHost) {
+                   //pass along to all other clients except the sender that want it
+                   CommandBatchEntry entry;
+                   entry.type = BATCH_COMMAND_VALUE;
+                   entry.command = command;
+                   relayCommandPacket(packet, &entry, 1);
+               }
 
-               if (mImpl->isHost)
-               {
-                   //pass along to all other clients except the sender
-                   RakNet::BitStream bsOut;
-                   bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_VALUE);
-                   bsOut.Write(orderingChannel);
-                   //bsOut.WriteBits((const unsigned char *)&priorityChar, 2);
-                   //bsOut.WriteBits((const unsigned char *)&reliabilityChar, 3);
-                   //bsOut.WriteBits((const unsigned char *)&compressionTypeChar, 3);
-                   //packetInfo = priorityChar | (unsigned char)(reliabilityChar << 2) | (unsigned char)(compressionTypeChar << 5);
-                   bsOut.Write(packetInfo);
-                   bsOut.Write(command);
-                   switch (compressionType)
-                   {
-                       case BINARY:
-                           value > 0.0f ? bsOut.Write1() : bsOut.Write0();
-                           break;
-                       case FLOAT16:
-                           bsOut.WriteFloat16(value, -1.0f, 1.0f);
-                           if (deadReckoned) {
-                               bsOut.WriteFloat16(valueRate, -maxValueRate, maxValueRate);
-                           }
-                           break;
-                       case FLOAT32:
-                           bsOut.Write(value);
-                           if (deadReckoned) {
-                               bsOut.Write(valueRate);
-                           }
-                           break;
-                       //case FLOAT64:
-                       //	bsOut.Write(dValue);
-                       //	break;
-                       case NEG_ONE_ZERO_ONE:
-                       {
-                           unsigned char bitValue = 0;
-                           if (value < 0.0f) {
-                               bitValue = 0;
-                           }
-                           else if (value == 0.0f) {
-                               bitValue = 1;
-                           }
-                           else {
-                               bitValue = 2;
-                           }
-                           bsOut.WriteBits((const unsigned char *)&bitValue, 2);
-                           break;
-                       }
-                       case ZERO_HALF_ONE:
-                       {
-                           unsigned char bitValue = 0;
-                           if (value == 0.0f) {
-                               bitValue = 0;
-                           }
-                           else if (value > 0.99999f) {
-                               bitValue = 2;
-                           }
-                           else {
-                               bitValue = 1;
-                           }
-                           bsOut.WriteBits((const unsigned char *)&bitValue, 2);
-                           break;
-                       }
-                       case NEG_ONE_ZERO_HALF_ONE:
-                       {
-                           unsigned char bitValue = 0;
-                           if (value < -0.99999f) {
-                               bitValue = 0;
-                           }
-                           else if (value == 0.0f) {
-                               bitValue = 1;
-                           }
-                           else if (value > 0.99999f) {
-                               bitValue = 3;
-                           }
-                           else {
-                               bitValue = 2;
-                           }
-                           bsOut.WriteBits((const unsigned char *)&bitValue, 3);
-                           break;
-                       }
-                       case NEG_TWO_NEG_ONE_ZERO_ONE:
-                       {
-                           unsigned char bitValue = 0;
-                           if (value < -1.99999f) {
-                               bitValue = 0;
-                           }
-                           else if (value < -0.99999f) {
-                               bitValue = 1;
-                           }
-                           else if (value == 0.0f) {
-                               bitValue = 2;
-                           }
-                           else if (value > 0.99999f) {
-                               bitValue = 3;
-                           }
-                           bsOut.WriteBits((const unsigned char *)&bitValue, 3);
-                           break;
-                       }
-                       default:
-                           bsOut.Write(value);
-                           break;
-                   }
-
-                   mImpl->peer->Send(&bsOut, static_cast<PacketPriority>(priority), static_cast<PacketReliability>(reliability), orderingChannel, packet->systemAddress, true);
+               PACKET_TRACE(mImpl->packetTrace, PACKET_TRACE_RECEIVE, ID_NET_COMMAND_VALUE, orderingChannel, packetInfo, command, 1, packet->length);
+               setCommandState(command, value);
+               recordCommandLatency(BATCH_COMMAND_VALUE);
+               recordOrderingStall(orderingChannel, reliability);
+               if (mImpl->fromMyCrew()) {
+                   emit receivedNetCommandValue(command, value, deadReckoned, valueRate);
                }
+               NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, deadReckoned ? "Net Command (%u): %g, %g" : "Net Command (%u): %g", (unsigned int)command, (double)value, (double)valueRate);
            }
            break;
         }
@@ -1323,176 +1886,709 @@ void Network::update()
                 unsigned short command = 0;
                 float value = 0.0f;
 
-                RakNet::BitStream bsIn(packet->data, packet->length, false);
+                RakNet::BitStream bsIn(packet->data, packet->length, false);
+
+                bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+                bsIn.Read(command);
+                bsIn.Read(value);
+
+                if (mImpl->isHost) {
+                    //pass along to all other clients except the sender that want it
+                    CommandBatchEntry entry;
+                    entry.type = BATCH_COMMAND_VALUE_CORRECTION;
+                    entry.command = command;
+                    relayPacket(packet, LOW_PRIORITY, RELIABLE, 0, &entry, 1);
+                }
+
+                setCommandState(command, value);
+                recordCommandLatency(BATCH_COMMAND_VALUE_CORRECTION);
+                if (mImpl->fromMyCrew()) {
+                    emit receivedNetCommandValue(command, value, false, 0.0f);
+                }
+                NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, "Net Command (%u): %g (Corrected)", (unsigned int)command, (double)value);
+            }
+            break;
+        }
+        case ID_NET_EVENT:
+        {
+            if (mImpl->mySeat > 0 || mImpl->isHost)
+            {
+                unsigned char eventID = 0;
+
+                RakNet::BitStream bsIn(packet->data, packet->length, false);
+
+                bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+                bsIn.Read(eventID);
+
+                if (mImpl->isHost) {
+                    //pass along to all other clients except the sender that want it
+                    CommandBatchEntry entry;
+                    entry.type = BATCH_EVENT;
+                    entry.eventID = eventID;
+                    relayPacket(packet, HIGH_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_EVENTS, &entry, 1);
+                }
+
+                recordCommandLatency(BATCH_EVENT);
+                recordOrderingStall(ORDERING_CHANNEL_EVENTS, RELIABLE_ORDERED);
+                if (mImpl->fromMyCrew()) {
+                    emit receivedNetEvent(eventID);
+                }
+                NETWORK_LOG(logger, LOG_DEBUG, LOG_EVENTS, "Net Event (%d)", (int)eventID);
+            }
+            break;
+        }
+        case ID_NET_EXTERNAL_ANIMATION:
+        case ID_NET_EXTERNAL_ANIMATION_CORRECTION:
+        case ID_NET_COCKPIT_ANIMATION:
+        case ID_NET_COCKPIT_ANIMATION_CORRECTION:
+        {
+            if (mImpl->mySeat > 0 || mImpl->isHost)
+            {
+                receiveAnimationFrame(packet);
+            }
+            break;
+        }
+        case ID_NET_COMMAND_BATCH:
+        {
+            if (mImpl->mySeat > 0 || mImpl->isHost)
+            {
+                RakNet::BitStream bsIn(packet->data, packet->length, false);
+                bsIn.IgnoreBytes(COMMAND_HEADER_SIZE);
+
+                //a batch coded by a profile we do not share can only come in before the host told its sender to stop
+                bool profileCoded = (packet->data[2] & BATCH_CODEC_PROFILE) != 0;
+                uint32_t batchProfile = 0;
+                if (profileCoded && (!bsIn.Read(batchProfile) || mImpl->codecProfile.empty() || batchProfile != mImpl->codecProfile.getFingerprint()))
+                {
+                    writeOutput(QString("<font color='red'>ERROR:</font> Command batch coded by aircraft codec profile %1, which is not loaded, dropped.")
+                                .arg(batchProfile, 8, 16, QChar('0')));
+                    if (mImpl->isHost) {
+                        relayCommandPacket(packet, nullptr, 0);
+                    }
+                    break;
+                }
+
+                std::vector<CommandBatchEntry> entries;
+                bool complete = CommandBatch::readEntries(bsIn, entries, profileCoded ? &mImpl->codecProfile : nullptr);
+                if (!complete) {
+                    writeOutput("<font color='red'>ERROR:</font> Truncated command batch, delivering the commands read so far.");
+                }
+                else if (!mImpl->isHost && (packet->data[2] & BATCH_CLIENT_INFO) != 0) {
+                    //the host appended the client info from the next whole byte
+                    bsIn.AlignReadToByteBoundary();
+                    receiveClientInfo(bsIn);
+                }
+
+                if (mImpl->isHost) {
+                    //pass along to all other clients except the sender that want any of it, or all of them if it could not be read
+                    relayCommandPacket(packet, complete ? entries.data() : nullptr, entries.size());
+                }
+
+                PACKET_TRACE(mImpl->packetTrace, PACKET_TRACE_RECEIVE, ID_NET_COMMAND_BATCH, packet->data[1], packet->data[2],
+                             entries.empty() ? PACKET_TRACE_NO_COMMAND : entries.front().command, entries.size(), packet->length);
+                recordOrderingStall((char)packet->data[1], READFROM(packet->data[2], 2, 3));
+
+                //the host keeps another crew's state but does not hand it to DCS
+                bool deliver = mImpl->fromMyCrew();
+                for (const auto& entry : entries)
+                {
+                    recordCommandLatency(entry.type);
+                    switch (entry.type)
+                    {
+                    case BATCH_COMMAND:
+                        if (deliver)
+                            emit receivedNetCommand(entry.command);
+                        NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, "Net Command (%u)", (unsigned int)entry.command);
+                        break;
+                    case BATCH_COMMAND_VALUE:
+                        setCommandState(entry.command, entry.value);
+                        if (deliver)
+                            emit receivedNetCommandValue(entry.command, entry.value, entry.deadReckoned, entry.valueRate);
+                        NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, entry.deadReckoned ? "Net Command (%u): %g, %g" : "Net Command (%u): %g", (unsigned int)entry.command, (double)entry.value, (double)entry.valueRate);
+                        break;
+                    case BATCH_COMMAND_VALUE_CORRECTION:
+                        setCommandState(entry.command, entry.value);
+                        if (deliver)
+                            emit receivedNetCommandValue(entry.command, entry.value, false, 0.0f);
+                        NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, "Net Command (%u): %g (Corrected)", (unsigned int)entry.command, (double)entry.value);
+                        break;
+                    case BATCH_EVENT:
+                        if (deliver)
+                            emit receivedNetEvent(entry.eventID);
+                        NETWORK_LOG(logger, LOG_DEBUG, LOG_EVENTS, "Net Event (%d)", (int)entry.eventID);
+                        break;
+                    }
+                }
+            }
+            break;
+        }
+        case ID_NET_CODEC_PROFILE:
+        {
+            //received by clients only
+            if (!mImpl->isHost)
+            {
+                RakNet::BitStream bsIn(packet->data, packet->length, false);
+                bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+                uint32_t fingerprint = 0;
+                bsIn.Read(fingerprint);
+
+                bool wasUsed = mImpl->useCodecProfile();
+                mImpl->setSessionCodecProfile(fingerprint);
+                if (mImpl->useCodecProfile() != wasUsed) {
+                    writeOutput(wasUsed ? "Aircraft codec profile no longer in use, not every seat loaded the same one." : "Aircraft codec profile in use.");
+                }
+                else if (!mImpl->codecProfile.empty() && !wasUsed) {
+                    writeOutput("Aircraft codec profile not in use, not every seat loaded the same one.");
+                }
+            }
+            break;
+        }
+        case ID_NET_COMMAND_MASTER_SYNC_HASH_REQUEST:
+        {
+            //received by the host only
+            if (mImpl->isHost)
+            {
+                RakNet::BitStream bsIn(packet->data, packet->length, false);
+                bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+                unsigned char level = 0;
+                bsIn.Read(level);
+
+                CommandStateTable& commandState = getSyncState(peer->GetIndexFromSystemAddress(packet->systemAddress));
+
+                RakNet::BitStream bsOut;
+                bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_MASTER_SYNC_HASH);
+                bsOut.Write(level);
+
+                if (level == 0)
+                {
+                    //root and group hashes
+                    bsOut.Write(commandState.getRootHash());
+                    for (unsigned int group = 0; group < SYNC_GROUP_COUNT; group++) {
+                        bsOut.Write(commandState.getGroupHash(group));
+                    }
+                }
+                else
+                {
+                    //bucket hashes of the requested groups
+                    std::vector<unsigned char> groups;
+                    unsigned char numGroups = 0;
+                    bsIn.Read(numGroups);
+                    for (unsigned char i = 0; i < numGroups; i++)
+                    {
+                        unsigned char group = 0;
+                        if (!bsIn.Read(group))
+                            break;
+                        if (group < SYNC_GROUP_COUNT)
+                            groups.push_back(group);
+                    }
+
+                    bsOut.Write((unsigned char)groups.size());
+                    for (unsigned char group : groups)
+                    {
+                        bsOut.Write(group);
+                        for (unsigned int i = 0; i < SYNC_BUCKETS_PER_GROUP; i++) {
+                            bsOut.Write(commandState.getBucketHash(group * SYNC_BUCKETS_PER_GROUP + i));
+                        }
+                    }
+                }
+
+                send(&bsOut, LOW_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_SYNC, packet->systemAddress, false);
+            }
+            break;
+        }
+        case ID_NET_COMMAND_MASTER_SYNC_HASH:
+        {
+            //received by seated clients only
+            if (!mImpl->isHost && mImpl->mySeat > 0)
+            {
+                RakNet::BitStream bsIn(packet->data, packet->length, false);
+                bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+                unsigned char level = 0;
+                bsIn.Read(level);
+
+                if (level == 0)
+                {
+                    uint32_t rootHash = 0;
+                    bsIn.Read(rootHash);
+                    if (rootHash == mImpl->commandState.getRootHash())
+                        break;
+
+                    //ask for the bucket hashes of every group that differs
+                    std::vector<unsigned char> groups;
+                    for (unsigned int group = 0; group < SYNC_GROUP_COUNT; group++)
+                    {
+                        uint32_t groupHash = 0;
+                        if (!bsIn.Read(groupHash))
+                            break;
+                        if (groupHash != mImpl->commandState.getGroupHash(group))
+                            groups.push_back((unsigned char)group);
+                    }
+
+                    if (!groups.empty())
+                    {
+                        RakNet::BitStream bsOut;
+                        bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_MASTER_SYNC_HASH_REQUEST);
+                        bsOut.Write((unsigned char)1);
+                        bsOut.Write((unsigned char)groups.size());
+                        for (unsigned char group : groups) {
+                            bsOut.Write(group);
+                        }
+                        send(&bsOut, LOW_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_SYNC, packet->systemAddress, false);
+                    }
+                }
+                else
+                {
+                    //ask for the contents of every bucket that differs
+                    std::vector<unsigned char> buckets;
+                    unsigned char numGroups = 0;
+                    bsIn.Read(numGroups);
+                    for (unsigned char i = 0; i < numGroups; i++)
+                    {
+                        unsigned char group = 0;
+                        if (!bsIn.Read(group) || group >= SYNC_GROUP_COUNT)
+                            break;
+                        for (unsigned int j = 0; j < SYNC_BUCKETS_PER_GROUP; j++)
+                        {
+                            unsigned int bucket = group * SYNC_BUCKETS_PER_GROUP + j;
+                            uint32_t bucketHash = 0;
+                            bsIn.Read(bucketHash);
+                            if (bucketHash != mImpl->commandState.getBucketHash(bucket))
+                                buckets.push_back((unsigned char)bucket);
+                        }
+                    }
+
+                    if (!buckets.empty())
+                    {
+                        RakNet::BitStream bsOut;
+                        bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_MASTER_SYNC_REQUEST);
+                        bsOut.Write((unsigned short)buckets.size());
+                        for (unsigned char bucket : buckets) {
+                            bsOut.Write(bucket);
+                        }
+                        send(&bsOut, LOW_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_SYNC, packet->systemAddress, false);
+                    }
+                }
+            }
+            break;
+        }
+        case ID_NET_COMMAND_MASTER_SYNC_REQUEST:
+        {
+            //received by the host only
+            if (mImpl->isHost)
+            {
+                RakNet::BitStream bsIn(packet->data, packet->length, false);
+                bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+                unsigned short numBuckets = 0;
+                bsIn.Read(numBuckets);
+                if (numBuckets > SYNC_BUCKET_COUNT)
+                    break;
+
+                std::vector<unsigned char> buckets;
+                for (unsigned short i = 0; i < numBuckets; i++)
+                {
+                    unsigned char bucket = 0;
+                    if (!bsIn.Read(bucket))
+                        break;
+                    buckets.push_back(bucket);
+                }
+
+                CommandStateTable& commandState = getSyncState(peer->GetIndexFromSystemAddress(packet->systemAddress));
+
+                RakNet::BitStream bsOut;
+                bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_MASTER_SYNC);
+                bsOut.Write((unsigned short)buckets.size());
+                for (unsigned char bucket : buckets)
+                {
+                    const std::vector<CommandState>& states = commandState.getBucket(bucket);
+                    bsOut.Write(bucket);
+                    bsOut.Write((unsigned short)states.size());
+                    for (const auto& state : states)
+                    {
+                        bsOut.Write(state.command);
+                        bsOut.Write(state.value);
+                    }
+                }
+
+                send(&bsOut, LOW_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_SYNC, packet->systemAddress, false);
+            }
+            break;
+        }
+        case ID_NET_COMMAND_MASTER_SYNC:
+        {
+            //received by seated clients only
+            if (!mImpl->isHost && mImpl->mySeat > 0)
+            {
+                RakNet::BitStream bsIn(packet->data, packet->length, false);
+                bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+                unsigned short numBuckets = 0;
+                bsIn.Read(numBuckets);
+
+                int numUpdated = 0;
+                for (unsigned short i = 0; i < numBuckets; i++)
+                {
+                    unsigned char bucket = 0;
+                    unsigned short numStates = 0;
+                    if (!bsIn.Read(bucket) || !bsIn.Read(numStates))
+                        break;
+
+                    std::vector<CommandState> states;
+                    states.reserve(numStates);
+                    bool complete = true;
+                    for (unsigned short j = 0; j < numStates; j++)
+                    {
+                        CommandState state;
+                        if (!bsIn.Read(state.command) || !bsIn.Read(state.value)) {
+                            complete = false;
+                            break;
+                        }
+
+                        float localValue = 0.0f;
+                        bool hasLocalValue = mImpl->commandState.get(state.command, localValue);
+                        if (mImpl->changedSinceSyncRequest.test(state.command))
+                        {
+                            //set after the host took its snapshot, so ours is newer
+                            if (hasLocalValue)
+                                state.value = localValue;
+                        }
+                        else if (!hasLocalValue || localValue != state.value)
+                        {
+                            emit receivedNetCommandValue(state.command, state.value, false, 0.0f);
+                            numUpdated++;
+                        }
+                        states.push_back(state);
+                    }
+                    if (!complete)
+                        break;
+
+                    //keep anything newer than the snapshot that the host did not have yet
+                    for (const auto& localState : mImpl->commandState.getBucket(bucket))
+                    {
+                        if (mImpl->changedSinceSyncRequest.test(localState.command))
+                            states.push_back(localState);
+                    }
+
+                    mImpl->commandState.setBucket(bucket, states);
+                }
+
+                if (numUpdated > 0) {
+                    NETWORK_LOG(logger, LOG_INFO, LOG_SYNC, "Master Sync: %d commands updated from the host", numUpdated);
+                }
+            }
+            break;
+        }
+        default:
+            writeOutput(QString("Message with identifier %1 has arrived.").arg(packet->data[0]));
+            break;
+        }
+    }
+    mImpl->packetCrew = mImpl->myCrew;
+
+    //run callbacks for network status changes
+    if (mImpl->isHost) {
+        mImpl->currentStatus = IS_HOSTING;
+    }
+    else {
+        mImpl->currentStatus = static_cast<ConnectionState>(mImpl->peer->GetConnectionState(mImpl->peer->GetSystemAddressFromIndex(0)));
+    }
+
+    if (mImpl->currentStatus != mImpl->lastStatus) {
+    }
+
+    mImpl->lastStatus = mImpl->currentStatus;
+
+    mImpl->currentTime = RakNet::GetTime();
+
+    //measure the clients' pings as host, and tell their crews about the ones that changed
+    RakNet::Time hostPingUpdateIntervalMS = 500; //every 0.5 second
+    if (mImpl->isHost)
+    {
+        if (mImpl->currentTime - mImpl->hostPingTimeCtr > hostPingUpdateIntervalMS)
+        {
+            updateClientInfo();
+            mImpl->hostPingTimeCtr = mImpl->currentTime;
+        }
+    }
+
+    //seated clients periodically check their command state against the host
+    if (!mImpl->isHost && mImpl->mySeat > 0 && mImpl->currentStatus == IS_CONNECTED)
+    {
+        if (mImpl->currentTime - mImpl->masterSyncTimeCtr > (RakNet::Time)MASTER_SYNC_CHECK_INTERVAL_MS) {
+            requestMasterSyncHash();
+        }
+    }
+
+    //statistics are only read as often as the GUI shows them
+    if ((mImpl->currentStatus == IS_CONNECTED || mImpl->isHost) && mImpl->statisticsSampler.isDue(mImpl->currentTime))
+    {
+        mImpl->statisticsSampler.sample(mImpl->peer, mImpl->currentTime);
+        const StatisticsSample& sample = mImpl->statisticsSampler.getLatest();
+        uiChannel->setStatistics(getNumClients(), sample.bandwidthSendRate, sample.bandwidthReceiveRate, sample.bandwidthSentTotal,
+                                 sample.bandwidthReceivedTotal, getConnectionTime(), sample.packetLoss);
+
+        mImpl->statisticsSampler.getHistory().getSamples(mImpl->statisticsHistory);
+        uiChannel->setStatisticsHistory(mImpl->statisticsHistory);
+    }
+
+    if (mImpl->currentTime - mImpl->commandLatencyTimeCtr > (RakNet::Time)COMMAND_LATENCY_PUBLISH_INTERVAL_MS)
+    {
+        if (mImpl->commandLatency.takeChanged())
+        {
+            mImpl->commandLatency.getSummary(mImpl->commandLatencySummary);
+            uiChannel->setCommandLatency(mImpl->commandLatencySummary);
+        }
+        if (mImpl->orderingStalls.takeChanged())
+        {
+            mImpl->orderingStalls.getSummary(mImpl->orderingStallSummary);
+            uiChannel->setOrderingStalls(mImpl->orderingStallSummary);
+        }
+        mImpl->orderingStalls.rotateBaseline();
+
+        unsigned int skipped = mImpl->deadReckoning.takeSkippedCount();
+        if (skipped > 0)
+            NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, "%u analog values within dead reckoning tolerance not sent", skipped);
+        if (mImpl->interestSkipped > 0)
+            NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, "%u command messages not forwarded to seats that do not use them", mImpl->interestSkipped);
+        mImpl->interestSkipped = 0;
+        mImpl->commandLatencyTimeCtr = mImpl->currentTime;
+    }
+
+    //a value DCS stopped reporting while it was within tolerance goes out once the heartbeat passed, as a correction
+    //without a rate, so receivers stop extrapolating it
+    mImpl->deadReckoningFlushed.clear();
+    mImpl->deadReckoning.flush(mImpl->currentTime, mImpl->deadReckoningFlushed);
+    for (const DeadReckoningSample& sample : mImpl->deadReckoningFlushed)
+        handleReceivedLocalCorrectionCommandValue(sample.command, sample.value);
+
+    //everything DCS sent since the last update goes out now, one message per send class
+    flushCommandBatches();
+    sendAnimationFrames();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::handleLocalConnected()
+{
+    if (mImpl->mySeat > 0)
+    {
+        emit receivedSeatChange(mImpl->mySeat);
+
+        //DCS may have joined after the session started
+        handleLocalMasterSyncRequest();
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::handleLocalMasterSyncRequest()
+{
+    if (mImpl->mySeat > 0 && mImpl->commandState.size() > 0)
+    {
+        std::vector<CommandState> states;
+        mImpl->commandState.getSnapshot(states);
+        emit receivedMasterSync(states);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::setCommandState(unsigned short command, float value)
+{
+    if (mImpl->isHost)
+    {
+        //the crew of the packet being handled, or mine for commands from DCS
+        int crew = mImpl->packetCrew;
+        CommandStateTable* crewState = mImpl->getCommandState(crew);
+        if (crewState == nullptr)
+            return;
+
+        crewState->set(command, value);
+        for (int slot = 0; slot < (int)mImpl->seatViews.size(); slot++)
+        {
+            Impl::SeatView* view = mImpl->seatViews[slot].get();
+            if (view && mImpl->clientTable.get(slot).crew == crew && view->interest.wantsCommand(command))
+                view->commandState.set(command, value);
+        }
+    }
+    else if (mImpl->myInterest.wantsCommand(command))
+    {
+        //the host compares our master sync against only the commands our seat wants
+        mImpl->commandState.set(command, value);
+        mImpl->changedSinceSyncRequest.set(command);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-                bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
-                bsIn.Read(command);
-                bsIn.Read(value);
+void Network::requestMasterSyncHash()
+{
+    //the reply compares against what we have now, so only later changes need protecting
+    mImpl->changedSinceSyncRequest.reset();
+    mImpl->masterSyncTimeCtr = mImpl->currentTime;
+
+    RakNet::BitStream bsOut;
+    bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_MASTER_SYNC_HASH_REQUEST);
+    bsOut.Write((unsigned char)0);
+    send(&bsOut, LOW_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_SYNC, mImpl->serverAddress, false);
+}
 
-                emit receivedNetCommandValue(command, value, false, 0.0f);
-                writeOutput(QString("Net Command (%1): ").arg(command)+QString::number((double)value)+" (Corrected)");
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-                if (mImpl->isHost)
-                {
-                    //pass along to all other clients except the sender
-                    RakNet::BitStream bsOut;
-                    bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_VALUE_CORRECTION);
-                    bsOut.Write(command);
-                    bsOut.Write(value);
-                    mImpl->peer->Send(&bsOut, LOW_PRIORITY, RELIABLE, 0, packet->systemAddress, true);
-                }
-            }
-            break;
+void Network::handleReceivedLocalAnimation(unsigned char animationType, const std::vector<AnimationArgument>& arguments)
+{
+    if (mImpl->mySeat > 0 && animationType < NUM_ANIMATION_TYPES)
+    {
+        if (mImpl->isHost)
+        {
+            //the host is bound by the ownership map like everyone else
+            mImpl->animationArguments = arguments;
+            filterAnimationArguments(animationType, mImpl->myCrew, mImpl->mySeat, mImpl->animationArguments);
+            mImpl->animationSenders[animationType].setArguments(mImpl->animationArguments);
         }
-        case ID_NET_EVENT:
+        else
         {
-            if (mImpl->mySeat > 0 || mImpl->isHost)
-            {
-                unsigned char eventID = 0;
+            mImpl->animationSenders[animationType].setArguments(arguments);
+        }
+    }
+}
 
-                RakNet::BitStream bsIn(packet->data, packet->length, false);
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-                bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
-                bsIn.Read(eventID);
+void Network::sendAnimationFrames()
+{
+    if (mImpl->mySeat <= 0 || (mImpl->currentStatus != IS_CONNECTED && mImpl->currentStatus != IS_HOSTING))
+        return;
 
-                emit receivedNetEvent(eventID);
-                writeOutput(QString("Net Event (%1)").arg((int)eventID));
+    for (int animationType = 0; animationType < NUM_ANIMATION_TYPES; animationType++)
+    {
+        AnimationSender& sender = mImpl->animationSenders[animationType];
 
-                if (mImpl->isHost)
-                {
-                    //pass along to all other clients except the sender
-                    RakNet::BitStream bsOut;
-                    bsOut.Write((RakNet::MessageID)ID_NET_EVENT);
-                    bsOut.Write(eventID);
-                    mImpl->peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_EVENTS, packet->systemAddress, true);
-                }
-            }
-            break;
-        }
-        default:
-            writeOutput(QString("Message with identifier %1 has arrived.").arg(packet->data[0]));
-            break;
-        }
-    }
+        bool keyframe = sender.needsKeyframe(mImpl->currentTime);
+        if (!keyframe && !sender.hasChanges())
+            continue;
 
-    //run callbacks for network status changes
-    if (mImpl->isHost) {
-        mImpl->currentStatus = IS_HOSTING;
-    }
-    else {
-        mImpl->currentStatus = static_cast<ConnectionState>(mImpl->peer->GetConnectionState(mImpl->peer->GetSystemAddressFromIndex(0)));
-    }
+        bool cockpit = (animationType == COCKPIT_ANIMATION);
+        RakNet::MessageID messageID;
+        if (keyframe)
+            messageID = cockpit ? ID_NET_COCKPIT_ANIMATION_CORRECTION : ID_NET_EXTERNAL_ANIMATION_CORRECTION;
+        else
+            messageID = cockpit ? ID_NET_COCKPIT_ANIMATION : ID_NET_EXTERNAL_ANIMATION;
+        char orderingChannel = cockpit ? ORDERING_CHANNEL_COCKPIT_ANIMATION : ORDERING_CHANNEL_EXTERNAL_ANIMATION;
+
+        RakNet::BitStream bsOut;
+        bsOut.Write(messageID);
+        bsOut.Write((unsigned char)mImpl->mySeat);
+        if (keyframe)
+            sender.writeKeyframe(bsOut, mImpl->currentTime);
+        else
+            sender.writeDelta(bsOut, mImpl->currentTime);
 
-    if (mImpl->currentStatus != mImpl->lastStatus) {
+        //deltas are sequenced on the keyframe's channel, so they never overtake it
+        PacketReliability reliability = keyframe ? RELIABLE_ORDERED : UNRELIABLE_SEQUENCED;
+        if (mImpl->isHost)
+            fanOut((const char*)bsOut.GetData(), (int)bsOut.GetNumberOfBytesUsed(), HIGH_PRIORITY, reliability, orderingChannel, mImpl->myCrew, RakNet::UNASSIGNED_SYSTEM_ADDRESS, nullptr, 0);
+        else
+            send(&bsOut, HIGH_PRIORITY, reliability, orderingChannel, mImpl->serverAddress, false);
     }
+}
 
-    mImpl->lastStatus = mImpl->currentStatus;
-
-    mImpl->currentTime = RakNet::GetTime();
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-    //update client info as host more often
-    RakNet::Time hostPingUpdateIntervalMS = 500; //every 0.5 second
-    if (mImpl->isHost)
-    {
-        if (mImpl->currentTime - mImpl->hostPingTimeCtr > hostPingUpdateIntervalMS)
-        {
-            mImpl->clientInfoList.clear();
-            {                
-                //add host info first
-                ClientInfo client;
-                client.ID = mImpl->myGUID;
-                client.ping = -1;
-                client.name = mImpl->client_name;
-                mImpl->clientInfoList.push_back(client);
-                //window->setPing(mImpl->myGUID.ToString(), client.ping);
-            }
-            for (auto const &it : mImpl->clientNameMap)
-            {
-                //add each client
-                ClientInfo client;
-                client.ID = it.first;
-                client.ping = peer->GetLastPing(client.ID);
-                client.name = getClientNameByGUID(client.ID);
-                mImpl->clientInfoList.push_back(client);
-                window->setPing(client.ID.ToString(), client.ping);
-            }
+void Network::receiveAnimationFrame(RakNet::Packet *packet)
+{
+    RakNet::MessageID messageID = packet->data[0];
+    bool cockpit = (messageID == ID_NET_COCKPIT_ANIMATION || messageID == ID_NET_COCKPIT_ANIMATION_CORRECTION);
+    bool keyframe = (messageID == ID_NET_COCKPIT_ANIMATION_CORRECTION || messageID == ID_NET_EXTERNAL_ANIMATION_CORRECTION);
+    unsigned char animationType = cockpit ? COCKPIT_ANIMATION : EXTERNAL_ANIMATION;
 
-            mImpl->hostPingTimeCtr = mImpl->currentTime;
-        }
-    }
+    RakNet::BitStream bsIn(packet->data, packet->length, false);
+    bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+    unsigned char seatNumber = 0;
+    unsigned char keyframeID = 0;
+    std::vector<AnimationArgument>& arguments = mImpl->animationArguments;
+    arguments.clear();
+    if (!bsIn.Read(seatNumber) || !AnimationReceiver::readFrame(bsIn, keyframeID, arguments))
+        return;
 
+    //seat numbers are only mine within my crew
+    if (seatNumber == 0 || (seatNumber == mImpl->mySeat && mImpl->fromMyCrew()))
+        return;
 
-    //periodically update each client with all the other client's info
-    //make sure each client gets a ping update about every 10 seconds
     if (mImpl->isHost)
     {
-        size_t numberOfClientsReceiving = mImpl->clientMap.size() - 1;
-        if (numberOfClientsReceiving > 0)
+        //frames from a seat the client no longer holds are stale
+        int slot = mImpl->peer->GetIndexFromSystemAddress(packet->systemAddress);
+        if (!mImpl->clientTable.isUsed(slot) || mImpl->clientTable.get(slot).seatNumber != seatNumber)
+            return;
+
+        char orderingChannel = cockpit ? ORDERING_CHANNEL_COCKPIT_ANIMATION : ORDERING_CHANNEL_EXTERNAL_ANIMATION;
+        PacketReliability reliability = keyframe ? RELIABLE_ORDERED : UNRELIABLE_SEQUENCED;
+
+        if (filterAnimationArguments(animationType, mImpl->packetCrew, seatNumber, arguments))
         {
-            RakNet::Time pingUpdateIntervalMS = 10000 / numberOfClientsReceiving;
-            if (mImpl->currentTime - mImpl->pingTimeCtr > pingUpdateIntervalMS)
-            {
-                unsigned short clientIndex = getNextClientIndex(mImpl->lastClientIndexUpdated);
-                RakNet::RakNetGUID clientGUID = mImpl->hostClientIndexList[clientIndex];
-                if (clientGUID != RakNet::UNASSIGNED_RAKNET_GUID)
-                {
-                    RakNet::BitStream bsOut;
-                    bsOut.Write((RakNet::MessageID)ID_NET_CLIENT_INFO);
-                    //Skip host info
-                    unsigned short numberOfClients = (unsigned short)mImpl->clientInfoList.size() - 1;
-                    bsOut.Write(numberOfClients);
-                    for (auto& clientInfo : mImpl->clientInfoList)
-                    {
-                        ClientInfo *client = &clientInfo;
-                        if (client->ID != mImpl->myGUID)
-                        {
-                            bsOut.Write(client->ID);
-                            bsOut.WriteBitsFromIntegerRange(client->ping, -1, 2046);
-                        }
-                    }
-                    mImpl->peer->Send(&bsOut, LOW_PRIORITY, UNRELIABLE, 0, clientGUID, false);
-                    mImpl->lastClientIndexUpdated = clientIndex;
-                }
-                mImpl->pingTimeCtr = mImpl->currentTime;
-            }
+            //pass along only what this seat owns
+            RakNet::BitStream bsOut;
+            bsOut.Write(messageID);
+            bsOut.Write(seatNumber);
+            AnimationSender::writeFrame(bsOut, keyframeID, arguments);
+            fanOut((const char*)bsOut.GetData(), (int)bsOut.GetNumberOfBytesUsed(), HIGH_PRIORITY, reliability, orderingChannel, mImpl->packetCrew, packet->systemAddress, nullptr, 0);
+        }
+        else
+        {
+            //pass along to all other seated clients of the crew except the sender
+            relayPacket(packet, HIGH_PRIORITY, reliability, orderingChannel, nullptr, 0);
         }
+
+        if (!mImpl->fromMyCrew())
+            return;
     }
 
-    int numClients = 0;
-    float myPacketLoss = 0;
-    uint64_t bandwidthSendRate = 0;
-    uint64_t bandwidthReceiveRate = 0;
-    uint64_t bandwidthSentTotal = 0;
-    uint64_t bandwidthReceivedTotal = 0;
-    uint64_t connectionTime = 0;
+    AnimationReceiver& receiver = mImpl->animationReceivers[animationType][seatNumber];
+    std::vector<AnimationArgument>& changedArguments = mImpl->changedAnimationArguments;
+    changedArguments.clear();
+    if (keyframe)
+        receiver.applyKeyframe(keyframeID, arguments, changedArguments);
+    else
+        receiver.applyDelta(keyframeID, arguments, changedArguments);
 
-    if (mImpl->currentStatus == IS_CONNECTED || mImpl->isHost)
-    {
-        numClients = getNumClients();
+    if (!changedArguments.empty()) {
+        emit receivedNetAnimation(animationType, seatNumber, changedArguments);
+    }
+}
 
-        bandwidthSendRate = getRecentBandwidth(ACTUAL_BYTES_SENT);
-        bandwidthReceiveRate = getRecentBandwidth(ACTUAL_BYTES_RECEIVED);
-        bandwidthSentTotal = getBandwidth(ACTUAL_BYTES_SENT);
-        bandwidthReceivedTotal = getBandwidth(ACTUAL_BYTES_RECEIVED);
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-        connectionTime = getConnectionTime();
-        if (!mImpl->isHost) {
-            myPacketLoss = getMyRecentPacketLoss();
+bool Network::filterAnimationArguments(unsigned char animationType, int crew, int seatNumber, std::vector<AnimationArgument>& arguments)
+{
+    std::map<unsigned short, int>* crewOwners = mImpl->getAnimationOwners(crew, animationType);
+    if (crewOwners == nullptr)
+        return false;
+
+    //an argument belongs to the first seat of the crew to send it, until that seat is left empty
+    std::map<unsigned short, int>& owners = *crewOwners;
+    size_t numArguments = arguments.size();
+    arguments.erase(std::remove_if(arguments.begin(), arguments.end(), [&](const AnimationArgument& arg) {
+        auto it = owners.find(arg.argument);
+        if (it == owners.end() || mImpl->clientTable.getSeatSlot(crew, it->second) < 0)
+        {
+            owners[arg.argument] = seatNumber;
+            return false;
         }
+        return it->second != seatNumber;
+    }), arguments.end());
 
-        window->setStatistics(numClients, bandwidthSendRate, bandwidthReceiveRate, bandwidthSentTotal, bandwidthReceivedTotal, connectionTime, myPacketLoss);
-    }
-
-    mImpl->statisticsUpdated = false;
+    return arguments.size() != numArguments;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void Network::handleLocalConnected()
+void Network::resetAnimationSeat(int seatNumber)
 {
-    if (mImpl->mySeat > 0)
+    for (int i = 0; i < NUM_ANIMATION_TYPES; i++)
     {
-        emit receivedSeatChange(mImpl->mySeat);
+        mImpl->animationReceivers[i].erase(seatNumber);
+
+        //a new occupant has none of our arguments yet
+        mImpl->animationSenders[i].requestKeyframe();
     }
 }
 
@@ -1504,13 +2600,10 @@ void Network::handleReceivedLocalEvent(unsigned char eventID)
     {
         if (mImpl->currentStatus == IS_CONNECTED || mImpl->isHost)
         {
-            RakNet::BitStream bsOut;
-            bsOut.Write((RakNet::MessageID)ID_NET_EVENT);
-            bsOut.Write(eventID);
-
-            //if host, broadcast to everyone, else send to host only
-            RakNet::SystemAddress skipAddress = mImpl->isHost ? RakNet::UNASSIGNED_SYSTEM_ADDRESS : mImpl->peer->GetSystemAddressFromIndex(0);
-            mImpl->peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_EVENTS, skipAddress, mImpl->isHost);
+            CommandBatch& batch = getCommandBatch(HIGH_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_EVENTS);
+            batch.addEvent(eventID);
+            if (batch.full())
+                sendCommandBatch(batch);
         }
     }
 }
@@ -1523,21 +2616,10 @@ void Network::handleReceivedLocalCommand(unsigned short command, unsigned char p
     {
         if (mImpl->currentStatus == IS_CONNECTED || mImpl->isHost)
         {
-            unsigned char compressionType = BINARY;
-
-            RakNet::BitStream bsOut;
-            bsOut.Write((RakNet::MessageID)ID_NET_COMMAND);
-            bsOut.Write(orderingChannel);
-            //bsOut.WriteBits((const unsigned char *)&priorityChar, 2);
-            //bsOut.WriteBits((const unsigned char *)&reliabilityChar, 3);
-            //bsOut.WriteBits((const unsigned char *)&compressionTypeChar, 3);
-            unsigned char packetInfo = priority | (unsigned char)(reliability << 2) | (unsigned char)(compressionType << 5);
-            bsOut.Write(packetInfo);
-            bsOut.Write(command);
-
-            //if host, broadcast to everyone, else send to host only
-            RakNet::SystemAddress skipAddress = mImpl->isHost ? RakNet::UNASSIGNED_SYSTEM_ADDRESS : mImpl->peer->GetSystemAddressFromIndex(0);
-            mImpl->peer->Send(&bsOut, static_cast<PacketPriority>(priority), static_cast<PacketReliability>(reliability), orderingChannel, skipAddress, mImpl->isHost);
+            CommandBatch& batch = getCommandBatch(priority, reliability, mImpl->orderingChannelMap.getChannel(command, orderingChannel));
+            batch.addCommand(command);
+            if (batch.full())
+                sendCommandBatch(batch);
         }
     }
 }
@@ -1550,113 +2632,17 @@ void Network::handleReceivedLocalCommandValue(unsigned short command, unsigned c
     {
         if (mImpl->currentStatus == IS_CONNECTED || mImpl->isHost)
         {
-            RakNet::BitStream bsOut;
-            bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_VALUE);
-            bsOut.Write(orderingChannel);
-            //bsOut.WriteBits((const unsigned char *)&priorityChar, 2);
-            //bsOut.WriteBits((const unsigned char *)&reliabilityChar, 3);
-            //bsOut.WriteBits((const unsigned char *)&compressionTypeChar, 3);
-            unsigned char packetInfo = priority | (unsigned char)(reliability << 2) | (unsigned char)(compressionType << 5);
-            bsOut.Write(packetInfo);
-            bsOut.Write(command);
-
-            switch (compressionType)
-            {
-                case BINARY:
-                    value > 0.0f ? bsOut.Write1() : bsOut.Write0();
-                    break;
-                case FLOAT16:
-                    bsOut.WriteFloat16(value, -1.0f, 1.0f);
-                    if (deadReckoned) {
-                        bsOut.WriteFloat16(valueRate, -maxValueRate, maxValueRate);
-                    }
-                    break;
-                case FLOAT32:
-                    bsOut.Write(value);
-                    if (deadReckoned) {
-                        bsOut.Write(valueRate);
-                    }
-                    break;
-                //case FLOAT64:
-                //	bsOut.Write(dValue);
-                //	break;
-                case NEG_ONE_ZERO_ONE:
-                {
-                    unsigned char bitValue = 0;
-                    if (value < 0.0f) {
-                        bitValue = 0;
-                    }
-                    else if (value == 0.0f) {
-                        bitValue = 1;
-                    }
-                    else {
-                        bitValue = 2;
-                    }
-                    bsOut.WriteBits((const unsigned char *)&bitValue, 2);
-                    break;
-                }
-                case ZERO_HALF_ONE:
-                {
-                    unsigned char bitValue = 0;
-                    if (value == 0.0f) {
-                        bitValue = 0;
-                    }
-                    else if (value > 0.99999f) {
-                        bitValue = 2;
-                    }
-                    else {
-                        bitValue = 1;
-                    }
-                    bsOut.WriteBits((const unsigned char *)&bitValue, 2);
-                    break;
-                }
-                case NEG_ONE_ZERO_HALF_ONE:
-                {
-                    unsigned char bitValue = 0;
-                    if (value < -0.99999f) {
-                        bitValue = 0;
-                    }
-                    else if (value == 0.0f) {
-                        bitValue = 1;
-                    }
-                    else if (value > 0.99999f) {
-                        bitValue = 3;
-                    }
-                    else {
-                        bitValue = 2;
-                    }
-                    bsOut.WriteBits((const unsigned char *)&bitValue, 3);
-                    break;
-                }
-                case NEG_TWO_NEG_ONE_ZERO_ONE:
-                {
-                    unsigned char bitValue = 0;
-                    if (value < -1.99999f) {
-                        bitValue = 0;
-                    }
-                    else if (value < -0.99999f) {
-                        bitValue = 1;
-                    }
-                    else if (value == 0.0f) {
-                        bitValue = 2;
-                    }
-                    else if (value > 0.99999f) {
-                        bitValue = 3;
-                    }
-                    bsOut.WriteBits((const unsigned char *)&bitValue, 3);
-                    break;
-                }
-                default:
-                    bsOut.Write(value);
-                    break;
-            }
-
-            bsOut.PrintBits();
-
-            //if host, broadcast to everyone, else send to host only
-            RakNet::SystemAddress skipAddress = mImpl->isHost ? RakNet::UNASSIGNED_SYSTEM_ADDRESS : mImpl->peer->GetSystemAddressFromIndex(0);
-            std::cout << "isHost = " << mImpl->isHost << ", skipAddress = " << skipAddress.ToString(true,':') << std::endl;;
-            mImpl->peer->Send(&bsOut, static_cast<PacketPriority>(priority), static_cast<PacketReliability>(reliability), orderingChannel, skipAddress, mImpl->isHost);
+            //receivers extrapolate the last value sent, which may still be close enough. The command state only takes
+            //what was sent, as the master sync compares it with what the receivers got.
+            float sentValue = value;
+            if (!mImpl->deadReckoning.update(command, compressionType, value, deadReckoned, valueRate, sentValue, RakNet::GetTime()))
+                return;
+            setCommandState(command, sentValue);
+
+            CommandBatch& batch = getCommandBatch(priority, reliability, mImpl->orderingChannelMap.getChannel(command, orderingChannel));
+            batch.addCommandValue(command, compressionType, value, deadReckoned, valueRate);
+            if (batch.full())
+                sendCommandBatch(batch);
         }
     }
 }
@@ -1669,18 +2655,132 @@ void Network::handleReceivedLocalCorrectionCommandValue(unsigned short command,
     {
         if (mImpl->currentStatus == IS_CONNECTED || mImpl->isHost)
         {
+            setCommandState(command, value);
 
-            RakNet::BitStream bsOut;
-            bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_VALUE_CORRECTION);
+            CommandBatch& batch = getCommandBatch(LOW_PRIORITY, RELIABLE, 0);
+            batch.addCorrection(command, value);
+            if (batch.full())
+                sendCommandBatch(batch);
+        }
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+CommandBatch& Network::getCommandBatch(unsigned char priority, unsigned char reliability, char orderingChannel)
+{
+    for (auto& batch : mImpl->commandBatches)
+    {
+        if (batch.getPriority() == priority && batch.getReliability() == reliability && batch.getOrderingChannel() == orderingChannel)
+        {
+            if (batch.empty())
+                batch.setIngressTime(RakNet::GetTime());
+            return batch;
+        }
+    }
+
+    mImpl->commandBatches.push_back(CommandBatch(priority, reliability, orderingChannel));
+    mImpl->commandBatches.back().setIngressTime(RakNet::GetTime());
+    return mImpl->commandBatches.back();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::flushCommandBatches()
+{
+    for (auto& batch : mImpl->commandBatches)
+    {
+        if (!batch.empty())
+            sendCommandBatch(batch);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::sendCommandBatch(CommandBatch& batch)
+{
+    unsigned char priority = batch.getPriority();
+    unsigned char reliability = batch.getReliability();
+    char orderingChannel = batch.getOrderingChannel();
+    unsigned char packetInfo = priority | (unsigned char)(reliability << 2);
+
+    RakNet::BitStream bsOut;
+
+    //RakNet converts an ID_TIMESTAMP time into the receiver's clock on every hop, the host's relay included
+    bsOut.Write((RakNet::MessageID)ID_TIMESTAMP);
+    bsOut.Write(batch.getIngressTime());
+    bsOut.Write((unsigned char)mImpl->mySeat);
 
-            bsOut.Write(command);
-            bsOut.Write(value);
+    //values of profile commands are only smaller in a batch, which is the only message with the profile flag
+    const CommandCodecProfile* codecProfile = mImpl->useCodecProfile() ? &mImpl->codecProfile : nullptr;
+    const CommandBatchEntry& first = batch.getEntries().front();
+    bool profileValue = codecProfile && first.type == BATCH_COMMAND_VALUE && codecProfile->find(first.command);
+
+    if (batch.size() == 1 && !profileValue)
+    {
+        //a lone entry is smaller in its own message type
+        const CommandBatchEntry& entry = batch.getEntries().front();
+        switch (entry.type)
+        {
+        case BATCH_COMMAND:
+        case BATCH_COMMAND_VALUE:
+        {
+            unsigned char compressionType = (entry.type == BATCH_COMMAND) ? (unsigned char)BINARY : entry.compressionType;
+            bsOut.Write((RakNet::MessageID)((entry.type == BATCH_COMMAND) ? ID_NET_COMMAND : ID_NET_COMMAND_VALUE));
+            bsOut.Write(orderingChannel);
+            //bsOut.WriteBits((const unsigned char *)&priorityChar, 2);
+            //bsOut.WriteBits((const unsigned char *)&reliabilityChar, 3);
+            //bsOut.WriteBits((const unsigned char *)&compressionTypeChar, 3);
+            packetInfo |= (unsigned char)(compressionType << 5);
+            bsOut.Write(packetInfo);
+            bsOut.Write(entry.command);
 
-            //if host, broadcast to everyone, else send to host only
-            RakNet::SystemAddress skipAddress = mImpl->isHost ? RakNet::UNASSIGNED_SYSTEM_ADDRESS : mImpl->peer->GetSystemAddressFromIndex(0);
-            mImpl->peer->Send(&bsOut, LOW_PRIORITY, RELIABLE, 0, skipAddress, mImpl->isHost);
+            if (entry.type == BATCH_COMMAND_VALUE)
+            {
+                writeCompressedValue(bsOut, compressionType, entry.value);
+                if (entry.deadReckoned) {
+                    writeCompressedValueRate(bsOut, compressionType, entry.valueRate);
+                }
+            }
+            break;
+        }
+        case BATCH_COMMAND_VALUE_CORRECTION:
+            bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_VALUE_CORRECTION);
+            bsOut.Write(entry.command);
+            bsOut.Write(entry.value);
+            break;
+        case BATCH_EVENT:
+            bsOut.Write((RakNet::MessageID)ID_NET_EVENT);
+            bsOut.Write(entry.eventID);
+            break;
         }
     }
+    else
+    {
+        //same header as ID_NET_COMMAND so the host can relay it without decoding
+        if (codecProfile)
+            packetInfo |= BATCH_CODEC_PROFILE;
+
+        bsOut.Write((RakNet::MessageID)ID_NET_COMMAND_BATCH);
+        bsOut.Write(orderingChannel);
+        bsOut.Write(packetInfo);
+        if (codecProfile)
+            bsOut.Write(codecProfile->getFingerprint());
+        batch.writeEntries(bsOut, codecProfile);
+    }
+
+    PACKET_TRACE(mImpl->packetTrace, PACKET_TRACE_SEND, bsOut.GetData()[COMMAND_STAMP_SIZE], orderingChannel, packetInfo,
+                 (batch.getEntries().front().type == BATCH_EVENT) ? PACKET_TRACE_NO_COMMAND : batch.getEntries().front().command,
+                 batch.size(), bsOut.GetNumberOfBytesUsed());
+
+    //if host, send to every seat that wants any of it, else send to host only
+    if (mImpl->isHost)
+        fanOut((const char*)bsOut.GetData(), (int)bsOut.GetNumberOfBytesUsed(), static_cast<PacketPriority>(priority), static_cast<PacketReliability>(reliability),
+               orderingChannel, mImpl->myCrew, RakNet::UNASSIGNED_SYSTEM_ADDRESS, batch.getEntries().data(), batch.size());
+    else
+        send(&bsOut, static_cast<PacketPriority>(priority), static_cast<PacketReliability>(reliability), orderingChannel, mImpl->peer->GetSystemAddressFromIndex(0), false);
+
+    batch.clear();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -1737,11 +2837,8 @@ RakNet::Time Network::getConnectionTime()
         return mImpl->currentTime - mImpl->serverStartTime;
     else if (mImpl->currentStatus == IS_CONNECTED)
     {
-        if (!mImpl->statisticsUpdated)
-        {
-            if (mImpl->peer->GetStatistics(0, mImpl->myStatistics))
-                mImpl->statisticsUpdated = true;
-        }
+        if (!mImpl->peer->GetStatistics(0, mImpl->myStatistics))
+            return 0;
         return (mImpl->currentTime - (RakNet::Time)(mImpl->myStatistics->connectionStartTime / 1000));
     }
     else return 0;
@@ -1752,7 +2849,7 @@ RakNet::Time Network::getConnectionTime()
 int Network::getNumClients() const
 {
     if (mImpl->currentStatus == IS_CONNECTED || mImpl->isHost) {
-        return (int)mImpl->clientMap.size();
+        return (int)mImpl->clientTable.size();
     }
     else return 0;
 }
@@ -1795,17 +2892,19 @@ int Network::getMaxClients() const
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void Network::getUpdateStatistics(RakNet::TickStatistics* stats) const
+{
+    mImpl->peer->GetTickStatistics(stats);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 float Network::getMyPacketLoss()
 {
     if (mImpl->currentStatus == IS_CONNECTED)
     {
-        if (!mImpl->statisticsUpdated)
-        {
-            if (mImpl->peer->GetStatistics(0, mImpl->myStatistics))
-                mImpl->statisticsUpdated = true;
-            else
-                return 0;
-        }
+        if (!mImpl->peer->GetStatistics(0, mImpl->myStatistics))
+            return 0;
         return mImpl->myStatistics->packetlossTotal;
     }
     else return 0;
@@ -1817,13 +2916,8 @@ float Network::getMyRecentPacketLoss()
 {
     if (mImpl->currentStatus == IS_CONNECTED)
     {
-        if (!mImpl->statisticsUpdated)
-        {
-            if (mImpl->peer->GetStatistics(0, mImpl->myStatistics))
-                mImpl->statisticsUpdated = true;
-            else
-                return 0;
-        }
+        if (!mImpl->peer->GetStatistics(0, mImpl->myStatistics))
+            return 0;
         return mImpl->myStatistics->packetlossLastSecond;
     }
     else return 0;
@@ -1835,24 +2929,15 @@ uint64_t Network::getBandwidth(ConnectionMetrics metric)
 {
     if (mImpl->currentStatus == IS_CONNECTED)
     {
-        if (!mImpl->statisticsUpdated)
-        {
-            if (mImpl->peer->GetStatistics(0, mImpl->myStatistics))
-                mImpl->statisticsUpdated = true;
-            else
-                return 0;
-        }
+        if (!mImpl->peer->GetStatistics(0, mImpl->myStatistics))
+            return 0;
         return mImpl->myStatistics->runningTotal[metric];
     }
     else if (mImpl->isHost)
     {
         if (mImpl->peer->NumberOfConnections() > 0)
         {
-            if (!mImpl->statisticsUpdated)
-            {
-                mImpl->myStatistics = mImpl->peer->GetStatistics(RakNet::UNASSIGNED_SYSTEM_ADDRESS, mImpl->myStatistics);
-                mImpl->statisticsUpdated = true;
-            }
+            mImpl->myStatistics = mImpl->peer->GetStatistics(RakNet::UNASSIGNED_SYSTEM_ADDRESS, mImpl->myStatistics);
             return mImpl->myStatistics->runningTotal[metric];
         }
         else
@@ -1867,24 +2952,15 @@ uint64_t Network::getRecentBandwidth(ConnectionMetrics metric)
 {
     if (mImpl->currentStatus == IS_CONNECTED)
     {
-        if (!mImpl->statisticsUpdated)
-        {
-            if (mImpl->peer->GetStatistics(0, mImpl->myStatistics))
-                mImpl->statisticsUpdated = true;
-            else
-                return 0;
-        }
+        if (!mImpl->peer->GetStatistics(0, mImpl->myStatistics))
+            return 0;
         return mImpl->myStatistics->valueOverLastSecond[metric];
     }
     else if (mImpl->isHost)
     {
         if (mImpl->peer->NumberOfConnections() > 0)
         {
-            if (!mImpl->statisticsUpdated)
-            {
-                mImpl->myStatistics = mImpl->peer->GetStatistics(RakNet::UNASSIGNED_SYSTEM_ADDRESS, mImpl->myStatistics);
-                mImpl->statisticsUpdated = true;
-            }
+            mImpl->myStatistics = mImpl->peer->GetStatistics(RakNet::UNASSIGNED_SYSTEM_ADDRESS, mImpl->myStatistics);
             return mImpl->myStatistics->valueOverLastSecond[metric];
         }
         else
@@ -1895,14 +2971,11 @@ uint64_t Network::getRecentBandwidth(ConnectionMetrics metric)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-std::string Network::getClientNameByGUID(RakNet::RakNetGUID guid) const
+const char* Network::getClientNameByGUID(const RakNet::RakNetGUID& guid) const
 {
-    if (guid != RakNet::UNASSIGNED_RAKNET_GUID && mImpl->clientNameMap.size() > 0)
-    {
-        const auto& it = mImpl->clientNameMap.find(guid);
-        if (it != mImpl->clientNameMap.end()) {
-            return it->second;
-        }
+    int slot = mImpl->clientTable.findSlot(guid);
+    if (slot >= 0) {
+        return mImpl->clientTable.get(slot).name.C_String();
     }
 
     return "Unknown Client";
@@ -1910,11 +2983,11 @@ std::string Network::getClientNameByGUID(RakNet::RakNetGUID guid) const
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-Client* Network::getClientByGUID(RakNet::RakNetGUID guid) const
+Client* Network::getClientByGUID(const RakNet::RakNetGUID& guid) const
 {
-    auto it = mImpl->clientMap.find(guid);
-    if (it != mImpl->clientMap.end()) {
-        return &it->second;
+    int slot = mImpl->clientTable.findSlot(guid);
+    if (slot >= 0) {
+        return &mImpl->clientTable.get(slot);
     }
 
     return nullptr;
@@ -1984,6 +3057,15 @@ void Network::setMyClientName(std::string clientName)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void Network::setTickTimeMS(int time_ms)
+{
+    time_ms = (time_ms > MAX_TICK_TIME_MS ? MAX_TICK_TIME_MS : time_ms);
+    time_ms = (time_ms < MIN_TICK_TIME_MS ? MIN_TICK_TIME_MS : time_ms);
+    mImpl->serverConfig.tick_time_ms = time_ms;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void Network::setTimeoutTimeMS(int time_ms)
 {
     time_ms = (time_ms > MAX_TIMEOUT_TIME_MS ? MAX_TICK_TIME_MS : time_ms);
@@ -2013,9 +3095,27 @@ void Network::setMyMaxOutgoingSpeedPerConnection(unsigned long long bitsPerSecon
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-const std::vector<ClientInfo>& Network::getClientInfo() const
+void Network::setCrew(int crew)
+{
+    crew = (crew >= MAX_CREWS ? MAX_CREWS - 1 : crew);
+    crew = (crew < 0 ? 0 : crew);
+    mImpl->crewSetting = crew;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Network::setUpdateWorkers(int count)
+{
+    count = (count > MAX_UPDATE_WORKERS ? MAX_UPDATE_WORKERS : count);
+    count = (count < 0 ? 0 : count);
+    mImpl->updateWorkers = count;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const ClientTable& Network::getClientTable() const
 {
-    return mImpl->clientInfoList;
+    return mImpl->clientTable;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -2033,7 +3133,7 @@ unsigned short Network::getNextClientIndex(unsigned short index)
             if (nextIndex >= MAX_CLIENTS)
                 nextIndex = 0;
 
-            if (mImpl->hostClientIndexList[nextIndex] != RakNet::UNASSIGNED_RAKNET_GUID)
+            if (mImpl->clientTable.isUsed(nextIndex))
             {
                 return nextIndex;
             }
@@ -2056,11 +3156,9 @@ RakNet::RakNetGUID Network::getNextClientGUID(RakNet::RakNetGUID guid)
         {
             if (nextIndex >= MAX_CLIENTS)
                 nextIndex = 0;
-            RakNet::RakNetGUID guid = mImpl->hostClientIndexList[nextIndex];
-
-            if (guid != RakNet::UNASSIGNED_RAKNET_GUID)
+            if (mImpl->clientTable.isUsed(nextIndex))
             {
-                return guid;
+                return mImpl->clientTable.get(nextIndex).ID;
             }
 
             nextIndex++;
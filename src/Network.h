@@ -20,6 +20,9 @@ INCLUDES
 #include <string>
 #include <vector>
 
+#include "AnimationStream.h"
+#include "ClientTable.h"
+#include "CommandStateTable.h"
 #include "NetworkTypes.h"
 #include "PacketPriority.h"
 
@@ -46,15 +49,39 @@ namespace Network {
     static const unsigned long long MAX_SPEED_BITS = 1073741824; //1gbps
 
     static const int MAX_CLIENT_NAME_LENGTH = 32;
+
+    //layout of the copilot messages, bumped with every change to them. The host turns away clients of another version,
+    //and clients leave hosts of another version.
+    static const unsigned short PROTOCOL_VERSION = 3;
+
+    static const int MAX_CREWS = 32; //independent aircraft one host can serve, each with its own seats and command state
+    static const int NO_CREW = -1; //host only, a client that has not said which crew it flies with yet
+
+    static const int MAX_UPDATE_WORKERS = 8; //threads besides RakNet's own that share its per connection updates when hosting
+
+    static const int MASTER_SYNC_CHECK_INTERVAL_MS = 5000; //how often a seated client compares its command state with the host
 }
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 FORWARD DECLARATIONS
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
-class MainWindow;
+namespace RakNet {
+class BitStream;
+class SignaledEvent;
+struct TickStatistics;
+}
 
 namespace Network {
+
+class CommandBatch;
+struct CommandBatchEntry;
+class CommandStateTable;
+class Logger;
+class SeatInterest;
+class SessionRecorder;
+class UiChannel;
+
 struct ServerConfig
 {
     int max_clients = 8;
@@ -63,22 +90,6 @@ struct ServerConfig
     int port = 39640;
 };
 
-struct ClientInfo
-{
-    RakNet::RakNetGUID ID = RakNet::UNASSIGNED_RAKNET_GUID;
-    std::string name = "Unknown Client";
-    int ping = -1;
-};
-
-
-struct Client
-{
-    RakNet::RakNetGUID ID = RakNet::UNASSIGNED_RAKNET_GUID;
-    RakNet::RakString name = "Unknown Client";
-    int seatNumber = 0;
-    int ping = -1;
-};
-
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -102,6 +113,8 @@ signals:
     void receivedNetCommand(unsigned short command);
     void receivedNetCommandValue(unsigned short command, float value, bool deadReckoned, float valueRate);
     void receivedNetEvent(unsigned char eventID);
+    void receivedMasterSync(const std::vector<CommandState>& states);
+    void receivedNetAnimation(unsigned char animationType, int seatNumber, const std::vector<AnimationArgument>& arguments);
 
 public slots:
     void handleLocalConnected();
@@ -109,10 +122,12 @@ public slots:
     void handleReceivedLocalCommandValue(unsigned short command, unsigned char priority, unsigned char reliability, char orderingChannel, unsigned char compressionType, float value, bool deadReckoned, float valueRate);
     void handleReceivedLocalCorrectionCommandValue(unsigned short command, float value);
     void handleReceivedLocalEvent(unsigned char eventID);
+    void handleLocalMasterSyncRequest();
+    void handleReceivedLocalAnimation(unsigned char animationType, const std::vector<AnimationArgument>& arguments);
 
 public:
     /// Constructor
-    Network(MainWindow* window_);
+    Network(UiChannel* uiChannel_);
     /// Destructor
     ~Network();
 
@@ -154,6 +169,42 @@ public:
     ///Ping a remote unconnected system.
     bool ping(const char *ip, unsigned short port);
 
+    ///Signal the given event whenever a packet is ready for update(). Pass nullptr to clear.
+    void setPacketReadyEvent(RakNet::SignaledEvent* event);
+
+    ///Send log lines to the given Logger instead of straight to the GUI. Pass nullptr to clear.
+    void setLogger(Logger* logger_);
+
+    ///Record every message sent and received into the given SessionRecorder. Pass nullptr to clear.
+    void setSessionRecorder(SessionRecorder* sessionRecorder_);
+
+    ///Queue a recorded command or animation message as if a copilot had sent it. It is handled by the next update().
+    ///Returns false if no session is running or the message is not one that can be replayed.
+    bool replayPacket(const unsigned char* data, unsigned int length);
+
+    ///Write the command latency histograms of the current (or last) session as CSV and log the result.
+    ///Returns false if the file could not be written.
+    bool exportCommandLatency(const std::string& path) const;
+
+    ///How commands from DCS are assigned to ordering channels: "hashed" (default), "aircraft", or the path of a
+    ///per aircraft table file (OrderingChannelMap). Returns false and keeps the current assignment if the table cannot be read.
+    bool setOrderingChannels(const std::string& setting);
+
+    ///Send-side dead reckoning of analog values from DCS: "on" (default), "off", or the path of a per command
+    ///tolerance table (DeadReckoningSender). Returns false and keeps the current tolerances if the table cannot be read.
+    bool setDeadReckoning(const std::string& setting);
+
+    ///Aircraft codec profile (CommandCodecProfile) path, empty for none. It is announced when joining or hosting a
+    ///session, so a change takes effect with the next one. Returns false and keeps the current profile if it cannot be read.
+    bool setCodecProfile(const std::string& path);
+
+    ///How many times a second the connection statistics are sampled for the GUI
+    void setStatisticsRate(int rateHz);
+
+    ///Commands and events this client's seat consumes, sent with every seat request: "all" (default) or the path of a
+    ///SeatInterest table. Returns false and keeps the current interest if the table cannot be read.
+    bool setSeatInterest(const std::string& setting);
+
     ///////////////////
     // GET FUNCTIONS //
     ///////////////////
@@ -186,6 +237,9 @@ public:
     ///Returns the maximum number of connected clients for the currently connected server.  0 if not connected.
     int getMaxClients() const;
 
+    ///Returns the tick timing of RakNet's update thread in the current session, including how long its updates take
+    void getUpdateStatistics(RakNet::TickStatistics* stats) const;
+
     ///Returns the total packet loss of the local client from 0.0 (0.0%) to 1.0 (100.0%)
     float getMyPacketLoss();
 
@@ -198,12 +252,12 @@ public:
     ///Returns the bandwidth used from the last second in bytes
     uint64_t getRecentBandwidth(ConnectionMetrics metric);
 
-    ///Returns the name of a client from the unique client ID number.
-    ///Returns a null pointer if a client could not be found.
-    std::string getClientNameByGUID(RakNet::RakNetGUID guid) const;
+    ///Returns the name of a client from the unique client ID number, valid until the client leaves.
+    ///Returns "Unknown Client" if a client could not be found.
+    const char* getClientNameByGUID(const RakNet::RakNetGUID& guid) const;
 
-    ///Returns the client data structure for the client found with the given GUID
-    Client* getClientByGUID(RakNet::RakNetGUID guid) const;
+    ///Returns the client data structure for the client found with the given GUID, nullptr if none
+    Client* getClientByGUID(const RakNet::RakNetGUID& guid) const;
 
     ///Returns the client's IP Address from the given GUID String (Host only function, else returns an empty string)
     std::string getClientAddress(const std::string& guidStr) const;
@@ -220,8 +274,8 @@ public:
     ///Returns my server configuration
     const ServerConfig &getMyServerConfig() const;
 
-    ///Returns a vector list of all connected clients' info (Does not contain IP Address)
-    const std::vector<ClientInfo>& getClientInfo() const;
+    ///Returns every connected client, including myself (Host only: IP Addresses of the other clients)
+    const ClientTable& getClientTable() const;
 
 
     ///////////////////
@@ -231,6 +285,9 @@ public:
     ///Sets my client name string
     void setMyClientName(std::string clientName);
 
+    ///Sets the time between RakNet update cycles in ms (MIN_TICK_TIME_MS..MAX_TICK_TIME_MS), used from the next session
+    void setTickTimeMS(int time_ms);
+
     ///Sets the server timeout time in ms
     void setTimeoutTimeMS(int time_ms);
 
@@ -240,6 +297,13 @@ public:
     ///Sets my client's max outgoing speed per connection in bits per second (default = 256 kbps)
     void setMyMaxOutgoingSpeedPerConnection(unsigned long long bits_per_second);
 
+    ///Sets the crew (0..MAX_CREWS-1) my aircraft belongs to on a host serving several, used from the next session
+    void setCrew(int crew);
+
+    ///Sets how many threads (0..MAX_UPDATE_WORKERS) help RakNet's update thread with the per connection updates when
+    ///hosting, used from the next session. Worth it for large crews only.
+    void setUpdateWorkers(int count);
+
 private:
 
     //void RakNetThreadUpdate(RakNet::RakPeerInterface *peer, void* data);
@@ -249,12 +313,80 @@ private:
     RakNet::RakString readBitStreamString(RakNet::Packet *packet);
     const char* readBitStreamCharArray(RakNet::Packet *packet);
 
-    static const float maxValueRate;
+    ///Host only. Forward a received packet unchanged to every seated client except its sender that wants any of the
+    ///entries in it, or to every seated client but the sender if entries is nullptr.
+    void relayPacket(RakNet::Packet *packet, PacketPriority priority, PacketReliability reliability, char orderingChannel,
+                     const CommandBatchEntry* entries, size_t numEntries);
+    ///Host only. relayPacket() using the priority, reliability and ordering channel from a command or batch header.
+    void relayCommandPacket(RakNet::Packet *packet, const CommandBatchEntry* entries, size_t numEntries);
+    ///Host only. Send to every seated client of the crew except the one at skipAddress whose SeatInterest wants any of the
+    ///entries, or to every seated client but that one if entries is nullptr. Spectators never use commands or animations.
+    void fanOut(const char* data, int length, PacketPriority priority, PacketReliability reliability, char orderingChannel,
+                int crew, const RakNet::SystemAddress& skipAddress, const CommandBatchEntry* entries, size_t numEntries);
+    ///Host only. Send to every remote client of the crew, seated or not, except the one at skipAddress
+    void sendToCrew(const RakNet::BitStream* bitStream, PacketPriority priority, PacketReliability reliability, char orderingChannel,
+                    int crew, const RakNet::SystemAddress& skipAddress);
+
+    ///Host only. Publish the measured pings and send the client info each client waited too long for a batch to carry
+    void updateClientInfo();
+    ///Apply client info entries from the host
+    void receiveClientInfo(RakNet::BitStream& bsIn);
+
+    ///Host only. Record the interest of a client granted a seat, or forget it when the seat is left
+    void updateSeatView(int slot, int seatNumber, const SeatInterest& interest);
+    ///Host only. The command state a client's master sync compares against: the part of it the client's seat wants.
+    CommandStateTable& getSyncState(int slot);
+
+    static const unsigned int COMMAND_HEADER_SIZE = 3;
+    //[ID_TIMESTAMP][RakNet::Time ingress time][source seat] in front of every command message
+    static const unsigned int COMMAND_STAMP_SIZE = 1 + sizeof(RakNet::Time) + 1;
+
+    ///If the packet starts with a command stamp, remember it and return a view of the message after it in unstamped.
+    ///Otherwise returns the packet itself.
+    RakNet::Packet* readCommandStamp(RakNet::Packet *packet, RakNet::Packet& unstamped);
+    ///Record the latency of one command from the stamp of the packet being handled
+    void recordCommandLatency(int messageClass);
+    ///Record one ordered message on the given channel for the stall estimate, from the stamp of the packet being handled
+    void recordOrderingStall(char orderingChannel, unsigned char reliability);
+
+    ///Host only. Use the codec profile in a crew while every seat of it announced the same one as the host, telling the
+    ///crew when that changes, and the client that just joined in any case (UNASSIGNED_SYSTEM_ADDRESS for none).
+    void updateSessionCodecProfile(int crew, const RakNet::SystemAddress& joined);
+
+    ///Returns the pending batch for this send class, creating it if needed. An empty batch is stamped with the current time.
+    CommandBatch& getCommandBatch(unsigned char priority, unsigned char reliability, char orderingChannel);
+    ///Send every non-empty batch. Called once at the end of update().
+    void flushCommandBatches();
+    ///Send one batch and empty it
+    void sendCommandBatch(CommandBatch& batch);
+
+    ///Record the latest value of a command for the master sync
+    void setCommandState(unsigned short command, float value);
+    ///Client only. Ask the host for its root and group hashes to start a master sync check.
+    void requestMasterSyncHash();
+
+    ///Send a keyframe or delta for every animation stream of my seat that needs one. Called once at the end of update().
+    void sendAnimationFrames();
+    ///Apply (and on the host, relay) a received animation keyframe or delta
+    void receiveAnimationFrame(RakNet::Packet *packet);
+    ///Host only. Drop the arguments owned by another occupied seat of the crew, claiming unowned ones for this seat.
+    ///Returns true if any argument was dropped.
+    bool filterAnimationArguments(unsigned char animationType, int crew, int seatNumber, std::vector<AnimationArgument>& arguments);
+    ///Someone took the given seat: start its streams from the next keyframe and send ours as keyframes too
+    void resetAnimationSeat(int seatNumber);
+
+    ///peer->Send() that also records the message when a session is being recorded
+    void send(const RakNet::BitStream* bitStream, PacketPriority priority, PacketReliability reliability, char orderingChannel,
+              const RakNet::AddressOrGUID systemIdentifier, bool broadcast);
+    void send(const char* data, int length, PacketPriority priority, PacketReliability reliability, char orderingChannel,
+              const RakNet::AddressOrGUID systemIdentifier, bool broadcast);
 
     void writeOutput(const QString& q) const;
     void updateServerStatus(int status) const;
 
-    MainWindow* window = nullptr;
+    UiChannel* uiChannel = nullptr;
+    Logger* logger = nullptr;
+    SessionRecorder* sessionRecorder = nullptr;
 
     // Make this object be noncopyable because it holds a pointer
     Network(const Network&);
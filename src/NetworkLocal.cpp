@@ -32,7 +32,10 @@ INCLUDES
 #include "BitStream.h"
 #include "GetTime.h"
 
-#include "mainwindow.h"
+#include "LocalSharedMemory.h"
+#include "Logger.h"
+#include "SessionRecorder.h"
+#include "UiChannel.h"
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
@@ -52,6 +55,8 @@ enum CustomLocalNetworkMessages
     ID_LOCAL_EXTERNAL_ANIMATION_CORRECTION,
     ID_LOCAL_COCKPIT_ANIMATION,
     ID_LOCAL_COCKPIT_ANIMATION_CORRECTION,
+    ID_LOCAL_ECHO, //sent straight back, for measuring the link to DCS
+    ID_LOCAL_FRAME, //all messages of one frame, see NetworkLocal
 };
 
 namespace Network {
@@ -60,9 +65,9 @@ namespace Network {
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
-NetworkLocal::NetworkLocal(MainWindow* window_)
+NetworkLocal::NetworkLocal(UiChannel* uiChannel_)
 {
-    window = window_;
+    uiChannel = uiChannel_;
     peer = RakNet::RakPeerInterface::GetInstance();
     //peer->SetOccasionalPing(true);
     myGUID = peer->GetMyGUID();
@@ -76,35 +81,139 @@ NetworkLocal::NetworkLocal(MainWindow* window_)
 
 NetworkLocal::~NetworkLocal()
 {
+    delete sharedMemory;
     RakNet::RakPeerInterface::DestroyInstance(peer);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void NetworkLocal::setLogger(Logger* logger_)
+{
+    logger = logger_;
+}
+
+void NetworkLocal::setSessionRecorder(SessionRecorder* sessionRecorder_)
+{
+    sessionRecorder = sessionRecorder_;
+}
+
+void NetworkLocal::send(const RakNet::BitStream* bitStream, PacketPriority priority, PacketReliability reliability, char orderingChannel)
+{
+    if (sessionRecorder != nullptr)
+        sessionRecorder->record(SESSION_LOCAL_OUT, bitStream->GetData(), bitStream->GetNumberOfBytesUsed());
+
+    if (transport == LOCAL_TRANSPORT_SHARED_MEMORY) {
+        //priority, reliability and ordering are RakNet's, the ring is reliable and ordered as it is
+        if (!sharedMemory->write(bitStream->GetData(), bitStream->GetNumberOfBytesUsed()) && sharedMemory->isDcsAttached())
+            NETWORK_LOG(logger, LOG_WARNING, LOG_GENERAL, "Shared memory ring to DCS is full, message %d dropped", (int)bitStream->GetData()[0]);
+        return;
+    }
+
+    peer->Send(bitStream, priority, reliability, orderingChannel, RakNet::UNASSIGNED_SYSTEM_ADDRESS, true);
+}
+
+void NetworkLocal::queue(const RakNet::BitStream* bitStream, PacketPriority priority, PacketReliability reliability, char orderingChannel)
+{
+    unsigned int length = bitStream->GetNumberOfBytesUsed();
+    if (!dcsReadsFrames || length + 3 > LOCAL_FRAME_MAX_SIZE) {
+        //keep the order of what is already queued
+        sendFrame();
+        send(bitStream, priority, reliability, orderingChannel);
+        return;
+    }
+
+    if (frameOut.GetNumberOfBytesUsed() + 2 + length > LOCAL_FRAME_MAX_SIZE)
+        sendFrame();
+
+    if (frameMessages == 0)
+        frameOut.Write((RakNet::MessageID)ID_LOCAL_FRAME);
+    frameOut.Write((unsigned short)length);
+    frameOut.WriteAlignedBytes(bitStream->GetData(), length);
+    frameMessages++;
+}
+
+void NetworkLocal::flushFrame()
+{
+    extrapolation.update(RakNet::GetTime(), pendingValues);
+
+    //values come last, the newest of the loop is all DCS needs
+    for (const auto& slot : pendingValues.getSlots())
+    {
+        RakNet::BitStream bsOut;
+        bsOut.Write((RakNet::MessageID)ID_LOCAL_COMMAND_VALUE);
+        bsOut.Write(slot.command);
+        bsOut.Write(slot.value);
+        if (slot.deadReckoned) {
+            bsOut.Write(slot.valueRate);
+        }
+        queue(&bsOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, 0);
+    }
+    unsigned int coalesced = pendingValues.clear();
+    if (coalesced > 0)
+        NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, "%u older command values for DCS dropped", coalesced);
+
+    sendFrame();
+}
+
+void NetworkLocal::sendFrame()
+{
+    if (frameMessages == 0)
+        return;
+
+    //one loopback frame on one channel, the per message channels only matter on a lossy link
+    send(&frameOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, 0);
+    frameOut.Reset();
+    frameMessages = 0;
+}
+
 void NetworkLocal::writeOutput(const QString& q) const
 {
-    std::cout << q.toStdString().c_str() << std::endl;
-    window->logMessage(q);
+    if (logger != nullptr) {
+        logger->write(LOG_INFO, LOG_GENERAL, q);
+    }
+    else
+    {
+        std::cout << q.toStdString().c_str() << std::endl;
+        uiChannel->logMessage(q);
+    }
 }
 
 void NetworkLocal::updateListenerStatus(bool running) const
 {
-    window->updateListenerStatus(running);
+    uiChannel->updateListenerStatus(running);
 }
 
 void NetworkLocal::updateDCSStatus(bool running) const
 {
-    window->updateDCSStatus(running);
+    uiChannel->updateDCSStatus(running);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-bool NetworkLocal::startServer()
+bool NetworkLocal::startServer(LocalTransport transport_)
 {
     //cancel any ongoing connections
     //peer->Shutdown(100);
 
-    if (!isHost)
+    if (!isHost && transport_ == LOCAL_TRANSPORT_SHARED_MEMORY)
+    {
+        if (sharedMemory == nullptr)
+            sharedMemory = new LocalSharedMemory;
+
+        if (sharedMemory->create())
+        {
+            writeOutput("Listener started successfully on shared memory");
+            updateListenerStatus(true);
+
+            isHost = true;
+            transport = transport_;
+            return true;
+        }
+
+        writeOutput("<font color='red'>ERROR:</font> Listener could not create the shared memory.");
+        updateListenerStatus(false);
+    }
+    else if (!isHost)
     {
         unsigned short port = 37820;
         unsigned short max_clients = 1;
@@ -116,13 +225,15 @@ bool NetworkLocal::startServer()
         if (result == RakNet::RAKNET_STARTED)
         {
             writeOutput(QString("Listener started successfully on port: %1").arg(port));
-            //QLabel* label =  window->findChild<QLabel*>("Listener_status_label");
             updateListenerStatus(true);
 
             isHost = true;
+            transport = transport_;
             peer->SetMaximumIncomingConnections(max_clients);
 
             peer->SetTimeoutTime(1000, RakNet::UNASSIGNED_SYSTEM_ADDRESS);
+            // A 6 ms tick is too short to trust to the OS sleep alone, spin out the last 500 us
+            peer->SetTickSpinTime(500);
             return true;
         }
         else {
@@ -177,7 +288,15 @@ bool NetworkLocal::startServer()
 void NetworkLocal::disconnect()
 {
     if (currentStatus <= IS_CONNECTED || isHost) {
-        peer->Shutdown(300);
+        frameOut.Reset();
+        frameMessages = 0;
+        dcsReadsFrames = false;
+        pendingValues.clear();
+        extrapolation.clear();
+        if (transport == LOCAL_TRANSPORT_SHARED_MEMORY)
+            sharedMemory->destroy();
+        else
+            peer->Shutdown(300);
         isHost = false;
         updateListenerStatus(false);
         updateDCSStatus(false);
@@ -206,147 +325,290 @@ void NetworkLocal::update()
     for (packet = peer->Receive(); packet; peer->DeallocatePacket(packet), packet = peer->Receive())
     {
         isAttemptingConnection = false;
-        switch (packet->data[0])
-        {
-        case ID_UNCONNECTED_PONG:
-        {
-            //unsigned int dataLength;
-            RakNet::TimeMS time;
-            RakNet::BitStream bsIn(packet->data, packet->length, false);
-            bsIn.IgnoreBytes(1);
-            bsIn.Read(time);
-            writeOutput(QString("Ping: %1 ms").arg((unsigned int)(RakNet::GetTimeMS() - time)));
+        handlePacket();
+    }
 
-            break;
-        }
-        case ID_CONNECTED_PING:
-            writeOutput(QString("Ping from %1").arg(packet->systemAddress.ToString(true)));
-            break;
-        case ID_UNCONNECTED_PING:
-            writeOutput(QString("Ping from %1").arg(packet->systemAddress.ToString(true)));
-            break;
-        case ID_NEW_INCOMING_CONNECTION:
-        {
-            //received by the host only
-            if (isHost) {
-                int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
-                RakNet::RakNetGUID clientGUID = peer->GetGuidFromSystemAddress(packet->systemAddress);
+    if (transport == LOCAL_TRANSPORT_SHARED_MEMORY)
+        updateSharedMemory();
+}
 
-                if (clientGUID != RakNet::UNASSIGNED_RAKNET_GUID) {
-                    writeOutput(QString("<font color='green'>DCS Communication has started - GUID: %1</font>").arg(clientGUID.ToString()));
-                }
-                updateDCSStatus(true);
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-                emit localConnected();
-            }
+void NetworkLocal::updateSharedMemory()
+{
+    switch (sharedMemory->update(currentTime))
+    {
+    case SHARED_MEMORY_DCS_ATTACHED:
+        dcsReadsFrames = false;
+        writeOutput("<font color='green'>DCS Communication has started - Shared Memory</font>");
+        updateDCSStatus(true);
+
+        emit localConnected();
+        break;
+    case SHARED_MEMORY_DCS_DETACHED:
+        writeOutput(QString("DCS Communication has ended - Disconnected"));
+        updateDCSStatus(false);
+        break;
+    case SHARED_MEMORY_DCS_LOST:
+        writeOutput(QString("<font color='red'>ERROR: DCS Communication has ended - Connection Lost</font>"));
+        updateDCSStatus(false);
+        break;
+    default:
+        break;
+    }
+
+    //a packet that only points at the ring's copy, so handlePacket() reads both transports alike
+    RakNet::Packet view;
+    view.systemAddress = RakNet::UNASSIGNED_SYSTEM_ADDRESS;
+    view.guid = RakNet::UNASSIGNED_RAKNET_GUID;
+    view.deleteData = false;
+    view.wasGeneratedLocally = false;
+
+    const unsigned char* data;
+    unsigned int length;
+    while (sharedMemory->isDcsAttached() && sharedMemory->read(data, length))
+    {
+        view.data = const_cast<unsigned char*>(data);
+        view.length = length;
+        view.bitSize = RakNet::BitSize_t(length) * 8;
+        packet = &view;
+        handlePacket();
+    }
+    packet = nullptr;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void NetworkLocal::handlePacket()
+{
+    if (sessionRecorder != nullptr)
+        sessionRecorder->record(SESSION_LOCAL_IN, packet->data, packet->length);
+
+    handleMessage();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void NetworkLocal::handleFrame()
+{
+    dcsReadsFrames = true;
+
+    RakNet::Packet* frame = packet;
+    RakNet::Packet view = *frame;
+    view.deleteData = false;
+
+    unsigned int offset = sizeof(RakNet::MessageID);
+    while (offset + 2 <= frame->length)
+    {
+        //16 bit length in BitStream (network) byte order
+        unsigned int length = ((unsigned int)frame->data[offset] << 8) | frame->data[offset + 1];
+        offset += 2;
+        if (length == 0 || offset + length > frame->length) {
+            writeOutput("<font color='red'>ERROR:</font> Truncated local frame, handling the messages read so far.");
             break;
         }
-        case ID_DISCONNECTION_NOTIFICATION:
-            if (isHost) {
-                int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
-                writeOutput(QString("DCS Communication has ended - Disconnected"));
 
-                updateDCSStatus(false);
-            }
-            break;
-        case ID_CONNECTION_LOST:
-        {
-            if (isHost) {
-                int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
-                writeOutput(QString("<font color='red'>ERROR: DCS Communication has ended - Connection Lost</font>"));
+        view.data = frame->data + offset;
+        view.length = length;
+        view.bitSize = RakNet::BitSize_t(length) * 8;
+        offset += length;
+
+        //frames do not nest
+        if (view.data[0] == ID_LOCAL_FRAME)
+            continue;
+
+        packet = &view;
+        handleMessage();
+    }
 
-                updateDCSStatus(false);
+    packet = frame;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void NetworkLocal::handleMessage()
+{
+    switch (packet->data[0])
+    {
+    case ID_UNCONNECTED_PONG:
+    {
+        //unsigned int dataLength;
+        RakNet::TimeMS time;
+        RakNet::BitStream bsIn(packet->data, packet->length, false);
+        bsIn.IgnoreBytes(1);
+        bsIn.Read(time);
+        writeOutput(QString("Ping: %1 ms").arg((unsigned int)(RakNet::GetTimeMS() - time)));
+
+        break;
+    }
+    case ID_CONNECTED_PING:
+        writeOutput(QString("Ping from %1").arg(packet->systemAddress.ToString(true)));
+        break;
+    case ID_UNCONNECTED_PING:
+        writeOutput(QString("Ping from %1").arg(packet->systemAddress.ToString(true)));
+        break;
+    case ID_NEW_INCOMING_CONNECTION:
+    {
+        //received by the host only
+        if (isHost) {
+            int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
+            RakNet::RakNetGUID clientGUID = peer->GetGuidFromSystemAddress(packet->systemAddress);
+
+            if (clientGUID != RakNet::UNASSIGNED_RAKNET_GUID) {
+                writeOutput(QString("<font color='green'>DCS Communication has started - GUID: %1</font>").arg(clientGUID.ToString()));
             }
-            break;
+            updateDCSStatus(true);
+
+            emit localConnected();
         }
+        break;
+    }
+    case ID_DISCONNECTION_NOTIFICATION:
+        if (isHost) {
+            int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
+            writeOutput(QString("DCS Communication has ended - Disconnected"));
 
-        ////////////////////////////////////////////////
-        ///////////    CUSTOM MESSAGE IDS    ///////////
-        ////////////////////////////////////////////////
+            updateDCSStatus(false);
+        }
+        break;
+    case ID_CONNECTION_LOST:
+    {
+        if (isHost) {
+            int index = peer->GetIndexFromSystemAddress(packet->systemAddress);
+            writeOutput(QString("<font color='red'>ERROR: DCS Communication has ended - Connection Lost</font>"));
 
-        case ID_LOCAL_MESSAGE_1:
-        {
-            //writeOutput("%s", readBitStreamCharArray(packet));
-            break;
+            updateDCSStatus(false);
         }
-        case ID_LOCAL_COMMAND:
-        case ID_LOCAL_COMMAND_VALUE:
+        break;
+    }
+
+    ////////////////////////////////////////////////
+    ///////////    CUSTOM MESSAGE IDS    ///////////
+    ////////////////////////////////////////////////
+
+    case ID_LOCAL_MESSAGE_1:
+    {
+        //writeOutput("%s", readBitStreamCharArray(packet));
+        break;
+    }
+    case ID_LOCAL_COMMAND:
+    case ID_LOCAL_COMMAND_VALUE:
+    {
+        unsigned short command = 0;
+        float value = 0.f;
+        float valueRate = 0.f;
+        bool deadReckoned = false;
+        char orderingChannel;
+        unsigned char priority;
+        unsigned char reliability;
+        unsigned char compressionType;
+        unsigned char packetInfo;
+
+        RakNet::BitStream bsIn(packet->data, packet->length, false);
+        bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+        bsIn.Read(orderingChannel);
+        //bsIn.ReadBits((unsigned char *)(&(priority)), 2);
+        //bsIn.ReadBits((unsigned char *)(&(reliability)), 3);
+        //bsIn.ReadBits((unsigned char *)(&(compType)), 3);
+        bsIn.Read(packetInfo);
+        bsIn.Read(command);
+        priority = READFROM(packetInfo,0,2);
+        reliability = READFROM(packetInfo,2,3);
+        compressionType = READFROM(packetInfo,5,3);
+
+        if (packet->data[0] != ID_LOCAL_COMMAND)
         {
-            unsigned short command = 0;
-            float value = 0.f;
-            float valueRate = 0.f;
-            bool deadReckoned = false;
-            char orderingChannel;
-            unsigned char priority;
-            unsigned char reliability;
-            unsigned char compressionType;
-            unsigned char packetInfo;
-
-            RakNet::BitStream bsIn(packet->data, packet->length, false);
-            bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
-            bsIn.Read(orderingChannel);
-            //bsIn.ReadBits((unsigned char *)(&(priority)), 2);
-            //bsIn.ReadBits((unsigned char *)(&(reliability)), 3);
-            //bsIn.ReadBits((unsigned char *)(&(compType)), 3);
-            bsIn.Read(packetInfo);
-            bsIn.Read(command);
-            priority = READFROM(packetInfo,0,2);
-            reliability = READFROM(packetInfo,2,3);
-            compressionType = READFROM(packetInfo,5,3);
-
-            if (packet->data[0] != ID_LOCAL_COMMAND)
-            {
-                //Analog command, read compression type and value
-                bsIn.Read(value);
-                if (bsIn.GetNumberOfUnreadBits() > 7) {
-                    deadReckoned = true;
-                    bsIn.Read(valueRate);
-                }
+            //Analog command, read compression type and value
+            bsIn.Read(value);
+            if (bsIn.GetNumberOfUnreadBits() > 7) {
+                deadReckoned = true;
+                bsIn.Read(valueRate);
             }
+        }
 
-            if (packet->data[0] == ID_LOCAL_COMMAND) {
-                //Digital command
-                emit receivedLocalCommand(command, priority, reliability, orderingChannel);
-                writeOutput(QString("Local Command (%1)").arg(command));
-            }
-            else {
-                //Analog command
-                emit receivedLocalCommandValue(command, priority, reliability, orderingChannel, compressionType, value, deadReckoned, valueRate);
-                writeOutput(QString("Local Command (%1): ").arg(command)+QString::number((double)value)+(deadReckoned ? QString(", ") + QString::number((double)valueRate) : ""));
-            }
-            break;
+        if (packet->data[0] == ID_LOCAL_COMMAND) {
+            //Digital command
+            emit receivedLocalCommand(command, priority, reliability, orderingChannel);
+            NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, "Local Command (%u)", (unsigned int)command);
         }
-        case ID_LOCAL_COMMAND_VALUE_CORRECTION:
-        {
-            unsigned short command = 0;
-            float value = 0.f;
+        else {
+            //Analog command
+            emit receivedLocalCommandValue(command, priority, reliability, orderingChannel, compressionType, value, deadReckoned, valueRate);
+            NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, deadReckoned ? "Local Command (%u): %g, %g" : "Local Command (%u): %g", (unsigned int)command, (double)value, (double)valueRate);
+        }
+        break;
+    }
+    case ID_LOCAL_COMMAND_VALUE_CORRECTION:
+    {
+        unsigned short command = 0;
+        float value = 0.f;
 
-            RakNet::BitStream bsIn(packet->data, packet->length, false);
-            bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
-            bsIn.Read(command);
-            bsIn.Read(value);
+        RakNet::BitStream bsIn(packet->data, packet->length, false);
+        bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+        bsIn.Read(command);
+        bsIn.Read(value);
 
-            emit receivedLocalCorrectionCommandValue(command, value);
-            writeOutput(QString("Local Command (%1): ").arg(command)+QString::number((double)value)+" (Corrected)");
-            break;
-        }
-        case ID_LOCAL_EVENT:
-        {
-            unsigned char eventID = 0;
+        emit receivedLocalCorrectionCommandValue(command, value);
+        NETWORK_LOG(logger, LOG_DEBUG, LOG_COMMANDS, "Local Command (%u): %g (Corrected)", (unsigned int)command, (double)value);
+        break;
+    }
+    case ID_LOCAL_EVENT:
+    {
+        unsigned char eventID = 0;
 
-            RakNet::BitStream bsIn(packet->data, packet->length, false);
-            bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
-            bsIn.Read(eventID);
+        RakNet::BitStream bsIn(packet->data, packet->length, false);
+        bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+        bsIn.Read(eventID);
 
-            emit receivedLocalEvent(eventID);
-            writeOutput(QString("Local Event (%1)").arg((int)eventID));
+        emit receivedLocalEvent(eventID);
+        NETWORK_LOG(logger, LOG_DEBUG, LOG_EVENTS, "Local Event (%d)", (int)eventID);
 
-            break;
-        }
-        default:
-            writeOutput(QString("Message with identifier %1 has arrived").arg(packet->data[0]));
-            break;
+        break;
+    }
+    case ID_LOCAL_COCKPIT_ANIMATION:
+    case ID_LOCAL_EXTERNAL_ANIMATION:
+    {
+        unsigned char animationType = (packet->data[0] == ID_LOCAL_COCKPIT_ANIMATION) ? COCKPIT_ANIMATION : EXTERNAL_ANIMATION;
+        unsigned short count = 0;
+
+        RakNet::BitStream bsIn(packet->data, packet->length, false);
+        bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+        bsIn.Read(count);
+
+        std::vector<AnimationArgument> arguments;
+        arguments.reserve(count);
+        for (unsigned short i = 0; i < count; i++)
+        {
+            AnimationArgument arg;
+            if (!bsIn.Read(arg.argument) || !bsIn.Read(arg.value))
+                break;
+            arguments.push_back(arg);
         }
+
+        //sent every DCS frame, so not logged
+        emit receivedLocalAnimation(animationType, arguments);
+        break;
+    }
+    case ID_LOCAL_ECHO:
+    {
+        RakNet::BitStream bsOut(packet->data, packet->length, false);
+        queue(&bsOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, 0);
+        break;
+    }
+    case ID_LOCAL_FRAME:
+    {
+        handleFrame();
+        break;
+    }
+    case ID_LOCAL_COMMAND_MASTER_SYNC_REQUEST:
+    {
+        emit receivedLocalMasterSyncRequest();
+        NETWORK_LOG(logger, LOG_INFO, LOG_SYNC, "Local Master Sync requested");
+        break;
+    }
+    default:
+        writeOutput(QString("Message with identifier %1 has arrived").arg(packet->data[0]));
+        break;
     }
 }
 
@@ -357,6 +619,63 @@ ConnectionState NetworkLocal::getNetworkStatus() const
     return currentStatus;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void NetworkLocal::setPacketReadyEvent(RakNet::SignaledEvent* event)
+{
+    peer->SetPacketReadyEvent(event);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool NetworkLocal::replayPacket(const unsigned char* data, unsigned int length)
+{
+    if (!isHost || length == 0)
+        return false;
+
+    switch (data[0])
+    {
+    case ID_LOCAL_COMMAND:
+    case ID_LOCAL_COMMAND_VALUE:
+    case ID_LOCAL_COMMAND_VALUE_CORRECTION:
+    case ID_LOCAL_EVENT:
+    case ID_LOCAL_COCKPIT_ANIMATION:
+    case ID_LOCAL_EXTERNAL_ANIMATION:
+    case ID_LOCAL_FRAME:
+        break;
+    default:
+        return false;
+    }
+
+    //handled now rather than queued, the shared memory link has no receive queue to push into
+    RakNet::Packet view;
+    view.systemAddress = RakNet::UNASSIGNED_SYSTEM_ADDRESS;
+    view.guid = RakNet::UNASSIGNED_RAKNET_GUID;
+    view.data = const_cast<unsigned char*>(data);
+    view.length = length;
+    view.bitSize = RakNet::BitSize_t(length) * 8;
+    view.deleteData = false;
+    view.wasGeneratedLocally = true;
+
+    currentTime = RakNet::GetTime();
+    packet = &view;
+    handlePacket();
+    packet = nullptr;
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool NetworkLocal::isPolling() const
+{
+    return isHost && transport == LOCAL_TRANSPORT_SHARED_MEMORY && !LOCAL_SHARED_MEMORY_WAKES;
+}
+
+bool NetworkLocal::isExtrapolating() const
+{
+    return isHost && extrapolation.isExtrapolating();
+}
+
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
@@ -388,7 +707,7 @@ void NetworkLocal::handleReceivedSeatChange(int seatNumber)
         int maxValue = 60 - 1;
         bsOut.WriteBitsFromIntegerRange(zeroBasedSeatNumber, 0, maxValue);
         //send to dcs
-        peer->Send(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0, RakNet::UNASSIGNED_SYSTEM_ADDRESS, true);
+        queue(&bsOut, HIGH_PRIORITY, RELIABLE_ORDERED, 0);
     }
 }
 
@@ -402,7 +721,7 @@ void NetworkLocal::handleReceivedNetCommand(unsigned short command)
         bsOut.Write((RakNet::MessageID)ID_LOCAL_COMMAND);
         bsOut.Write(command);
         //send to dcs
-        peer->Send(&bsOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, 0, RakNet::UNASSIGNED_SYSTEM_ADDRESS, true);
+        queue(&bsOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, 0);
     }
 }
 
@@ -411,15 +730,9 @@ void NetworkLocal::handleReceivedNetCommand(unsigned short command)
 void NetworkLocal::handleReceivedNetCommandValue(unsigned short command, float value, bool deadReckoned, float valueRate)
 {
     if (isHost) {
-        RakNet::BitStream bsOut;
-        bsOut.Write((RakNet::MessageID)ID_LOCAL_COMMAND_VALUE);
-        bsOut.Write(command);
-        bsOut.Write(value);
-        if (deadReckoned) {
-            bsOut.Write(valueRate);
-        }
-        //send to dcs
-        peer->Send(&bsOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, 0, RakNet::UNASSIGNED_SYSTEM_ADDRESS, true);
+        //sent to dcs by flushFrame(), which extrapolates a moving value until the next one arrives
+        pendingValues.set(command, value, false, 0.0f);
+        extrapolation.set(command, value, deadReckoned ? valueRate : 0.0f, RakNet::GetTime());
     }
 }
 
@@ -432,7 +745,51 @@ void NetworkLocal::handleReceivedNetEvent(unsigned char eventID)
         bsOut.Write((RakNet::MessageID)ID_LOCAL_EVENT);
         bsOut.Write(eventID);
         //send to dcs
-        peer->Send(&bsOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_EVENTS, RakNet::UNASSIGNED_SYSTEM_ADDRESS, true);
+        queue(&bsOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, ORDERING_CHANNEL_EVENTS);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void NetworkLocal::handleReceivedNetAnimation(unsigned char animationType, int seatNumber, const std::vector<AnimationArgument>& arguments)
+{
+    if (isHost) {
+        bool cockpit = (animationType == COCKPIT_ANIMATION);
+
+        RakNet::BitStream bsOut;
+        bsOut.Write((RakNet::MessageID)(cockpit ? ID_LOCAL_COCKPIT_ANIMATION : ID_LOCAL_EXTERNAL_ANIMATION));
+        bsOut.Write((unsigned char)seatNumber);
+        bsOut.Write((unsigned short)arguments.size());
+        for (const auto& arg : arguments)
+        {
+            bsOut.Write(arg.argument);
+            bsOut.Write(arg.value);
+        }
+        //send to dcs
+        queue(&bsOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, cockpit ? ORDERING_CHANNEL_COCKPIT_ANIMATION : ORDERING_CHANNEL_EXTERNAL_ANIMATION);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void NetworkLocal::handleReceivedMasterSync(const std::vector<CommandState>& states)
+{
+    if (isHost) {
+        //the table is authoritative, stop extrapolating over it
+        extrapolation.clear();
+
+        //the loopback link costs nothing, so DCS gets the whole table instead of the hash exchange
+        RakNet::BitStream bsOut;
+        bsOut.Write((RakNet::MessageID)ID_LOCAL_COMMAND_MASTER_SYNC);
+        bsOut.Write((unsigned short)states.size());
+        for (const auto& state : states)
+        {
+            bsOut.Write(state.command);
+            bsOut.Write(state.value);
+        }
+        //send to dcs
+        queue(&bsOut, IMMEDIATE_PRIORITY, RELIABLE_ORDERED, 0);
+        NETWORK_LOG(logger, LOG_INFO, LOG_SYNC, "Local Master Sync: %d commands", (int)states.size());
     }
 }
 
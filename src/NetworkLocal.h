@@ -17,8 +17,13 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include "AnimationStream.h"
+#include "CommandStateTable.h"
+#include "CommandValueSlots.h"
+#include "DeadReckoning.h"
 #include "NetworkTypes.h"
 
+#include "BitStream.h"
 #include "RakPeerInterface.h"
 #include "RakString.h"
 #include "MessageIdentifiers.h"
@@ -30,17 +35,22 @@ INCLUDES
 DEFINITIONS
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+namespace Network {
+    static const unsigned int LOCAL_FRAME_MAX_SIZE = 8192; //a frame to DCS is sent early rather than grow past this, within DCS_SHM_MAX_MESSAGE_SIZE
+}
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 FORWARD DECLARATIONS
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 
-class MainWindow;
-
-
 namespace Network {
 
+    class LocalSharedMemory;
+    class Logger;
+    class SessionRecorder;
+    class UiChannel;
+
 
 	/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 	CLASS DOCUMENTATION
@@ -49,6 +59,25 @@ namespace Network {
 	/** Local Network class wrapper using RakNet library. The local network handles
 	communication with DCS running on the same computer.
 
+	DCS connects either to the RakNet listener or, with
+	LOCAL_TRANSPORT_SHARED_MEMORY, through the rings of LocalSharedMemory. Both
+	carry the same ID_LOCAL_* messages and share one decode path.
+
+	An ID_LOCAL_FRAME message holds all the messages of one DCS frame:
+	    per message:
+	        length      16 bits
+	        data        the message, starting with its ID_LOCAL_* ID
+	until the end of the frame. Frames are unpacked into the same decode path.
+	Once DCS has sent a frame, everything for DCS is queued and sent as one
+	frame per network loop by flushFrame(), so an aircraft that does not know
+	frames keeps getting single messages. An aircraft that only listens opts in
+	with an empty frame after connecting.
+
+	Analog values from the copilots are not queued as they arrive but kept in
+	CommandValueSlots, newest value wins, and go to DCS at the end of the loop
+	right before the frame. Digital commands and events are queued in the order
+	they arrived.
+
 	@author Cory Parks
 	*/
 
@@ -66,6 +95,8 @@ namespace Network {
         void receivedLocalCommandValue(unsigned short command, unsigned char priority, unsigned char reliability, char orderingChannel, unsigned char compressionType, float value, bool deadReckoned, float valueRate);
         void receivedLocalCorrectionCommandValue(unsigned short command, float value);
         void receivedLocalEvent(unsigned char eventID);
+        void receivedLocalMasterSyncRequest();
+        void receivedLocalAnimation(unsigned char animationType, const std::vector<AnimationArgument>& arguments);
 
 
     public slots:
@@ -73,19 +104,21 @@ namespace Network {
         void handleReceivedNetCommand(unsigned short command);
         void handleReceivedNetCommandValue(unsigned short command, float value, bool deadReckoned, float valueRate);
         void handleReceivedNetEvent(unsigned char eventID);
+        void handleReceivedMasterSync(const std::vector<CommandState>& states);
+        void handleReceivedNetAnimation(unsigned char animationType, int seatNumber, const std::vector<AnimationArgument>& arguments);
 
 	public:
         /// Constructor
-        NetworkLocal(MainWindow* window_);
+        NetworkLocal(UiChannel* uiChannel_);
         /// Destructor
         virtual ~NetworkLocal();
 
 		///Main update function to call each frame to capture all received network packets since the last call
         virtual void update();
 
-		///Attempt to start the network server as host
+		///Attempt to start the network server as host, listening on the given transport
 		///Returns true if successful.
-		bool startServer();
+		bool startServer(LocalTransport transport_ = LOCAL_TRANSPORT_RAKNET);
 
 		///If connected to a server, attempt to disconnect.
 		void disconnect();
@@ -93,6 +126,29 @@ namespace Network {
 		///Returns the network status of the peer
 		ConnectionState getNetworkStatus() const;
 
+        ///Signal the given event whenever a packet is ready for update(). Pass nullptr to clear.
+        void setPacketReadyEvent(RakNet::SignaledEvent* event);
+
+        ///Send log lines to the given Logger instead of straight to the GUI. Pass nullptr to clear.
+        void setLogger(Logger* logger_);
+
+        ///Record every message sent to and received from DCS into the given SessionRecorder. Pass nullptr to clear.
+        void setSessionRecorder(SessionRecorder* sessionRecorder_);
+
+        ///Handle a recorded command, event or animation message as if DCS had sent it.
+        ///Returns false if the listener is not running or the message is not one that can be replayed.
+        bool replayPacket(const unsigned char* data, unsigned int length);
+
+        ///Send the latest analog values and everything queued for DCS since the last call as one ID_LOCAL_FRAME.
+        ///Once per network loop, after both peers updated.
+        void flushFrame();
+
+        ///True while listening on a transport that cannot signal the packet ready event, so update() has to be polled
+        bool isPolling() const;
+
+        ///True while received values are being extrapolated, so flushFrame() has to run every DEAD_RECKONING_OUTPUT_INTERVAL_MS
+        bool isExtrapolating() const;
+
     protected:
         RakNet::RakPeerInterface *peer = nullptr;
         RakNet::Packet *packet = nullptr;
@@ -102,6 +158,7 @@ namespace Network {
 
         bool isAttemptingConnection = false;
         bool isHost = false;
+        LocalTransport transport = LOCAL_TRANSPORT_RAKNET;
         RakNet::RakNetGUID myGUID = RakNet::UNASSIGNED_RAKNET_GUID;
 
         RakNet::Time currentTime;
@@ -109,7 +166,29 @@ namespace Network {
         ConnectionState lastStatus = IS_NOT_CONNECTED;
         ConnectionState currentStatus = IS_NOT_CONNECTED;
 
-        MainWindow* window = nullptr;
+        UiChannel* uiChannel = nullptr;
+        Logger* logger = nullptr;
+        SessionRecorder* sessionRecorder = nullptr;
+        LocalSharedMemory* sharedMemory = nullptr;
+
+        //messages for DCS waiting for flushFrame(), and whether DCS reads frames
+        RakNet::BitStream frameOut;
+        unsigned int frameMessages = 0;
+        bool dcsReadsFrames = false;
+
+        //analog values for DCS waiting for flushFrame(), newest per command
+        CommandValueSlots pendingValues;
+        //moving analog values from the copilots, extrapolated into pendingValues between updates
+        DeadReckoningReceiver extrapolation;
+
+        ///Add a message for DCS to the frame, or send it right away if DCS does not read frames
+        void queue(const RakNet::BitStream* bitStream, PacketPriority priority, PacketReliability reliability, char orderingChannel);
+
+        ///Send the frame queued so far, without the pending values
+        void sendFrame();
+
+        ///peer->Send(), or the shared memory ring, to DCS that also records the message when a session is being recorded
+        void send(const RakNet::BitStream* bitStream, PacketPriority priority, PacketReliability reliability, char orderingChannel);
 
         void writeOutput(const QString& q) const;
         void updateDCSStatus(bool running) const;
@@ -121,6 +200,18 @@ namespace Network {
 		const NetworkLocal &operator =(const NetworkLocal &);
 
         void updateListenerStatus(bool running) const;
+
+        ///Record and handle the message in packet, from either transport
+        void handlePacket();
+
+        ///Decode and handle the message in packet
+        void handleMessage();
+
+        ///Handle each message of the ID_LOCAL_FRAME in packet
+        void handleFrame();
+
+        ///Attach and detach changes and messages of the shared memory link
+        void updateSharedMemory();
 	};
 
     //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
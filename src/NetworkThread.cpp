@@ -0,0 +1,249 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       NetworkThread.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      NetworkThread Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+NetworkThread runs the Network and NetworkLocal packet loops off the GUI thread.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+Network and NetworkLocal are created inside run() so that they belong to the
+network thread. Their signals are connected with Qt::DirectConnection so that a
+command received from DCS is handed to the copilot network (and vice versa) in
+the same loop iteration, without a trip through any event loop.
+
+The loop blocks on a single SignaledEvent that both RakPeer instances signal when
+they queue a packet (RakPeerInterface::SetPacketReadyEvent). post() and stop()
+signal it too. The event is auto-reset and stays set until the next wait, so a
+packet queued while update() is running is picked up on the next pass without
+sleeping. NETWORK_IDLE_WAIT_MS bounds the sleep so the periodic work in
+Network::update() (ping distribution, statistics) still runs while idle.
+
+On Windows the event is named, so an aircraft on the shared memory link sets it
+too. Elsewhere the aircraft cannot reach it and the loop polls every
+NETWORK_POLL_WAIT_MS while that link is up (NetworkLocal::isPolling()). While
+received values are extrapolated for DCS it wakes every
+DEAD_RECKONING_OUTPUT_INTERVAL_MS to hand over the next ones.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "NetworkThread.h"
+
+#include "Network.h"
+#include "NetworkLocal.h"
+
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+NetworkThread::NetworkThread(QObject* parent) : QThread(parent)
+{
+    wakeEvent.InitSharedEvent();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+NetworkThread::~NetworkThread()
+{
+    stop();
+    wakeEvent.CloseEvent();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool NetworkThread::post(Request request)
+{
+    if (!requests.push(std::move(request)))
+        return false;
+
+    wakeEvent.SetEvent();
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void NetworkThread::stop()
+{
+    stopRequested = true;
+    wakeEvent.SetEvent();
+    wait();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+UiChannel* NetworkThread::getUiChannel()
+{
+    return &uiChannel;
+}
+
+Logger* NetworkThread::getLogger()
+{
+    return &logger;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool NetworkThread::startRecording(const std::string& path)
+{
+    return post([this, path](Network*, NetworkLocal*) {
+        if (sessionRecorder.open(path))
+            logger.write(LOG_INFO, LOG_GENERAL, QString("Recording session to %1").arg(path.c_str()));
+        else
+            logger.write(LOG_ERROR, LOG_GENERAL, QString("<font color='red'>ERROR:</font> Could not create the session recording %1").arg(path.c_str()));
+    });
+}
+
+bool NetworkThread::stopRecording()
+{
+    return post([this](Network*, NetworkLocal*) {
+        if (!sessionRecorder.isOpen())
+            return;
+
+        logger.write(LOG_INFO, LOG_GENERAL, QString("Session recording stopped, %1 KB, %2 messages dropped")
+                     .arg((unsigned long long)(sessionRecorder.getSize() / 1024)).arg(sessionRecorder.getDroppedCount()));
+        sessionRecorder.close();
+    });
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool NetworkThread::startReplay(const std::string& path, double speed)
+{
+    return post([this, path, speed](Network*, NetworkLocal*) {
+        if (sessionReplayer.start(path, speed))
+            logger.write(LOG_INFO, LOG_GENERAL, QString("Replaying %1 messages from %2").arg(sessionReplayer.getMessageCount()).arg(path.c_str()));
+        else
+            logger.write(LOG_ERROR, LOG_GENERAL, QString("<font color='red'>ERROR:</font> Cannot replay: %1").arg(sessionReplayer.getError().c_str()));
+    });
+}
+
+bool NetworkThread::stopReplay()
+{
+    return post([this](Network*, NetworkLocal*) {
+        if (!sessionReplayer.isRunning())
+            return;
+
+        sessionReplayer.stop();
+        logger.write(LOG_INFO, LOG_GENERAL, QString("Session replay stopped: %1 of %2 messages replayed")
+                     .arg(sessionReplayer.getReplayedCount()).arg(sessionReplayer.getMessageCount()));
+    });
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void NetworkThread::processRequests()
+{
+    Request request;
+    while (requests.pop(request))
+    {
+        request(net, netLocal);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void NetworkThread::run()
+{
+    netLocal = new NetworkLocal(&uiChannel);
+    net = new Network(&uiChannel);
+
+    netLocal->setPacketReadyEvent(&wakeEvent);
+    net->setPacketReadyEvent(&wakeEvent);
+
+    logger.start(QThread::LowPriority);
+    netLocal->setLogger(&logger);
+    net->setLogger(&logger);
+
+    netLocal->setSessionRecorder(&sessionRecorder);
+    net->setSessionRecorder(&sessionRecorder);
+
+    //NET_LOCAL ===> NET
+    connect(netLocal, SIGNAL(localConnected(void)), net, SLOT(handleLocalConnected(void)), Qt::DirectConnection);
+
+    connect(netLocal, SIGNAL(receivedLocalCommand(unsigned short,unsigned char,unsigned char,char)),
+            net, SLOT(handleReceivedLocalCommand(unsigned short,unsigned char,unsigned char,char)), Qt::DirectConnection);
+    connect(netLocal, SIGNAL(receivedLocalCommandValue(unsigned short,unsigned char,unsigned char,char,unsigned char,float,bool,float)),
+            net, SLOT(handleReceivedLocalCommandValue(unsigned short,unsigned char,unsigned char,char,unsigned char,float,bool,float)), Qt::DirectConnection);
+    connect(netLocal, SIGNAL(receivedLocalCorrectionCommandValue(unsigned short,float)),
+            net, SLOT(handleReceivedLocalCorrectionCommandValue(unsigned short,float)), Qt::DirectConnection);
+
+    connect(netLocal, SIGNAL(receivedLocalEvent(unsigned char)),
+            net, SLOT(handleReceivedLocalEvent(unsigned char)), Qt::DirectConnection);
+    connect(netLocal, SIGNAL(receivedLocalMasterSyncRequest(void)),
+            net, SLOT(handleLocalMasterSyncRequest(void)), Qt::DirectConnection);
+    connect(netLocal, SIGNAL(receivedLocalAnimation(unsigned char,std::vector<AnimationArgument>)),
+            net, SLOT(handleReceivedLocalAnimation(unsigned char,std::vector<AnimationArgument>)), Qt::DirectConnection);
+
+    //NET ===> NET_LOCAL
+    connect(net, SIGNAL(receivedSeatChange(int)), netLocal, SLOT(handleReceivedSeatChange(int)), Qt::DirectConnection);
+
+    connect(net, SIGNAL(receivedNetCommand(unsigned short)),
+            netLocal, SLOT(handleReceivedNetCommand(unsigned short)), Qt::DirectConnection);
+    connect(net, SIGNAL(receivedNetCommandValue(unsigned short,float,bool,float)),
+            netLocal, SLOT(handleReceivedNetCommandValue(unsigned short,float,bool,float)), Qt::DirectConnection);
+
+    connect(net, SIGNAL(receivedNetEvent(unsigned char)),
+            netLocal, SLOT(handleReceivedNetEvent(unsigned char)), Qt::DirectConnection);
+    connect(net, SIGNAL(receivedMasterSync(std::vector<CommandState>)),
+            netLocal, SLOT(handleReceivedMasterSync(std::vector<CommandState>)), Qt::DirectConnection);
+    connect(net, SIGNAL(receivedNetAnimation(unsigned char,int,std::vector<AnimationArgument>)),
+            netLocal, SLOT(handleReceivedNetAnimation(unsigned char,int,std::vector<AnimationArgument>)), Qt::DirectConnection);
+
+    while (!stopRequested)
+    {
+        processRequests();
+
+        //replayed messages are queued on the peers and handled by the updates below
+        bool replaying = sessionReplayer.isRunning();
+        sessionReplayer.update(net, netLocal);
+        if (replaying && !sessionReplayer.isRunning()) {
+            logger.write(LOG_INFO, LOG_GENERAL, QString("Session replay finished: %1 of %2 messages replayed")
+                         .arg(sessionReplayer.getReplayedCount()).arg(sessionReplayer.getMessageCount()));
+        }
+
+        netLocal->update();
+        net->update();
+        //what the copilots sent for DCS in this loop goes out as one frame
+        netLocal->flushFrame();
+
+        //the loop's messages are out, so this is where a recording may take the time to grow its file
+        sessionRecorder.reserve();
+
+        //sleep until a packet is ready on either peer or a request is posted
+        int waitMS = NETWORK_IDLE_WAIT_MS;
+        if (sessionReplayer.isRunning() || netLocal->isPolling())
+            waitMS = NETWORK_POLL_WAIT_MS;
+        else if (netLocal->isExtrapolating())
+            waitMS = DEAD_RECKONING_OUTPUT_INTERVAL_MS;
+        wakeEvent.WaitOnEvent(waitMS);
+    }
+
+    //run anything posted right before the stop (shutdowns on exit)
+    processRequests();
+
+    sessionReplayer.stop();
+    sessionRecorder.close();
+
+    delete net;
+    net = nullptr;
+    delete netLocal;
+    netLocal = nullptr;
+
+    logger.stop();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
@@ -0,0 +1,142 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       NetworkThread.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef NETWORKTHREAD_H
+#define NETWORKTHREAD_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <functional>
+#include <string>
+
+#include "LockFree.h"
+#include "LocalSharedMemory.h"
+#include "Logger.h"
+#include "SessionRecorder.h"
+#include "UiChannel.h"
+
+#include "SignaledEvent.h"
+
+#include <QThread>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const size_t NETWORK_REQUEST_QUEUE_SIZE = 256;
+    static const int NETWORK_IDLE_WAIT_MS = 50; //longest sleep without packets or requests (pings, statistics)
+    static const int NETWORK_POLL_WAIT_MS = 1; //longest sleep while a session replay or a shared memory link without wake-ups needs polling
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+class Network;
+class NetworkLocal;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Dedicated network thread. Owns the Network (copilot to copilot) and the
+NetworkLocal (copilot to DCS) instances and runs both packet loops, so command
+forwarding never waits behind repaints or log updates on the GUI thread.
+
+The GUI never calls into Network or NetworkLocal directly. Requests are posted
+with post() and run on the network thread at the top of the next loop. State
+comes back through the UiChannel.
+
+Between loops the thread sleeps until either peer has a packet ready or a
+request is posted, rather than polling.
+
+The thread also owns the SessionRecorder both peers write to and the
+SessionReplayer that feeds them. Their start and stop functions post requests
+like any other, and report the result through the log.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class NetworkThread : public QThread
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<void(Network*, NetworkLocal*)> Request;
+
+    /// Constructor
+    NetworkThread(QObject* parent = nullptr);
+    /// Destructor. Stops the thread if it is still running.
+    ~NetworkThread();
+
+    ///Queue a request to run on the network thread. GUI thread only.
+    ///Returns false if the request queue is full.
+    bool post(Request request);
+
+    ///Ask the loop to exit and wait for it to finish.
+    void stop();
+
+    ///Channel the GUI drains for state changes
+    UiChannel* getUiChannel();
+
+    ///Log of both peers. Levels and the log file may be set from the GUI thread.
+    Logger* getLogger();
+
+    ///Record every message of both peers to a new file, until stopRecording(). GUI thread only.
+    bool startRecording(const std::string& path);
+    bool stopRecording();
+
+    ///Replay the received messages of a recording into the running peers. GUI thread only.
+    ///speed 1.0 is the recorded pace, 0.0 as fast as possible.
+    bool startReplay(const std::string& path, double speed);
+    bool stopReplay();
+
+protected:
+    void run() override;
+
+private:
+    void processRequests();
+
+    UiChannel uiChannel;
+    Logger logger{&uiChannel};
+    SessionRecorder sessionRecorder;
+    SessionReplayer sessionReplayer;
+    Network* net = nullptr;
+    NetworkLocal* netLocal = nullptr;
+
+    SpscQueue<Request, NETWORK_REQUEST_QUEUE_SIZE> requests;
+    std::atomic<bool> stopRequested{false};
+
+    // Set by both peers when a packet is queued, by post() and stop(), and on Windows by the aircraft over shared memory
+    SharedSignaledEvent wakeEvent;
+
+    // Make this object be noncopyable because it holds pointers
+    NetworkThread(const NetworkThread&);
+    const NetworkThread &operator =(const NetworkThread &);
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // NETWORKTHREAD_H
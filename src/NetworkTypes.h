@@ -100,9 +100,24 @@ namespace Network {
     {
         ORDERING_CHANNEL_DEFAULT = 0,
 
+        /// Range the OrderingChannelMap assigns commands to
+        ORDERING_CHANNEL_FIRST_COMMAND = 1,
+        ORDERING_CHANNEL_LAST_COMMAND = 26,
 
-
+        ORDERING_CHANNEL_COCKPIT_ANIMATION = 27,
+        ORDERING_CHANNEL_EXTERNAL_ANIMATION = 28,
+        ORDERING_CHANNEL_SYNC = 29,
         ORDERING_CHANNEL_EVENTS = 30,
+
+        NUM_ORDERING_CHANNELS = 32,
+    };
+
+    enum LocalTransport
+    {
+        /// RakNet listener on the loopback port
+        LOCAL_TRANSPORT_RAKNET = 0,
+        /// Named shared memory rings (DcsShm.h)
+        LOCAL_TRANSPORT_SHARED_MEMORY,
     };
 }
 
@@ -0,0 +1,195 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       OrderingChannels.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      OrderingChannelMap and OrderingStalls Classes
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Command to ordering channel assignment, and the receive side estimate of how
+often each channel waited for a resend.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "OrderingChannels.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "CommandTableReader.h"
+#include "UiChannel.h"
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+OrderingChannelMap::OrderingChannelMap()
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void OrderingChannelMap::setMode(OrderingChannelMode mode_)
+{
+    mode = mode_;
+}
+
+OrderingChannelMode OrderingChannelMap::getMode() const
+{
+    return mode;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool OrderingChannelMap::loadTable(const std::string& path)
+{
+    std::vector<char> loaded(COMMAND_TABLE_SIZE, (char)ORDERING_CHANNEL_DEFAULT);
+    const char* expected = "expected \"command channel\" or \"first-last channel\"";
+    CommandTableReader reader(path);
+    while (reader.nextLine())
+    {
+        const char* text = reader.getLine();
+        unsigned int first = 0;
+        unsigned int last = 0;
+        int channel = 0;
+        if (!reader.readRange(text, COMMAND_TABLE_SIZE - 1, expected, first, last))
+            break;
+        if (sscanf(text, "%d", &channel) != 1)
+        {
+            reader.fail(expected);
+            break;
+        }
+        if (channel < ORDERING_CHANNEL_FIRST_COMMAND || channel > ORDERING_CHANNEL_LAST_COMMAND)
+        {
+            reader.fail("channel out of range");
+            break;
+        }
+
+        std::fill(loaded.begin() + first, loaded.begin() + last + 1, (char)channel);
+    }
+
+    error = reader.getError();
+    if (!error.empty())
+        return false;
+
+    table.swap(loaded);
+    mode = ORDERING_CHANNELS_TABLE;
+    return true;
+}
+
+const std::string& OrderingChannelMap::getError() const
+{
+    return error;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+char OrderingChannelMap::getChannel(unsigned short command, char aircraftChannel) const
+{
+    if (aircraftChannel != ORDERING_CHANNEL_DEFAULT || mode == ORDERING_CHANNELS_AIRCRAFT)
+        return aircraftChannel;
+
+    if (mode == ORDERING_CHANNELS_TABLE && !table.empty() && table[command] != ORDERING_CHANNEL_DEFAULT)
+        return table[command];
+
+    return getHashedChannel(command);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+char OrderingChannelMap::getHashedChannel(unsigned short command)
+{
+    //Fibonacci hashing, taking the top bits so that neighbouring groups land on different channels
+    uint32_t group = command / ORDERING_CHANNEL_HASH_GROUP;
+    uint32_t hash = group * 2654435769u;
+    return (char)(ORDERING_CHANNEL_FIRST_COMMAND + (int)(((uint64_t)hash * ORDERING_CHANNEL_HASHED_COUNT) >> 32));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+OrderingStalls::OrderingStalls()
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void OrderingStalls::add(int seatNumber, int orderingChannel, uint64_t latencyMS, int roundTripMS)
+{
+    if (orderingChannel < 0 || orderingChannel >= NUM_ORDERING_CHANNELS)
+        return;
+
+    Baseline& baseline = baselines[seatNumber];
+    baseline.currentMS = std::min(baseline.currentMS, latencyMS);
+    uint64_t baselineMS = std::min(baseline.lastMS, baseline.currentMS);
+
+    uint64_t thresholdMS = std::max(ORDERING_STALL_MIN_MS, (uint64_t)std::max(roundTripMS, 0));
+
+    ChannelStalls& channel = channels[orderingChannel];
+    channel.count++;
+    if (latencyMS > baselineMS + thresholdMS)
+    {
+        channel.stalled++;
+        channel.stalledMS += latencyMS - baselineMS;
+    }
+    changed = true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void OrderingStalls::rotateBaseline()
+{
+    for (auto& baseline : baselines)
+    {
+        baseline.second.lastMS = baseline.second.currentMS;
+        baseline.second.currentMS = UINT64_MAX;
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void OrderingStalls::clear()
+{
+    changed = !baselines.empty();
+    channels.fill(ChannelStalls());
+    baselines.clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool OrderingStalls::takeChanged()
+{
+    bool wasChanged = changed;
+    changed = false;
+    return wasChanged;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void OrderingStalls::getSummary(std::vector<OrderingStallSummary>& summary) const
+{
+    summary.clear();
+
+    for (int i = 0; i < NUM_ORDERING_CHANNELS; i++)
+    {
+        if (channels[i].count == 0)
+            continue;
+
+        OrderingStallSummary entry;
+        entry.orderingChannel = i;
+        entry.count = channels[i].count;
+        entry.stalled = channels[i].stalled;
+        entry.stalledMS = channels[i].stalledMS;
+        summary.push_back(entry);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
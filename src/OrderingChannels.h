@@ -0,0 +1,173 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       OrderingChannels.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef ORDERINGCHANNELS_H
+#define ORDERINGCHANNELS_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "NetworkTypes.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const int ORDERING_CHANNEL_HASH_GROUP = 16; //adjacent command IDs, usually one panel, share a channel
+    static const int ORDERING_CHANNEL_HASHED_COUNT = 8; //channels the hash spreads over, from ORDERING_CHANNEL_FIRST_COMMAND
+    static const uint64_t ORDERING_STALL_MIN_MS = 20; //extra delay below this is jitter, not a resend
+
+    enum OrderingChannelMode
+    {
+        /// Use the channel the aircraft passed
+        ORDERING_CHANNELS_AIRCRAFT = 0,
+        /// Hash groups of adjacent commands into independent channels
+        ORDERING_CHANNELS_HASHED,
+        /// Table file from loadTable(), hashing the commands it does not list
+        ORDERING_CHANNELS_TABLE,
+    };
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+struct OrderingStallSummary;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Picks the RakNet ordering channel of each command sent from DCS. Ordered
+messages on one channel wait for every lost message before them, so unrelated
+commands on a shared channel stall each other for a resend.
+
+Only commands the aircraft left on ORDERING_CHANNEL_DEFAULT are moved; an
+explicit channel from the aircraft is kept. The hash keeps runs of
+ORDERING_CHANNEL_HASH_GROUP command IDs together, as aircraft number the
+switches of one panel consecutively, and uses only ORDERING_CHANNEL_HASHED_COUNT
+channels so that a busy frame still packs into a few command batches.
+
+A table file lists the commands that must stay in order with each other, one
+entry per line:
+
+    # command or first-last, then channel (ORDERING_CHANNEL_FIRST_COMMAND..ORDERING_CHANNEL_LAST_COMMAND)
+    3001-3016 1
+    3020 1
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class OrderingChannelMap
+{
+public:
+    /// Constructor
+    OrderingChannelMap();
+
+    ///ORDERING_CHANNELS_TABLE needs a table from loadTable(), otherwise it hashes
+    void setMode(OrderingChannelMode mode_);
+    OrderingChannelMode getMode() const;
+
+    ///Load a table file and switch to ORDERING_CHANNELS_TABLE. Returns false and keeps the current table on error.
+    bool loadTable(const std::string& path);
+    const std::string& getError() const;
+
+    ///Channel to send a command on, given the one the aircraft passed
+    char getChannel(unsigned short command, char aircraftChannel) const;
+
+    static char getHashedChannel(unsigned short command);
+
+private:
+    OrderingChannelMode mode = ORDERING_CHANNELS_HASHED;
+    std::vector<char> table; //per command ID, ORDERING_CHANNEL_DEFAULT if not listed. Empty until loaded.
+    std::string error;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** How often each ordering channel held received commands back, waiting for a
+resend of an earlier message on it.
+
+RakNet does not report its hold-back, so it is estimated from the command stamp:
+a message is counted as stalled when its one-way latency exceeds the lowest
+latency seen from its seat recently by more than a round trip (at least
+ORDERING_STALL_MIN_MS), which is about what a resend adds. The extra delay is
+summed as the stall time.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class OrderingStalls
+{
+public:
+    /// Constructor
+    OrderingStalls();
+
+    ///Record one received ordered message. roundTripMS is the ping of the link it came over, -1 if unknown.
+    void add(int seatNumber, int orderingChannel, uint64_t latencyMS, int roundTripMS);
+
+    ///Start a new window for the per seat latency baseline, which covers the current and the last window
+    void rotateBaseline();
+
+    void clear();
+
+    ///Returns true if anything was added since the last call
+    bool takeChanged();
+
+    ///Counts of every channel that received messages, ordered by channel
+    void getSummary(std::vector<OrderingStallSummary>& summary) const;
+
+private:
+    struct ChannelStalls
+    {
+        uint64_t count = 0;
+        uint64_t stalled = 0;
+        uint64_t stalledMS = 0;
+    };
+
+    struct Baseline
+    {
+        uint64_t lastMS = UINT64_MAX;
+        uint64_t currentMS = UINT64_MAX;
+    };
+
+    std::array<ChannelStalls, NUM_ORDERING_CHANNELS> channels;
+    std::map<int, Baseline> baselines;
+    bool changed = false;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // ORDERINGCHANNELS_H
@@ -0,0 +1,105 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       PacketTrace.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      PacketTrace Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Ring of fixed size packet records, dumped to a binary file.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "PacketTrace.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "GetTime.h"
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+const char PACKET_TRACE_MAGIC[4] = { 'D', 'C', 'P', 'T' };
+const uint32_t PACKET_TRACE_VERSION = 1;
+
+static_assert((Network::PACKET_TRACE_SIZE & (Network::PACKET_TRACE_SIZE - 1)) == 0, "PACKET_TRACE_SIZE must be a power of two");
+static_assert(sizeof(Network::PacketTraceRecord) == 24, "PacketTraceRecord is part of the dump format");
+
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+PacketTrace::PacketTrace() : records(PACKET_TRACE_SIZE)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void PacketTrace::record(PacketTraceDirection direction, unsigned char messageID, char orderingChannel, unsigned char packetInfo,
+                         unsigned short command, size_t entries, size_t sizeBytes)
+{
+    PacketTraceRecord& record = records[recordCount & (PACKET_TRACE_SIZE - 1)];
+    record.timeUS = RakNet::GetTimeUS();
+    record.sizeBytes = (uint32_t)sizeBytes;
+    record.command = command;
+    record.entries = (uint16_t)std::min(entries, (size_t)0xFFFF);
+    record.direction = (uint8_t)direction;
+    record.messageID = messageID;
+    record.orderingChannel = (uint8_t)orderingChannel;
+    record.packetInfo = packetInfo;
+    recordCount++;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool PacketTrace::dump(const std::string& path) const
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    uint32_t header[3] = { PACKET_TRACE_VERSION, (uint32_t)sizeof(PacketTraceRecord), (uint32_t)size() };
+    bool ok = fwrite(PACKET_TRACE_MAGIC, sizeof(PACKET_TRACE_MAGIC), 1, file) == 1
+            && fwrite(header, sizeof(header), 1, file) == 1;
+
+    //oldest first: once the ring has wrapped, the oldest record is the next one to be overwritten
+    size_t first = (recordCount > PACKET_TRACE_SIZE) ? (size_t)(recordCount & (PACKET_TRACE_SIZE - 1)) : 0;
+    size_t count = size();
+    size_t tail = std::min(count, PACKET_TRACE_SIZE - first);
+
+    if (ok && tail > 0)
+        ok = fwrite(&records[first], sizeof(PacketTraceRecord), tail, file) == tail;
+    if (ok && count > tail)
+        ok = fwrite(&records[0], sizeof(PacketTraceRecord), count - tail, file) == count - tail;
+
+    return (fclose(file) == 0) && ok;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+size_t PacketTrace::size() const
+{
+    return (size_t)std::min(recordCount, (uint64_t)PACKET_TRACE_SIZE);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void PacketTrace::clear()
+{
+    recordCount = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
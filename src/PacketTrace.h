@@ -0,0 +1,124 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       PacketTrace.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef PACKETTRACE_H
+#define PACKETTRACE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const size_t PACKET_TRACE_SIZE = 65536; //records kept, older ones are overwritten. Must be a power of two.
+    static const uint16_t PACKET_TRACE_NO_COMMAND = 0xFFFF;
+    static const char PACKET_TRACE_FILE[] = "packet_trace.bin"; //written next to the executable when Network is destroyed
+}
+
+///Packet tracing is compiled in only with DCS_COPILOT_PACKET_TRACE defined
+///(qmake CONFIG+=packet_trace). Otherwise the macro expands to nothing and its
+///arguments are not evaluated.
+#if defined(DCS_COPILOT_PACKET_TRACE)
+#define PACKET_TRACE(trace, direction, messageID, orderingChannel, packetInfo, command, entries, sizeBytes) \
+    (trace).record((direction), (messageID), (orderingChannel), (packetInfo), (command), (entries), (sizeBytes))
+#else
+#define PACKET_TRACE(trace, direction, messageID, orderingChannel, packetInfo, command, entries, sizeBytes) \
+    do { } while (0)
+#endif
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+enum PacketTraceDirection
+{
+    PACKET_TRACE_SEND = 0,
+    PACKET_TRACE_RECEIVE,
+    PACKET_TRACE_RELAY, //host only, received packet forwarded to the other clients
+};
+
+///One traced packet, written to the dump as is (little endian, 24 bytes)
+struct PacketTraceRecord
+{
+    uint64_t timeUS = 0; //RakNet::GetTimeUS()
+    uint32_t sizeBytes = 0;
+    uint16_t command = PACKET_TRACE_NO_COMMAND; //first command of a batch
+    uint16_t entries = 0; //commands and events in the packet
+    uint8_t direction = PACKET_TRACE_SEND;
+    uint8_t messageID = 0;
+    uint8_t orderingChannel = 0;
+    uint8_t packetInfo = 0; //priority | reliability << 2 | compression type << 5
+    uint32_t reserved = 0;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Binary trace of command packets for offline analysis.
+
+record() stores a fixed size record in a preallocated ring, nothing is formatted
+on the packet path. dump() writes the ring oldest first:
+
+    magic           4 bytes "DCPT"
+    version         uint32
+    record size     uint32
+    record count    uint32
+    records         PacketTraceRecord[record count]
+
+Not thread safe, the network thread owns it.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class PacketTrace
+{
+public:
+    /// Constructor
+    PacketTrace();
+
+    ///Store one record, overwriting the oldest once the ring is full
+    void record(PacketTraceDirection direction, unsigned char messageID, char orderingChannel, unsigned char packetInfo,
+                unsigned short command, size_t entries, size_t sizeBytes);
+
+    ///Write the records to a file. Returns false if it could not be written.
+    bool dump(const std::string& path) const;
+
+    ///Number of records stored, at most PACKET_TRACE_SIZE
+    size_t size() const;
+
+    void clear();
+
+private:
+    std::vector<PacketTraceRecord> records;
+    uint64_t recordCount = 0; //ever recorded, the next record goes to recordCount % PACKET_TRACE_SIZE
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // PACKETTRACE_H
@@ -0,0 +1,225 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       SeatInterest.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      SeatInterest Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+The commands and events a seat consumes, loaded from a table file on the client
+and exchanged with the host in seat requests.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "SeatInterest.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "CommandBatch.h"
+#include "CommandTableReader.h"
+
+#include "BitStream.h"
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+SeatInterest::SeatInterest()
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool SeatInterest::load(const std::string& path)
+{
+    const char* expected = "expected \"command first-last\" or \"event first-last\"";
+    std::vector<std::pair<uint16_t, uint16_t>> loadedRanges;
+    std::bitset<256> loadedEvents;
+    bool hasEvents = false;
+
+    CommandTableReader reader(path);
+    while (reader.nextLine())
+    {
+        const char* text = reader.getLine();
+        char kind[16] = {0};
+        int rangeOffset = 0;
+        unsigned int first = 0;
+        unsigned int last = 0;
+        if (sscanf(text, "%15s %n", kind, &rangeOffset) != 1)
+        {
+            reader.fail(expected);
+            break;
+        }
+
+        std::string kindStr = kind;
+        if (kindStr != "command" && kindStr != "event")
+        {
+            reader.fail("unknown entry \"" + kindStr + "\"");
+            break;
+        }
+        text += rangeOffset;
+        if (!reader.readRange(text, (kindStr == "event") ? 255 : COMMAND_TABLE_SIZE - 1, expected, first, last))
+            break;
+
+        if (kindStr == "command")
+        {
+            loadedRanges.push_back(std::make_pair((uint16_t)first, (uint16_t)last));
+        }
+        else
+        {
+            hasEvents = true;
+            for (unsigned int id = first; id <= last; id++)
+                loadedEvents.set(id);
+        }
+    }
+
+    error = reader.getError();
+    if (!error.empty())
+        return false;
+
+    commandRanges.swap(loadedRanges);
+    allCommands = commandRanges.empty();
+    allEvents = !hasEvents;
+    events = loadedEvents;
+    applyRanges();
+    return true;
+}
+
+const std::string& SeatInterest::getError() const
+{
+    return error;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void SeatInterest::setAll()
+{
+    allCommands = true;
+    allEvents = true;
+    commandRanges.clear();
+    commands.reset();
+    events.reset();
+}
+
+bool SeatInterest::isAll() const
+{
+    return allCommands && allEvents;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool SeatInterest::wantsCommand(unsigned short command) const
+{
+    return allCommands || commands.test(command);
+}
+
+bool SeatInterest::wantsEvent(unsigned char eventID) const
+{
+    return allEvents || events.test(eventID);
+}
+
+bool SeatInterest::wantsAny(const CommandBatchEntry* entries, size_t numEntries) const
+{
+    for (size_t i = 0; i < numEntries; i++)
+    {
+        if (entries[i].type == BATCH_EVENT ? wantsEvent(entries[i].eventID) : wantsCommand(entries[i].command))
+            return true;
+    }
+    return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void SeatInterest::write(RakNet::BitStream& bsOut) const
+{
+    bsOut.Write(allCommands);
+    if (!allCommands)
+    {
+        bsOut.Write((uint16_t)commandRanges.size());
+        for (const auto& range : commandRanges)
+        {
+            bsOut.Write(range.first);
+            bsOut.Write(range.second);
+        }
+    }
+
+    bsOut.Write(allEvents);
+    if (!allEvents)
+    {
+        for (unsigned int id = 0; id < events.size(); id++)
+            bsOut.Write(events.test(id));
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool SeatInterest::read(RakNet::BitStream& bsIn)
+{
+    setAll();
+
+    //a client without interest tables sends nothing here
+    bool readAllCommands = true;
+    if (!bsIn.Read(readAllCommands))
+        return false;
+
+    std::vector<std::pair<uint16_t, uint16_t>> readRanges;
+    if (!readAllCommands)
+    {
+        uint16_t numRanges = 0;
+        if (!bsIn.Read(numRanges))
+            return false;
+        for (uint16_t i = 0; i < numRanges; i++)
+        {
+            std::pair<uint16_t, uint16_t> range;
+            if (!bsIn.Read(range.first) || !bsIn.Read(range.second) || range.first > range.second)
+                return false;
+            readRanges.push_back(range);
+        }
+    }
+
+    bool readAllEvents = true;
+    std::bitset<256> readEvents;
+    if (!bsIn.Read(readAllEvents))
+        return false;
+    if (!readAllEvents)
+    {
+        for (unsigned int id = 0; id < readEvents.size(); id++)
+        {
+            bool wanted = false;
+            if (!bsIn.Read(wanted))
+                return false;
+            readEvents.set(id, wanted);
+        }
+    }
+
+    allCommands = readAllCommands;
+    allEvents = readAllEvents;
+    commandRanges.swap(readRanges);
+    events = readEvents;
+    applyRanges();
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void SeatInterest::applyRanges()
+{
+    commands.reset();
+    for (const auto& range : commandRanges)
+    {
+        for (unsigned int command = range.first; command <= range.second; command++)
+            commands.set(command);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
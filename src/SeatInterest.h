@@ -0,0 +1,109 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       SeatInterest.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef SEATINTEREST_H
+#define SEATINTEREST_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace RakNet {
+class BitStream;
+}
+
+namespace Network {
+
+struct CommandBatchEntry;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** The command IDs and event IDs a seat consumes. A client sends its interest
+with every ID_NET_CLIENT_SEAT_REQUEST, and the host only forwards a command
+message to a seat if the seat wants something in it.
+
+By default a seat wants everything. A table file narrows it down, one entry per
+line:
+
+    # "command" or "event", then an ID or first-last
+    command 3001-3016
+    command 3020
+    event 1-4
+
+A file without command lines still wants every command, and one without event
+lines every event.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class SeatInterest
+{
+public:
+    /// Constructor, wanting everything
+    SeatInterest();
+
+    ///Load a table file. Returns false and keeps the current interest on error.
+    bool load(const std::string& path);
+    const std::string& getError() const;
+
+    ///Want every command and event
+    void setAll();
+
+    ///Returns true if nothing is filtered
+    bool isAll() const;
+
+    bool wantsCommand(unsigned short command) const;
+    bool wantsEvent(unsigned char eventID) const;
+
+    ///Returns true if any of the entries is wanted
+    bool wantsAny(const CommandBatchEntry* entries, size_t numEntries) const;
+
+    ///Write the interest for the host
+    void write(RakNet::BitStream& bsOut) const;
+
+    ///Read an interest written by write(). Returns false and wants everything if it is missing or malformed.
+    bool read(RakNet::BitStream& bsIn);
+
+private:
+    void applyRanges();
+
+    bool allCommands = true;
+    bool allEvents = true;
+    std::vector<std::pair<uint16_t, uint16_t>> commandRanges; //as sent to the host
+    std::bitset<65536> commands;
+    std::bitset<256> events;
+    std::string error;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // SEATINTEREST_H
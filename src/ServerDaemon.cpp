@@ -0,0 +1,268 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       ServerDaemon.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      ServerDaemon Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Runs a copilot host without any widgets, for a relay on a server near the
+players.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+Shutdown mirrors MainWindow::closeProgram(): disconnect is posted first so the
+clients are told, and the application quits a second later.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "ServerDaemon.h"
+
+#include <atomic>
+#include <iostream>
+
+#include "Network.h"
+#include "NetworkLocal.h"
+#include "UiChannel.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QSettings>
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+std::atomic<bool> stopRequested{false};
+
+const Network::UiClient* findClient(const Network::UiState& uiState, const QString& id)
+{
+    for (const Network::UiClient& client : uiState.clients)
+    {
+        if (client.id == id)
+            return &client;
+    }
+    return nullptr;
+}
+
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+ServerDaemon::ServerDaemon(const ServerDaemonConfig& config_, QObject* parent) : QObject(parent), config(config_)
+{
+    pollTimer.setInterval(SERVER_DAEMON_POLL_MS);
+    connect(&pollTimer, SIGNAL(timeout()), this, SLOT(processNetworkEvents()));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ServerDaemon::~ServerDaemon()
+{
+    pollTimer.stop();
+    networkThread.stop();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool ServerDaemon::start()
+{
+    Logger* logger = networkThread.getLogger();
+    logger->setLevel(config.logLevel);
+    if (!config.logFile.empty() && !logger->setLogFile(config.logFile)) {
+        printLine(QString("ERROR: Cannot open log file: %1").arg(QString::fromStdString(config.logFile)));
+        return false;
+    }
+
+    networkThread.start(QThread::TimeCriticalPriority);
+    pollTimer.start();
+
+    if (!config.recordFile.empty())
+        networkThread.startRecording(config.recordFile);
+
+    if (config.startListener)
+    {
+        LocalTransport listenerTransport = config.listenerTransport;
+        postRequest([listenerTransport](Network*, NetworkLocal* netLocal) {
+            netLocal->startServer(listenerTransport);
+        });
+    }
+
+    ServerDaemonConfig startConfig = config;
+    postRequest([startConfig](Network* net, NetworkLocal*) {
+        net->setTickTimeMS(startConfig.tickTimeMS);
+        net->setTimeoutTimeMS(startConfig.timeoutTimeMS);
+        net->setMaxClients(startConfig.maxClients);
+        net->setUpdateWorkers(startConfig.updateWorkers);
+        if (!startConfig.orderingChannels.empty())
+            net->setOrderingChannels(startConfig.orderingChannels);
+        if (!startConfig.deadReckoning.empty())
+            net->setDeadReckoning(startConfig.deadReckoning);
+        if (!startConfig.codecProfile.empty())
+            net->setCodecProfile(startConfig.codecProfile);
+        if (!net->startServer(startConfig.port, startConfig.clientName, startConfig.password)) {
+            ServerDaemon::requestStop();
+        }
+    });
+
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ServerDaemon::requestStop()
+{
+    stopRequested = true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ServerDaemon::processNetworkEvents()
+{
+    if (stopRequested && !stopping)
+    {
+        stopping = true;
+        printLine("Shutting down");
+        postRequest([](Network* net, NetworkLocal* netLocal) {
+            netLocal->disconnect();
+            net->disconnect();
+        });
+        QTimer::singleShot(1000, QCoreApplication::instance(), SLOT(quit()));
+    }
+
+    while (!unpostedRequests.empty() && networkThread.post(unpostedRequests.front())) {
+        unpostedRequests.pop_front();
+    }
+
+    UiChannel* uiChannel = networkThread.getUiChannel();
+
+    //the Logger has already written these to the console and the log file
+    QString logLines;
+    while (uiChannel->popLogBatch(logLines)) {
+    }
+
+    QString logMsg;
+    while (uiChannel->popLogMessage(logMsg)) {
+        printLine(logMsg);
+    }
+
+    UiState newState;
+    if (uiChannel->readState(newState)) {
+        reportUiState(newState);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ServerDaemon::reportUiState(const UiState& newState)
+{
+    if (newState.listenerRunning != uiState.listenerRunning)
+        printLine(newState.listenerRunning ? "DCS listener started" : "DCS listener stopped");
+    if (newState.dcsRunning != uiState.dcsRunning)
+        printLine(newState.dcsRunning ? "DCS connected" : "DCS disconnected");
+
+    if (newState.serverStatusChanges != uiState.serverStatusChanges)
+    {
+        if (newState.serverStatus == SS_HOSTING)
+        {
+            hosting = true;
+            printLine(QString("Hosting on port %1, up to %2 clients").arg(config.port).arg(config.maxClients));
+            applyBanList();
+
+            if (!config.replayFile.empty())
+                networkThread.startReplay(config.replayFile, config.replaySpeed);
+        }
+        else if (newState.serverStatus == SS_NOT_CONNECTED && hosting)
+        {
+            hosting = false;
+            printLine("Host stopped");
+            requestStop();
+        }
+    }
+
+    for (const UiClient& client : uiState.clients)
+    {
+        if (!findClient(newState, client.id))
+            printLine(QString("Client left: %1").arg(client.id));
+    }
+    for (const UiClient& client : newState.clients)
+    {
+        const UiClient* oldClient = findClient(uiState, client.id);
+        if (oldClient == nullptr)
+            printLine(QString("Client joined: %1 (%2)").arg(client.name).arg(client.id));
+        if (client.seatNumber != (oldClient ? oldClient->seatNumber : 0))
+            printLine(QString("Seat %1: %2").arg(client.seatNumber).arg(client.id));
+    }
+
+    for (size_t i = uiState.bannedAddresses.size(); i < newState.bannedAddresses.size(); i++)
+    {
+        printLine(QString("Banned %1").arg(newState.bannedAddresses[i]));
+        addToBanList(newState.bannedAddresses[i]);
+    }
+
+    uiState = newState;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ServerDaemon::printLine(const QString& line) const
+{
+    std::cout << QDateTime::currentDateTime().toString("hh:mm:ss").toStdString() << "   " << line.toStdString() << std::endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ServerDaemon::postRequest(NetworkThread::Request request)
+{
+    if (unpostedRequests.empty() && networkThread.post(request))
+        return;
+
+    if (unpostedRequests.empty()) {
+        printLine("The network thread is busy, requests are delayed");
+    }
+    unpostedRequests.push_back(std::move(request));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ServerDaemon::applyBanList()
+{
+    QStringList banList = config.banList;
+    postRequest([banList](Network* net, NetworkLocal*) {
+        net->clearBanList();
+        for (int i = 0; i < banList.size(); i++)
+        {
+            net->banIpFromServer(banList.at(i).toStdString());
+        }
+    });
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void ServerDaemon::addToBanList(const QString& clientAddress)
+{
+    if (config.banList.contains(clientAddress))
+        return;
+
+    config.banList.append(clientAddress);
+
+    if (!config.configFile.isEmpty())
+    {
+        QSettings settings(config.configFile, QSettings::IniFormat);
+        settings.setValue("banList", config.banList);
+    }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
@@ -0,0 +1,135 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       ServerDaemon.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef SERVERDAEMON_H
+#define SERVERDAEMON_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <deque>
+#include <string>
+
+#include "Logger.h"
+#include "NetworkThread.h"
+#include "NetworkTypes.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const int SERVER_DAEMON_POLL_MS = 100; //how often client list changes are printed and a stop request is checked
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+///Host settings. Read from the config file, then overridden by command line flags.
+struct ServerDaemonConfig
+{
+    std::string clientName = "DedicatedHost";
+    unsigned short port = 39640;
+    std::string password;
+    int tickTimeMS = 10; //Network::setTickTimeMS()
+    int timeoutTimeMS = 10000;
+    int maxClients = 8;
+    int updateWorkers = 0; //Network::setUpdateWorkers()
+    bool startListener = false; //also accept a local DCS connection, for a host that flies
+    LocalTransport listenerTransport = LOCAL_TRANSPORT_RAKNET;
+    std::string orderingChannels; //Network::setOrderingChannels(), empty for the default
+    std::string deadReckoning; //Network::setDeadReckoning(), empty for the default
+    std::string codecProfile; //Network::setCodecProfile(), empty for none
+    LogLevel logLevel = LOG_INFO;
+    std::string logFile;
+    QString configFile; //empty if none, bans are written back to it
+    QStringList banList;
+    std::string recordFile; //record the session to this file, empty if none
+    std::string replayFile; //replay this recording once hosting, empty if none
+    double replaySpeed = 1.0;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Headless host for the dcs_copilot_server target. Takes the place of MainWindow:
+owns the NetworkThread, posts the start requests and drains the UiChannel on a
+timer, printing client list and status changes to the console instead of
+updating widgets. Log lines reach the console and log file through the Logger.
+
+requestStop() may be called from a signal handler; the daemon shuts the host
+down on its next poll and quits the application. It also quits when the host
+cannot be started or stops on its own.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class ServerDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Constructor
+    ServerDaemon(const ServerDaemonConfig& config_, QObject* parent = nullptr);
+    /// Destructor. Stops the network thread.
+    ~ServerDaemon();
+
+    ///Start the network thread and the host. Returns false if the log file cannot be opened.
+    bool start();
+
+    ///Ask the daemon to shut down. Async signal safe.
+    static void requestStop();
+
+private slots:
+    void processNetworkEvents();
+
+private:
+    void printLine(const QString& line) const;
+    ///Print what changed since the last state and act on the host starting or stopping
+    void reportUiState(const UiState& newState);
+    void postRequest(NetworkThread::Request request);
+    void applyBanList();
+    void addToBanList(const QString& clientAddress);
+
+    ServerDaemonConfig config;
+    NetworkThread networkThread; //a member rather than new, it holds cache line aligned queues
+    QTimer pollTimer;
+    std::deque<NetworkThread::Request> unpostedRequests; //requests the full request queue did not take, posted again in order by the poll timer
+    UiState uiState; //as last reported
+    bool hosting = false;
+    bool stopping = false;
+
+    // Make this object be noncopyable
+    ServerDaemon(const ServerDaemon&);
+    const ServerDaemon &operator =(const ServerDaemon &);
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // SERVERDAEMON_H
@@ -0,0 +1,405 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       SessionRecorder.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      SessionRecorder and SessionReplayer Classes
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Memory-mapped capture of all copilot and DCS traffic, and its replay.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+A recording that was not closed (crash, power loss) keeps the zero filled tail
+of its last chunk. A zero length ends the message list, so it still replays.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "SessionRecorder.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "Network.h"
+#include "NetworkLocal.h"
+
+#include "BitStream.h"
+#include "GetTime.h"
+#include "MessageIdentifiers.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+const char SESSION_RECORD_MAGIC[4] = { 'D', 'C', 'S', 'R' };
+
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+SessionRecorder::SessionRecorder()
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+SessionRecorder::~SessionRecorder()
+{
+    close();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool SessionRecorder::open(const std::string& path)
+{
+    close();
+
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+    file = handle;
+#else
+    file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+        return false;
+#endif
+
+    if (!grow(SESSION_RECORD_CHUNK_SIZE))
+        return false;
+
+    uint64_t startTimeUS = RakNet::GetTimeUS();
+    memcpy(view, SESSION_RECORD_MAGIC, sizeof(SESSION_RECORD_MAGIC));
+    memcpy(view + 4, &SESSION_RECORD_VERSION, sizeof(uint32_t));
+    memcpy(view + 8, &startTimeUS, sizeof(uint64_t));
+    size = SESSION_RECORD_FILE_HEADER_SIZE;
+    dropped = 0;
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void SessionRecorder::close()
+{
+    if (!isOpen())
+        return;
+
+    unmap();
+
+#if defined(_WIN32)
+    LARGE_INTEGER end;
+    end.QuadPart = (LONGLONG)size;
+    SetFilePointerEx(file, end, NULL, FILE_BEGIN);
+    SetEndOfFile(file);
+    CloseHandle(file);
+    file = nullptr;
+#else
+    if (ftruncate(file, (off_t)size) != 0) {
+        //keeps the zero tail, which replays fine
+    }
+    ::close(file);
+    file = -1;
+#endif
+
+    capacity = 0;
+    size = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool SessionRecorder::isOpen() const
+{
+#if defined(_WIN32)
+    return file != nullptr;
+#else
+    return file >= 0;
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+uint64_t SessionRecorder::getSize() const
+{
+    return size;
+}
+
+unsigned int SessionRecorder::getDroppedCount() const
+{
+    return dropped;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void SessionRecorder::record(SessionRecordSource source, const unsigned char* data, unsigned int length)
+{
+    if (view == nullptr || length == 0)
+        return;
+
+    //growing remaps the file, which is left to reserve() between loops
+    size_t needed = size + SESSION_RECORD_HEADER_SIZE + length;
+    if (needed > capacity)
+    {
+        dropped++;
+        return;
+    }
+
+    uint64_t timeUS = RakNet::GetTimeUS();
+    unsigned char sourceByte = (unsigned char)source;
+    unsigned char* out = view + size;
+    memcpy(out, &timeUS, sizeof(uint64_t));
+    memcpy(out + 8, &sourceByte, 1);
+    memcpy(out + 9, &length, sizeof(uint32_t));
+    memcpy(out + SESSION_RECORD_HEADER_SIZE, data, length);
+    size = needed;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void SessionRecorder::reserve()
+{
+    if (view != nullptr && capacity - size < SESSION_RECORD_HEADROOM)
+        grow(size + SESSION_RECORD_HEADROOM);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool SessionRecorder::grow(size_t minimumCapacity)
+{
+    size_t newCapacity = capacity;
+    while (newCapacity < minimumCapacity)
+        newCapacity += SESSION_RECORD_CHUNK_SIZE;
+
+    //the written pages stay in the file, the new view maps them again
+    unmap();
+
+#if defined(_WIN32)
+    //a mapping larger than the file extends it
+    mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, (DWORD)((uint64_t)newCapacity >> 32), (DWORD)(newCapacity & 0xFFFFFFFF), NULL);
+    if (mapping != NULL)
+        view = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, newCapacity);
+#else
+    if (ftruncate(file, (off_t)newCapacity) == 0)
+    {
+        void* address = mmap(nullptr, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        if (address != MAP_FAILED)
+            view = (unsigned char*)address;
+    }
+#endif
+
+    if (view == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    capacity = newCapacity;
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void SessionRecorder::unmap()
+{
+#if defined(_WIN32)
+    if (view != nullptr)
+        UnmapViewOfFile(view);
+    if (mapping != nullptr)
+        CloseHandle(mapping);
+    mapping = nullptr;
+#else
+    if (view != nullptr)
+        munmap(view, capacity);
+#endif
+
+    view = nullptr;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+SessionReplayer::SessionReplayer()
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool SessionReplayer::start(const std::string& path, double speed_)
+{
+    stop();
+    contents.clear();
+    messages.clear();
+    error.clear();
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        error = "could not open " + path;
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (fileSize > 0)
+    {
+        contents.resize((size_t)fileSize);
+        if (fread(&contents[0], 1, contents.size(), file) != contents.size())
+            contents.clear();
+    }
+    fclose(file);
+
+    uint32_t version = 0;
+    if (contents.size() >= SESSION_RECORD_FILE_HEADER_SIZE)
+        memcpy(&version, &contents[4], sizeof(uint32_t));
+
+    if (contents.size() < SESSION_RECORD_FILE_HEADER_SIZE || memcmp(&contents[0], SESSION_RECORD_MAGIC, sizeof(SESSION_RECORD_MAGIC)) != 0)
+    {
+        error = path + " is not a session recording";
+        return false;
+    }
+    if (version != SESSION_RECORD_VERSION)
+    {
+        error = path + " was recorded by a different version";
+        return false;
+    }
+
+    size_t offset = SESSION_RECORD_FILE_HEADER_SIZE;
+    while (offset + SESSION_RECORD_HEADER_SIZE <= contents.size())
+    {
+        Message message;
+        unsigned char sourceByte = 0;
+        memcpy(&message.timeUS, &contents[offset], sizeof(uint64_t));
+        memcpy(&sourceByte, &contents[offset + 8], 1);
+        memcpy(&message.length, &contents[offset + 9], sizeof(uint32_t));
+        message.source = static_cast<SessionRecordSource>(sourceByte);
+        message.offset = offset + SESSION_RECORD_HEADER_SIZE;
+
+        //zero tail of a recording that was not closed, or a cut message
+        if (message.length == 0 || message.offset + message.length > contents.size())
+            break;
+
+        if (message.source == SESSION_NET_IN || message.source == SESSION_LOCAL_IN)
+            messages.push_back(message);
+
+        offset = message.offset + message.length;
+    }
+
+    if (messages.empty())
+    {
+        error = path + " has no received messages to replay";
+        return false;
+    }
+
+    speed = (speed_ > 0.0) ? speed_ : 0.0;
+    next = 0;
+    replayed = 0;
+    replayStartUS = RakNet::GetTimeUS();
+    running = true;
+    return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void SessionReplayer::stop()
+{
+    running = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool SessionReplayer::isRunning() const
+{
+    return running;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void SessionReplayer::update(Network* net, NetworkLocal* netLocal)
+{
+    if (!running)
+        return;
+
+    uint64_t nowUS = RakNet::GetTimeUS();
+    RakNet::Time nowMS = RakNet::GetTime();
+    uint64_t firstTimeUS = messages.front().timeUS;
+    unsigned int pushed = 0;
+
+    while (next < messages.size())
+    {
+        const Message& message = messages[next];
+
+        if (speed > 0.0)
+        {
+            uint64_t dueUS = replayStartUS + (uint64_t)((double)(message.timeUS - firstTimeUS) / speed);
+            if (dueUS > nowUS)
+                break;
+        }
+        else if (pushed >= SESSION_REPLAY_MAX_PER_UPDATE)
+        {
+            break;
+        }
+
+        const unsigned char* data = &contents[message.offset];
+        if (data[0] == ID_TIMESTAMP && message.length > sizeof(RakNet::MessageID) + sizeof(RakNet::Time))
+        {
+            //keep the recorded latency: move the stamp by the time since the message was recorded
+            scratch.assign(data, data + message.length);
+            RakNet::BitStream stampBS(&scratch[sizeof(RakNet::MessageID)], sizeof(RakNet::Time), false);
+            RakNet::Time stamp = 0;
+            stampBS.Read(stamp);
+            stamp += nowMS - (RakNet::Time)(message.timeUS / 1000);
+            stampBS.SetWriteOffset(0);
+            stampBS.Write(stamp);
+            data = &scratch[0];
+        }
+
+        bool accepted = (message.source == SESSION_NET_IN) ? net->replayPacket(data, message.length)
+                                                           : netLocal->replayPacket(data, message.length);
+        if (accepted)
+            replayed++;
+
+        next++;
+        pushed++;
+    }
+
+    if (next >= messages.size())
+        running = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int SessionReplayer::getReplayedCount() const
+{
+    return replayed;
+}
+
+unsigned int SessionReplayer::getMessageCount() const
+{
+    return (unsigned int)messages.size();
+}
+
+const std::string& SessionReplayer::getError() const
+{
+    return error;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
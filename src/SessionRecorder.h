@@ -0,0 +1,220 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       SessionRecorder.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef SESSIONRECORDER_H
+#define SESSIONRECORDER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const size_t SESSION_RECORD_CHUNK_SIZE = 16 * 1024 * 1024; //the mapping grows by this much at a time
+    static const size_t SESSION_RECORD_HEADROOM = 4 * 1024 * 1024; //reserve() grows the mapping once less than this is left
+    static const uint32_t SESSION_RECORD_VERSION = 1;
+    static const size_t SESSION_RECORD_FILE_HEADER_SIZE = 16; //magic, version, start time
+    static const size_t SESSION_RECORD_HEADER_SIZE = 13; //time, source, length
+    static const unsigned int SESSION_REPLAY_MAX_PER_UPDATE = 1024; //messages per loop when replaying as fast as possible
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+class Network;
+class NetworkLocal;
+
+enum SessionRecordSource
+{
+    SESSION_NET_IN = 0, //from another copilot or the host
+    SESSION_NET_OUT, //to the host, or from the host to clients
+    SESSION_LOCAL_IN, //from DCS
+    SESSION_LOCAL_OUT, //to DCS
+    NUM_SESSION_RECORD_SOURCES
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Append-only capture of every message Network and NetworkLocal send and
+receive, for reproducing desyncs and replaying real traffic.
+
+The file is memory-mapped, so record() is a copy into the mapping and the OS
+writes the pages back on its own. The hot path never waits on the disk.
+record() never resizes the file either: the network thread calls reserve()
+between loops, which grows the mapping by SESSION_RECORD_CHUNK_SIZE once less
+than SESSION_RECORD_HEADROOM is left. A message that does not fit before then
+is dropped and counted. close() trims the file to what was written.
+
+File layout, in native byte order:
+    "DCSR", version     4 + 4 bytes
+    start time          8 bytes, RakNet::GetTimeUS() when recording started
+    per message:
+        time            8 bytes, RakNet::GetTimeUS()
+        source          1 byte (SessionRecordSource)
+        length          4 bytes
+        data            the RakNet message, starting with its message ID
+
+Received messages are recorded after RakNet shifted any ID_TIMESTAMP into
+the local clock, so stamps compare directly with the record times.
+
+Network thread only.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class SessionRecorder
+{
+public:
+    /// Constructor
+    SessionRecorder();
+    /// Destructor. Closes the file.
+    ~SessionRecorder();
+
+    ///Start a new recording, replacing the file. Returns false if it could not be created.
+    bool open(const std::string& path);
+
+    ///Trim the file to its contents and close it
+    void close();
+
+    bool isOpen() const;
+
+    ///Append one message. Does nothing if not open.
+    void record(SessionRecordSource source, const unsigned char* data, unsigned int length);
+
+    ///Grow the file ahead of record() if it is running out of room. Call between loops, when nothing waits on the thread.
+    void reserve();
+
+    ///Bytes written including headers
+    uint64_t getSize() const;
+
+    ///Messages dropped because the file had not grown in time
+    unsigned int getDroppedCount() const;
+
+private:
+    ///Map a larger view of the file. Returns false (and closes) if the file could not grow.
+    bool grow(size_t minimumCapacity);
+    void unmap();
+
+#if defined(_WIN32)
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int file = -1;
+#endif
+
+    unsigned char* view = nullptr;
+    size_t capacity = 0;
+    size_t size = 0;
+    unsigned int dropped = 0;
+
+    // Make this object be noncopyable because it holds a file
+    SessionRecorder(const SessionRecorder&);
+    const SessionRecorder &operator =(const SessionRecorder &);
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Plays a SessionRecorder file back into a running Network and NetworkLocal.
+
+Received messages are pushed into the receive queue of the peer that got them,
+so they go through the same update() decode, relay and DCS forwarding as live
+traffic. Messages from copilots are replayed into Network and messages from DCS
+into NetworkLocal. Sent messages are in the file for analysis and are not
+replayed, since the replayed input produces them again.
+
+Only command and animation messages are replayed. Connection, client list and
+seat messages describe peers that are not there. A host drops replayed
+animation frames, as it only relays frames from the client holding the seat.
+
+Command stamps are moved forward by the time since recording, so latency
+statistics show the recorded latency plus the replay's own.
+
+speed 1.0 replays at the recorded pace, 2.0 twice as fast, and 0.0 as fast as
+the loop allows (SESSION_REPLAY_MAX_PER_UPDATE per update).
+
+Network thread only.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class SessionReplayer
+{
+public:
+    /// Constructor
+    SessionReplayer();
+
+    ///Load a recording and start replaying it from the next update(). Returns false with error set if it could not be read.
+    bool start(const std::string& path, double speed_);
+
+    void stop();
+
+    bool isRunning() const;
+
+    ///Push every message that is due into the peers. Stops by itself at the end of the file.
+    void update(Network* net, NetworkLocal* netLocal);
+
+    ///Messages the peers accepted so far, and the received messages in the file
+    unsigned int getReplayedCount() const;
+    unsigned int getMessageCount() const;
+
+    const std::string& getError() const;
+
+private:
+    struct Message
+    {
+        uint64_t timeUS;
+        SessionRecordSource source;
+        size_t offset; //of the data in contents
+        unsigned int length;
+    };
+
+    std::vector<unsigned char> contents;
+    std::vector<Message> messages; //received ones only
+    std::vector<unsigned char> scratch; //message with its stamp moved, reused
+
+    size_t next = 0;
+    unsigned int replayed = 0;
+    double speed = 1.0;
+    uint64_t replayStartUS = 0;
+    bool running = false;
+    std::string error;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // SESSIONRECORDER_H
@@ -0,0 +1,149 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       StatisticsSampler.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      StatisticsHistory and StatisticsSampler Classes
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Fixed rate sampling of the RakNet connection statistics into a ring buffer.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "StatisticsSampler.h"
+
+#include <algorithm>
+
+#include "RakPeerInterface.h"
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+StatisticsHistory::StatisticsHistory()
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void StatisticsHistory::setCapacity(size_t capacity_)
+{
+    capacity = std::max<size_t>(1, std::min(capacity_, STATISTICS_HISTORY_SIZE));
+    clear();
+}
+
+void StatisticsHistory::push(const StatisticsSample& sample)
+{
+    samples[next] = sample;
+    next = (next + 1) % capacity;
+    if (count < capacity)
+        count++;
+}
+
+void StatisticsHistory::clear()
+{
+    next = 0;
+    count = 0;
+}
+
+size_t StatisticsHistory::size() const
+{
+    return count;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void StatisticsHistory::getSamples(std::vector<StatisticsSample>& samples_) const
+{
+    samples_.clear();
+    size_t first = (next + capacity - count) % capacity;
+    for (size_t i = 0; i < count; i++)
+        samples_.push_back(samples[(first + i) % capacity]);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+StatisticsSampler::StatisticsSampler()
+{
+    setRate(STATISTICS_DEFAULT_RATE_HZ);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void StatisticsSampler::setRate(int rateHz_)
+{
+    rateHz = std::max(STATISTICS_MIN_RATE_HZ, std::min(rateHz_, STATISTICS_MAX_RATE_HZ));
+    intervalMS = (RakNet::Time)(1000 / rateHz);
+    history.setCapacity((size_t)(rateHz * STATISTICS_HISTORY_SECONDS));
+}
+
+int StatisticsSampler::getRate() const
+{
+    return rateHz;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool StatisticsSampler::isDue(RakNet::Time currentTime) const
+{
+    return history.size() == 0 || currentTime - lastSampleTime >= intervalMS;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void StatisticsSampler::sample(RakNet::RakPeerInterface* peer, RakNet::Time currentTime)
+{
+    if (history.size() == 0)
+        firstSampleTime = currentTime;
+    lastSampleTime = currentTime;
+
+    StatisticsSample next;
+    next.timeMS = currentTime - firstSampleTime;
+
+    //GetStatistics(UNASSIGNED_SYSTEM_ADDRESS) would add up the same peers, but loses the worst link
+    unsigned int numPeers = peer->GetMaximumNumberOfPeers();
+    for (unsigned int index = 0; index < numPeers; index++)
+    {
+        if (!peer->GetStatistics(index, &peerStatistics))
+            continue;
+
+        next.bandwidthSendRate += peerStatistics.valueOverLastSecond[RakNet::ACTUAL_BYTES_SENT];
+        next.bandwidthReceiveRate += peerStatistics.valueOverLastSecond[RakNet::ACTUAL_BYTES_RECEIVED];
+        next.bandwidthSentTotal += peerStatistics.runningTotal[RakNet::ACTUAL_BYTES_SENT];
+        next.bandwidthReceivedTotal += peerStatistics.runningTotal[RakNet::ACTUAL_BYTES_RECEIVED];
+        next.packetLoss = std::max(next.packetLoss, peerStatistics.packetlossLastSecond);
+        next.ping = std::max(next.ping, peer->GetAveragePing(peer->GetSystemAddressFromIndex(index)));
+    }
+
+    latest = next;
+    history.push(latest);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const StatisticsSample& StatisticsSampler::getLatest() const
+{
+    return latest;
+}
+
+const StatisticsHistory& StatisticsSampler::getHistory() const
+{
+    return history;
+}
+
+void StatisticsSampler::clear()
+{
+    latest = StatisticsSample();
+    history.clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
@@ -0,0 +1,147 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       StatisticsSampler.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef STATISTICSSAMPLER_H
+#define STATISTICSSAMPLER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "RakNetStatistics.h"
+#include "RakNetTime.h"
+
+#include "UiChannel.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const int STATISTICS_DEFAULT_RATE_HZ = 4;
+    static const int STATISTICS_MIN_RATE_HZ = 1;
+    static const int STATISTICS_MAX_RATE_HZ = 20;
+    static const int STATISTICS_HISTORY_SECONDS = 60; //span of the graphs
+    static const size_t STATISTICS_HISTORY_SIZE = STATISTICS_MAX_RATE_HZ * STATISTICS_HISTORY_SECONDS;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace RakNet {
+class RakPeerInterface;
+}
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** The last samples of the connection statistics, oldest overwritten first.
+Storage is allocated once for the longest history any rate can ask for.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class StatisticsHistory
+{
+public:
+    /// Constructor
+    StatisticsHistory();
+
+    ///Number of samples kept, at most STATISTICS_HISTORY_SIZE. Drops the current samples.
+    void setCapacity(size_t capacity);
+
+    void push(const StatisticsSample& sample);
+    void clear();
+    size_t size() const;
+
+    ///Copy out every sample, oldest first
+    void getSamples(std::vector<StatisticsSample>& samples) const;
+
+private:
+    std::array<StatisticsSample, STATISTICS_HISTORY_SIZE> samples;
+    size_t capacity = STATISTICS_HISTORY_SIZE;
+    size_t next = 0; //slot the next sample goes to
+    size_t count = 0;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Reads the RakNet statistics of every connected peer at a fixed rate, instead
+of on every network update, and keeps STATISTICS_HISTORY_SECONDS of samples
+for the GUI graphs.
+
+A sample adds up the send and receive rates and totals of all peers, and keeps
+the worst packet loss and ping among them, so on a client it describes the link
+to the host and on the host the link to its weakest client.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class StatisticsSampler
+{
+public:
+    /// Constructor
+    StatisticsSampler();
+
+    ///Samples per second, clamped to STATISTICS_MIN_RATE_HZ..STATISTICS_MAX_RATE_HZ. Drops the history.
+    void setRate(int rateHz);
+    int getRate() const;
+
+    ///Returns true once a sample interval has passed since the last sample
+    bool isDue(RakNet::Time currentTime) const;
+
+    ///Read the statistics of every connected peer and add a sample to the history
+    void sample(RakNet::RakPeerInterface* peer, RakNet::Time currentTime);
+
+    ///The latest sample, zero before the first
+    const StatisticsSample& getLatest() const;
+    const StatisticsHistory& getHistory() const;
+
+    ///Drop the history, for a new session
+    void clear();
+
+private:
+    int rateHz = STATISTICS_DEFAULT_RATE_HZ;
+    RakNet::Time intervalMS = 1000 / STATISTICS_DEFAULT_RATE_HZ;
+    RakNet::Time lastSampleTime = 0;
+    RakNet::Time firstSampleTime = 0;
+
+    RakNet::RakNetStatistics peerStatistics; //reused for every peer
+    StatisticsSample latest;
+    StatisticsHistory history;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // STATISTICSSAMPLER_H
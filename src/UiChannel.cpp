@@ -0,0 +1,260 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       UiChannel.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      UiChannel Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+UiChannel carries state changes from the network thread to the GUI thread.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+Every function in the producer section must only be called from the network
+thread, and every function in the consumer section only from the GUI thread.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "UiChannel.h"
+
+namespace Network {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+UiChannel::UiChannel()
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int UiChannel::findClient(const QString& id) const
+{
+    for (size_t i = 0; i < state.clients.size(); i++)
+    {
+        if (state.clients[i].id == id)
+            return (int)i;
+    }
+    return -1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void UiChannel::logMessage(const QString& logMsg)
+{
+    if (!logMessages.push(logMsg))
+        droppedLogs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void UiChannel::logBatch(const QString& lines)
+{
+    if (!logBatches.push(lines))
+        droppedLogs.fetch_add(1, std::memory_order_relaxed);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void UiChannel::updateListenerStatus(bool running)
+{
+    state.listenerRunning = running;
+    publishedState.write(state);
+}
+
+void UiChannel::updateDCSStatus(bool running)
+{
+    state.dcsRunning = running;
+    publishedState.write(state);
+}
+
+void UiChannel::updateServerStatus(int status)
+{
+    state.serverStatus = status;
+    state.serverStatusChanges++;
+    publishedState.write(state);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void UiChannel::addClient(const QString& id, const QString& clientName, unsigned char seatNumber)
+{
+    //a client added again replaces its old entry
+    int index = findClient(id);
+    if (index < 0)
+    {
+        index = (int)state.clients.size();
+        state.clients.push_back(UiClient());
+    }
+
+    UiClient& client = state.clients[index];
+    client.id = id;
+    client.name = clientName;
+    client.seatNumber = seatNumber;
+    client.ping = 0;
+    publishedState.write(state);
+}
+
+void UiChannel::removeClient(const QString& id)
+{
+    int index = findClient(id);
+    if (index < 0)
+        return;
+
+    state.clients.erase(state.clients.begin() + index);
+    publishedState.write(state);
+}
+
+void UiChannel::setSeat(const QString& id, unsigned char seatNumber)
+{
+    int index = findClient(id);
+    if (index < 0)
+        return;
+
+    state.clients[index].seatNumber = seatNumber;
+    publishedState.write(state);
+}
+
+void UiChannel::setServerIP(const QString& ip)
+{
+    state.serverIP = ip;
+    publishedState.write(state);
+}
+
+void UiChannel::setPing(const QString& id, int ping)
+{
+    int index = findClient(id);
+    if (index < 0 || state.clients[index].ping == ping)
+        return;
+
+    state.clients[index].ping = ping;
+    publishedState.write(state);
+}
+
+void UiChannel::setMyPing(int ping)
+{
+    if (state.myPing == ping)
+        return;
+
+    state.myPing = ping;
+    publishedState.write(state);
+}
+
+void UiChannel::setMaxSeats(unsigned char seatNumber)
+{
+    state.maxSeats = seatNumber;
+    publishedState.write(state);
+}
+
+//the GUI shows the server IP and own ping with the statistics, so a reset clears them too
+void UiChannel::resetStatistics()
+{
+    state.serverIP.clear();
+    state.myPing = -1;
+    state.statisticsResets++;
+    publishedState.write(state);
+}
+
+void UiChannel::clearClients()
+{
+    state.clients.clear();
+    publishedState.write(state);
+}
+
+void UiChannel::clientBanned(const QString& address)
+{
+    state.bannedAddresses.push_back(address);
+    publishedState.write(state);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void UiChannel::setStatistics(int numClients,
+                              uint64_t bandwidthSendRate,
+                              uint64_t bandwidthReceiveRate,
+                              uint64_t bandwidthSentTotal,
+                              uint64_t bandwidthReceivedTotal,
+                              uint64_t connectionTime,
+                              float myPacketLoss)
+{
+    NetworkStatistics stats;
+    stats.numClients = numClients;
+    stats.bandwidthSendRate = bandwidthSendRate;
+    stats.bandwidthReceiveRate = bandwidthReceiveRate;
+    stats.bandwidthSentTotal = bandwidthSentTotal;
+    stats.bandwidthReceivedTotal = bandwidthReceivedTotal;
+    stats.connectionTime = connectionTime;
+    stats.myPacketLoss = myPacketLoss;
+
+    statistics.write(stats);
+}
+
+void UiChannel::setStatisticsHistory(const std::vector<StatisticsSample>& samples)
+{
+    statisticsHistory.write(samples);
+}
+
+void UiChannel::setCommandLatency(const std::vector<CommandLatencySummary>& summary)
+{
+    commandLatency.write(summary);
+}
+
+void UiChannel::setOrderingStalls(const std::vector<OrderingStallSummary>& summary)
+{
+    orderingStalls.write(summary);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool UiChannel::popLogMessage(QString& logMsg)
+{
+    return logMessages.pop(logMsg);
+}
+
+bool UiChannel::popLogBatch(QString& lines)
+{
+    return logBatches.pop(lines);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool UiChannel::readState(UiState& uiState)
+{
+    return publishedState.read(uiState);
+}
+
+bool UiChannel::readStatistics(NetworkStatistics& stats)
+{
+    return statistics.read(stats);
+}
+
+bool UiChannel::readStatisticsHistory(std::vector<StatisticsSample>& samples)
+{
+    return statisticsHistory.read(samples);
+}
+
+bool UiChannel::readCommandLatency(std::vector<CommandLatencySummary>& summary)
+{
+    return commandLatency.read(summary);
+}
+
+bool UiChannel::readOrderingStalls(std::vector<OrderingStallSummary>& summary)
+{
+    return orderingStalls.read(summary);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int UiChannel::getDroppedLogCount() const
+{
+    return droppedLogs.load(std::memory_order_relaxed);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
@@ -0,0 +1,227 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       UiChannel.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef UICHANNEL_H
+#define UICHANNEL_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "LockFree.h"
+#include "NetworkTypes.h"
+
+#include <QString>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+    static const size_t UI_LOG_QUEUE_SIZE = 4096;
+    static const size_t UI_LOG_BATCH_QUEUE_SIZE = 64;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace Network {
+
+struct UiClient
+{
+    QString id;
+    QString name;
+    int seatNumber = 0;
+    int ping = 0;
+};
+
+struct UiState
+{
+    bool listenerRunning = false;
+    bool dcsRunning = false;
+    int serverStatus = SS_NOT_CONNECTED;
+    unsigned int serverStatusChanges = 0; //tells a status that was left and came back from one that never changed
+    QString serverIP; //empty until connected
+    int myPing = -1; //-1 until measured
+    int maxSeats = 0; //0 until connected
+    std::vector<UiClient> clients; //in the order they joined
+    unsigned int statisticsResets = 0;
+    std::vector<QString> bannedAddresses; //every ban since startup, oldest first
+};
+
+struct NetworkStatistics
+{
+    int numClients = 0;
+    uint64_t bandwidthSendRate = 0;
+    uint64_t bandwidthReceiveRate = 0;
+    uint64_t bandwidthSentTotal = 0;
+    uint64_t bandwidthReceivedTotal = 0;
+    uint64_t connectionTime = 0;
+    float myPacketLoss = 0.0f;
+};
+
+struct StatisticsSample
+{
+    uint64_t timeMS = 0; //since the first sample of the session
+    uint64_t bandwidthSendRate = 0; //bytes per second, all peers
+    uint64_t bandwidthReceiveRate = 0;
+    uint64_t bandwidthSentTotal = 0;
+    uint64_t bandwidthReceivedTotal = 0;
+    float packetLoss = 0.0f; //worst peer, last second
+    int ping = -1; //worst peer average, -1 without peers
+};
+
+struct CommandLatencySummary
+{
+    int seatNumber = 0; //sender
+    int messageClass = 0; //CommandBatchEntryType
+    uint64_t count = 0;
+    uint64_t p50US = 0;
+    uint64_t p99US = 0;
+    uint64_t maxUS = 0;
+};
+
+struct OrderingStallSummary
+{
+    int orderingChannel = 0;
+    uint64_t count = 0; //ordered messages received
+    uint64_t stalled = 0; //of those, held back waiting for a resend
+    uint64_t stalledMS = 0;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Hand-off point between the network thread and the GUI. The network side calls
+the same functions it used to call on MainWindow; they only enqueue and never
+touch a widget. The GUI drains the queue on its own timer.
+
+Only log messages go through a lock-free queue, which drops them once the GUI
+falls too far behind. The client list, the status labels and the bans are kept
+as one UiState the network side updates and republishes on every change, so the
+GUI always catches up to the current state however many changes it missed.
+Statistics are sampled several times a second and coalesced the same way.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class UiChannel
+{
+public:
+    /// Constructor
+    UiChannel();
+
+    ///////////////////////////////////
+    // NETWORK THREAD (PRODUCER) SIDE //
+    ///////////////////////////////////
+
+    void logMessage(const QString& logMsg);
+
+    ///Lines already joined and timestamped by the Logger. Logger thread only.
+    void logBatch(const QString& lines);
+
+    void updateListenerStatus(bool running);
+    void updateDCSStatus(bool running);
+    void updateServerStatus(int status);
+
+    void addClient(const QString& id, const QString& clientName, unsigned char seatNumber = 0);
+    void removeClient(const QString& id);
+    void setSeat(const QString& id, unsigned char seatNumber);
+    void setServerIP(const QString& ip);
+    void setPing(const QString& id, int ping);
+    void setMyPing(int ping);
+    void setMaxSeats(unsigned char seatNumber);
+    void setStatistics(int numClients,
+                       uint64_t bandwidthSendRate,
+                       uint64_t bandwidthReceiveRate,
+                       uint64_t bandwidthSentTotal,
+                       uint64_t bandwidthReceivedTotal,
+                       uint64_t connectionTime,
+                       float myPacketLoss);
+    void resetStatistics();
+    void clearClients();
+
+    ///Replaces the sampled statistics history shown in the graphs, oldest first
+    void setStatisticsHistory(const std::vector<StatisticsSample>& samples);
+
+    ///Replaces the command latency summary, one entry per source seat and message class
+    void setCommandLatency(const std::vector<CommandLatencySummary>& summary);
+
+    ///Replaces the ordering channel stall counts, one entry per channel that received messages
+    void setOrderingStalls(const std::vector<OrderingStallSummary>& summary);
+
+    ///Informs the GUI that a client's IP has been banned so it can be persisted
+    void clientBanned(const QString& address);
+
+    //////////////////////////////
+    // GUI THREAD (CONSUMER) SIDE //
+    //////////////////////////////
+
+    ///Pops the next log message. Returns false if there are none.
+    bool popLogMessage(QString& logMsg);
+
+    ///Pops the next batch of log lines. Returns false if there are none.
+    bool popLogBatch(QString& lines);
+
+    ///Copies the latest client list and status. Returns false if unchanged since the last call.
+    bool readState(UiState& uiState);
+
+    ///Copies the latest statistics snapshot. Returns false if unchanged since the last call.
+    bool readStatistics(NetworkStatistics& statistics);
+
+    ///Copies the latest statistics history. Returns false if unchanged since the last call.
+    bool readStatisticsHistory(std::vector<StatisticsSample>& samples);
+
+    ///Copies the latest command latency summary. Returns false if unchanged since the last call.
+    bool readCommandLatency(std::vector<CommandLatencySummary>& summary);
+
+    ///Copies the latest ordering channel stall counts. Returns false if unchanged since the last call.
+    bool readOrderingStalls(std::vector<OrderingStallSummary>& summary);
+
+    ///Number of log messages dropped because the GUI fell too far behind
+    unsigned int getDroppedLogCount() const;
+
+private:
+    ///Index of the client in state.clients, -1 if there is none
+    int findClient(const QString& id) const;
+
+    SpscQueue<QString, UI_LOG_QUEUE_SIZE> logMessages;
+    SpscQueue<QString, UI_LOG_BATCH_QUEUE_SIZE> logBatches; //own queue, as the Logger is a second producer
+    UiState state; //network thread only, published to publishedState
+    TripleBuffer<UiState> publishedState;
+    TripleBuffer<NetworkStatistics> statistics;
+    TripleBuffer<std::vector<StatisticsSample> > statisticsHistory; //published with statistics
+    TripleBuffer<std::vector<CommandLatencySummary> > commandLatency; //published once a second
+    TripleBuffer<std::vector<OrderingStallSummary> > orderingStalls; //published with commandLatency
+    std::atomic<unsigned int> droppedLogs{0};
+
+    // Make this object be noncopyable
+    UiChannel(const UiChannel&);
+    const UiChannel &operator =(const UiChannel &);
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+} // namespace Network
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif // UICHANNEL_H
@@ -0,0 +1,297 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       benchmark_main.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      Entry point of the dcs_copilot_benchmark target
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Starts a host on the production NetworkThread, runs N simulated copilots against
+it over loopback and prints throughput, CPU and latency percentiles. Given more
+than one host update worker count, it runs once per count and ends with a table
+of how throughput and the host's update cycle scale with the workers.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+Host and clients share the machine, so CPU time covers all of them and latency
+includes scheduling on a loaded box. Compare runs on the same machine.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Network.h"
+#include "NetworkLocal.h"
+#include "NetworkThread.h"
+
+#include "GetTime.h"
+#include "RakSleep.h"
+#include "TickScheduler.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+const int HOST_START_TIMEOUT_MS = 5000;
+const int GUI_UPDATE_INTERVAL_MS = 30; //the main window's UI timer
+
+const char* TRAFFIC_TYPE_NAMES[Network::NUM_BENCHMARK_TRAFFIC_TYPES] = { "analog", "digital", "event" };
+
+bool waitForHost(Network::NetworkThread& hostThread)
+{
+    Network::UiChannel* uiChannel = hostThread.getUiChannel();
+    RakNet::TimeMS deadline = RakNet::GetTimeMS() + HOST_START_TIMEOUT_MS;
+
+    while (RakNet::GetTimeMS() < deadline)
+    {
+        Network::UiState uiState;
+        if (uiChannel->readState(uiState) && uiState.serverStatus == Network::SS_HOSTING)
+            return true;
+        RakSleep(10);
+    }
+
+    return false;
+}
+
+///One pass of what the GUI thread does between timer ticks: drain the host's UiChannel, post a request, then block on
+///something slow like a repaint for busyMS
+void simulateGui(Network::NetworkThread& hostThread, int busyMS)
+{
+    Network::UiChannel* uiChannel = hostThread.getUiChannel();
+    QString logLines;
+    while (uiChannel->popLogBatch(logLines)) {
+    }
+    while (uiChannel->popLogMessage(logLines)) {
+    }
+    Network::UiState uiState;
+    uiChannel->readState(uiState);
+
+    hostThread.post([](Network::Network*, Network::NetworkLocal*) {});
+
+    RakNet::TimeUS busyUntil = RakNet::GetTimeUS() + (RakNet::TimeUS)busyMS * 1000;
+    while (RakNet::GetTimeUS() < busyUntil) {
+    }
+}
+
+void printReport(const Network::BenchmarkConfig& config, const Network::BenchmarkResults& results)
+{
+    printf("\n%d clients, %d ms tick, %u analog axes%s, %g digital/s, %g events/s per client, %d host update workers, %g s measured\n",
+           config.numClients, config.tickTimeMS, config.analogAxes, config.deadReckoning ? " (dead reckoned)" : "",
+           config.digitalPerSecond, config.eventsPerSecond, config.updateWorkers, results.measuredSeconds);
+    if (config.busyGuiMS > 0)
+        printf("host GUI thread busy for %d ms at a time\n", config.busyGuiMS);
+    printf("\n");
+
+    printf("%-8s %12s %14s %8s %9s %9s %9s %9s\n", "", "sent/s", "delivered/s", "lost", "p50 ms", "p99 ms", "p99.9 ms", "max ms");
+
+    uint64_t totalSent = 0;
+    uint64_t totalDelivered = 0;
+    for (int type = 0; type < Network::NUM_BENCHMARK_TRAFFIC_TYPES; type++)
+    {
+        const Network::LatencyHistogram& latency = results.latency[type];
+        uint64_t sent = results.sent[type];
+        uint64_t delivered = latency.getCount();
+        uint64_t expected = results.expected[type];
+        totalSent += sent;
+        totalDelivered += delivered;
+
+        double lost = (expected > 0 && delivered < expected) ? 100.0 * (double)(expected - delivered) / (double)expected : 0.0;
+        printf("%-8s %12.0f %14.0f %7.2f%% %9.3f %9.3f %9.3f %9.3f\n", TRAFFIC_TYPE_NAMES[type],
+               (double)sent / results.measuredSeconds, (double)delivered / results.measuredSeconds, lost,
+               latency.getPercentileUS(0.5) / 1000.0, latency.getPercentileUS(0.99) / 1000.0,
+               latency.getPercentileUS(0.999) / 1000.0, latency.getMaxUS() / 1000.0);
+    }
+
+    printf("\nhost in %.1f kB/s, host out %.1f kB/s (including RakNet overhead)\n",
+           (double)results.hostBytesIn / 1024.0 / results.measuredSeconds,
+           (double)results.hostBytesOut / 1024.0 / results.measuredSeconds);
+
+    printf("process CPU %.1f%% of one core, %.2f us per command sent, %.2f us per command delivered\n",
+           100.0 * (double)results.cpuTimeUS / 1000000.0 / results.measuredSeconds,
+           totalSent > 0 ? (double)results.cpuTimeUS / (double)totalSent : 0.0,
+           totalDelivered > 0 ? (double)results.cpuTimeUS / (double)totalDelivered : 0.0);
+
+    printf("host update cycle %llu us average, %llu us max\n",
+           (unsigned long long)results.hostUpdateAverageUS, (unsigned long long)results.hostUpdateMaxUS);
+
+    printf("client tick overruns: %llu\n", (unsigned long long)results.tickOverruns);
+}
+
+void printScaling(const std::vector<Network::BenchmarkConfig>& configs, const std::vector<Network::BenchmarkResults>& results)
+{
+    printf("\n%-8s %14s %9s %16s %12s %9s\n", "workers", "delivered/s", "p99 ms", "host update us", "max us", "CPU %");
+
+    for (size_t run = 0; run < results.size(); run++)
+    {
+        uint64_t delivered = 0;
+        Network::LatencyHistogram latency;
+        for (int type = 0; type < Network::NUM_BENCHMARK_TRAFFIC_TYPES; type++)
+        {
+            delivered += results[run].latency[type].getCount();
+            latency.add(results[run].latency[type]);
+        }
+
+        printf("%-8d %14.0f %9.3f %16llu %12llu %8.1f%%\n", configs[run].updateWorkers,
+               (double)delivered / results[run].measuredSeconds, latency.getPercentileUS(0.99) / 1000.0,
+               (unsigned long long)results[run].hostUpdateAverageUS, (unsigned long long)results[run].hostUpdateMaxUS,
+               100.0 * (double)results[run].cpuTimeUS / 1000000.0 / results[run].measuredSeconds);
+    }
+}
+
+///Host on the same thread setup as the application, with the simulated copilots against it. Returns false after printing why if it failed.
+bool runBenchmark(Network::BenchmarkConfig& config, Network::BenchmarkResults& results)
+{
+    Network::NetworkThread hostThread;
+    hostThread.getLogger()->setLevel(Network::LOG_WARNING);
+    hostThread.start(QThread::TimeCriticalPriority);
+
+    int maxClients = config.numClients;
+    unsigned short port = config.port;
+    int updateWorkers = config.updateWorkers;
+    hostThread.post([maxClients, port, updateWorkers](Network::Network* net, Network::NetworkLocal*) {
+        net->setTimeoutTimeMS(10000);
+        net->setMaxClients(maxClients);
+        net->setUpdateWorkers(updateWorkers);
+        net->startServer(port, "BenchmarkHost");
+    });
+
+    if (!waitForHost(hostThread))
+    {
+        fprintf(stderr, "Could not start the host on port %u\n", (unsigned int)config.port);
+        return false;
+    }
+
+    Network::BenchmarkRunner runner(config);
+    printf("Running %d clients against 127.0.0.1:%u with %d host update workers ...\n", config.numClients, (unsigned int)config.port, config.updateWorkers);
+    fflush(stdout);
+    runner.start(QThread::TimeCriticalPriority);
+
+    //this thread stands in for the host's GUI, which must not hold up forwarding however long it blocks
+    while (!runner.wait(GUI_UPDATE_INTERVAL_MS))
+        simulateGui(hostThread, config.busyGuiMS);
+
+    //stop() runs what was posted before it, so the statistics are filled in once it returns
+    RakNet::TickStatistics updateStatistics = RakNet::TickStatistics();
+    RakNet::TickStatistics* updateStatisticsPtr = &updateStatistics;
+    hostThread.post([updateStatisticsPtr](Network::Network* net, Network::NetworkLocal*) {
+        net->getUpdateStatistics(updateStatisticsPtr);
+        net->disconnect();
+    });
+    hostThread.stop();
+
+    results = runner.getResults();
+    if (!results.completed)
+    {
+        fprintf(stderr, "Benchmark failed: %s\n", results.error.c_str());
+        return false;
+    }
+
+    config = runner.getConfig();
+    results.hostUpdateAverageUS = updateStatistics.averageUpdateUS;
+    results.hostUpdateMaxUS = updateStatistics.maxUpdateUS;
+    return true;
+}
+
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("DCS Copilot Benchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Host with simulated copilots over loopback");
+    parser.addHelpOption();
+
+    QCommandLineOption clientsOption(QStringList() << "n" << "clients", "Simulated copilots, 2 to 60 (default 8).", "count");
+    QCommandLineOption portOption(QStringList() << "p" << "port", "Loopback port for the host (default 39641).", "port");
+    QCommandLineOption tickOption("tick", "Client frame time in ms (default 6).", "ms");
+    QCommandLineOption durationOption(QStringList() << "d" << "duration", "Measured seconds (default 10).", "s");
+    QCommandLineOption warmupOption("warmup", "Seconds of load before measuring (default 2).", "s");
+    QCommandLineOption analogOption("analog", "Analog axes per client, sent every tick (default 4).", "count");
+    QCommandLineOption noDeadReckoningOption("no-dead-reckoning", "Send analog values without a rate.");
+    QCommandLineOption digitalOption("digital", "Digital commands per second per client (default 10).", "rate");
+    QCommandLineOption eventsOption("events", "Events per second per client (default 1).", "rate");
+    QCommandLineOption busyGuiOption("busy-gui", "Block the host's GUI thread for this many ms between UI updates (default 0).", "ms");
+    QCommandLineOption updateWorkersOption("update-workers", "Host update worker threads, or a comma separated list to run once per count and compare (default 0).", "count");
+
+    parser.addOption(clientsOption);
+    parser.addOption(portOption);
+    parser.addOption(tickOption);
+    parser.addOption(durationOption);
+    parser.addOption(warmupOption);
+    parser.addOption(analogOption);
+    parser.addOption(noDeadReckoningOption);
+    parser.addOption(digitalOption);
+    parser.addOption(eventsOption);
+    parser.addOption(busyGuiOption);
+    parser.addOption(updateWorkersOption);
+    parser.process(a);
+
+    Network::BenchmarkConfig config;
+    if (parser.isSet(clientsOption))
+        config.numClients = parser.value(clientsOption).toInt();
+    if (parser.isSet(portOption))
+        config.port = (unsigned short)parser.value(portOption).toUInt();
+    if (parser.isSet(tickOption))
+        config.tickTimeMS = parser.value(tickOption).toInt();
+    if (parser.isSet(durationOption))
+        config.durationSeconds = parser.value(durationOption).toInt();
+    if (parser.isSet(warmupOption))
+        config.warmupSeconds = parser.value(warmupOption).toInt();
+    if (parser.isSet(analogOption))
+        config.analogAxes = parser.value(analogOption).toUInt();
+    if (parser.isSet(noDeadReckoningOption))
+        config.deadReckoning = false;
+    if (parser.isSet(digitalOption))
+        config.digitalPerSecond = parser.value(digitalOption).toDouble();
+    if (parser.isSet(eventsOption))
+        config.eventsPerSecond = parser.value(eventsOption).toDouble();
+    if (parser.isSet(busyGuiOption))
+        config.busyGuiMS = std::max(0, parser.value(busyGuiOption).toInt());
+
+    std::vector<int> workerCounts;
+    if (parser.isSet(updateWorkersOption))
+    {
+        for (const QString& count : parser.value(updateWorkersOption).split(','))
+            workerCounts.push_back(std::max(0, std::min(count.trimmed().toInt(), Network::MAX_UPDATE_WORKERS)));
+    }
+    if (workerCounts.empty())
+        workerCounts.push_back(config.updateWorkers);
+
+    std::vector<Network::BenchmarkConfig> runConfigs;
+    std::vector<Network::BenchmarkResults> runResults;
+    for (int updateWorkers : workerCounts)
+    {
+        Network::BenchmarkConfig runConfig = config;
+        runConfig.updateWorkers = updateWorkers;
+        Network::BenchmarkResults results;
+        if (!runBenchmark(runConfig, results))
+            return 1;
+
+        printReport(runConfig, results);
+        runConfigs.push_back(runConfig);
+        runResults.push_back(results);
+    }
+
+    if (runResults.size() > 1)
+        printScaling(runConfigs, runResults);
+
+    return 0;
+}
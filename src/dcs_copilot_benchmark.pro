@@ -0,0 +1,95 @@
+#-------------------------------------------------
+#
+# Loopback load benchmark with simulated copilots. See benchmark_main.cpp for the options.
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = dcs_copilot_benchmark
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+DESTDIR = $$PWD/../bin
+
+SOURCES += benchmark_main.cpp \
+    Benchmark.cpp \
+    LatencyHistogram.cpp \
+    NetworkLocal.cpp \
+    OrderingChannels.cpp \
+    CommandTableReader.cpp \
+    Network.cpp \
+    ClientInfo.cpp \
+    ClientTable.cpp \
+    AnimationStream.cpp \
+    CommandBatch.cpp \
+    CommandLatency.cpp \
+    CommandStateTable.cpp \
+    CommandValueSlots.cpp \
+    DeadReckoning.cpp \
+    CommandCodec.cpp \
+    CommandCodecProfile.cpp \
+    SeatInterest.cpp \
+    StatisticsSampler.cpp \
+    NetworkThread.cpp \
+    UiChannel.cpp \
+    Logger.cpp \
+    PacketTrace.cpp \
+    SessionRecorder.cpp \
+    LocalSharedMemory.cpp
+
+HEADERS  += Benchmark.h \
+    LatencyHistogram.h \
+    NetworkLocal.h \
+    OrderingChannels.h \
+    CommandTableReader.h \
+    NetworkTypes.h \
+    Network.h \
+    ClientInfo.h \
+    ClientTable.h \
+    AnimationStream.h \
+    CommandBatch.h \
+    CommandLatency.h \
+    CommandStateTable.h \
+    CommandValueSlots.h \
+    DeadReckoning.h \
+    CommandCodec.h \
+    CommandCodecProfile.h \
+    SeatInterest.h \
+    StatisticsSampler.h \
+    NetworkThread.h \
+    UiChannel.h \
+    Logger.h \
+    PacketTrace.h \
+    SessionRecorder.h \
+    LocalSharedMemory.h \
+    DcsShm.h \
+    LockFree.h
+
+# qmake CONFIG+=packet_trace records command packets to packet_trace.bin (see PacketTrace.h)
+packet_trace: DEFINES += DCS_COPILOT_PACKET_TRACE
+
+INCLUDEPATH +=$$PWD/../3rdparty/RakNet/Source
+INCLUDEPATH += $$PWD/.
+DEPENDPATH += $$PWD/.
+
+win32 {
+    # build 3rdparty/RakNet/RakNetLibStatic.pro first (building DCS_Copilot.pro does), it writes the library to 3rdparty/RakNet/Lib
+    CONFIG += static
+    LIBS += Ws2_32.lib
+    CONFIG(release, debug|release): {
+        LIBS += -L$$PWD/../3rdparty/RakNet/Lib/ -lRakNetStatic_x64
+        PRE_TARGETDEPS += $$PWD/../3rdparty/RakNet/Lib/RakNetStatic_x64.lib
+    }
+    else:CONFIG(debug, debug|release): {
+        LIBS += -L$$PWD/../3rdparty/RakNet/Lib/ -lRakNetStatic_x64d
+        PRE_TARGETDEPS += $$PWD/../3rdparty/RakNet/Lib/RakNetStatic_x64d.lib
+    }
+}
+else {
+    # build 3rdparty/RakNet/RakNetLibStatic.pro first, it writes the library to 3rdparty/RakNet/Lib
+    LIBS += -L$$PWD/../3rdparty/RakNet/Lib/ -lRakNetLibStatic -lpthread
+    PRE_TARGETDEPS += $$PWD/../3rdparty/RakNet/Lib/libRakNetLibStatic.a
+}
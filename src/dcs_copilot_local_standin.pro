@@ -0,0 +1,44 @@
+#-------------------------------------------------
+#
+# Stand-in for the DCS aircraft on the shared memory link. See local_standin_main.cpp.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+
+TARGET = dcs_copilot_local_standin
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle qt
+
+DESTDIR = $$PWD/../bin
+
+SOURCES += local_standin_main.cpp \
+    LatencyHistogram.cpp
+
+HEADERS  += LatencyHistogram.h \
+    NetworkTypes.h \
+    DcsShm.h
+
+INCLUDEPATH +=$$PWD/../3rdparty/RakNet/Source
+INCLUDEPATH += $$PWD/.
+DEPENDPATH += $$PWD/.
+
+win32 {
+    # build 3rdparty/RakNet/RakNetLibStatic.pro first (building DCS_Copilot.pro does), it writes the library to 3rdparty/RakNet/Lib
+    CONFIG += static
+    LIBS += Ws2_32.lib
+    CONFIG(release, debug|release): {
+        LIBS += -L$$PWD/../3rdparty/RakNet/Lib/ -lRakNetStatic_x64
+        PRE_TARGETDEPS += $$PWD/../3rdparty/RakNet/Lib/RakNetStatic_x64.lib
+    }
+    else:CONFIG(debug, debug|release): {
+        LIBS += -L$$PWD/../3rdparty/RakNet/Lib/ -lRakNetStatic_x64d
+        PRE_TARGETDEPS += $$PWD/../3rdparty/RakNet/Lib/RakNetStatic_x64d.lib
+    }
+}
+else {
+    # build 3rdparty/RakNet/RakNetLibStatic.pro first, it writes the library to 3rdparty/RakNet/Lib
+    LIBS += -L$$PWD/../3rdparty/RakNet/Lib/ -lRakNetLibStatic -lpthread
+    PRE_TARGETDEPS += $$PWD/../3rdparty/RakNet/Lib/libRakNetLibStatic.a
+}
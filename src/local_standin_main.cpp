@@ -0,0 +1,229 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       local_standin_main.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      Entry point of the dcs_copilot_local_standin target
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Stands in for the DCS aircraft on the shared memory link, so the link can be
+exercised on Linux without DCS. Attaches to a running listener started with the
+Shared Memory transport (dcs_copilot_server --listener-transport shm), sends
+echo messages and commands every frame like an aircraft would, and prints the
+echo round trip percentiles.
+
+Usage: dcs_copilot_local_standin [seconds] [commands per frame] [framed]
+
+framed 1 (default) sends each frame as one ID_LOCAL_FRAME, 0 as single messages.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+Outside Windows the listener polls the rings every NETWORK_POLL_WAIT_MS, so the
+round trip there includes up to that much waiting.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "LatencyHistogram.h"
+#include "NetworkTypes.h"
+
+#include "BitStream.h"
+#include "GetTime.h"
+#include "MessageIdentifiers.h"
+#include "PacketPriority.h"
+#include "RakSleep.h"
+
+//after the RakNet headers, which bring winsock2.h before windows.h
+#include "DcsShm.h"
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+//the ID_LOCAL_* values of CustomLocalNetworkMessages in NetworkLocal.cpp
+const RakNet::MessageID ID_LOCAL_COMMAND = ID_USER_PACKET_ENUM + 3;
+const RakNet::MessageID ID_LOCAL_ECHO = ID_USER_PACKET_ENUM + 15;
+const RakNet::MessageID ID_LOCAL_FRAME = ID_USER_PACKET_ENUM + 16;
+
+const int ATTACH_TIMEOUT_MS = 5000;
+const int FRAME_TIME_MS = 6; //DCS update time
+const int DRAIN_TIME_MS = 200; //for echoes still in flight after the last frame
+
+//the messages of one frame, sent as one ID_LOCAL_FRAME or one by one
+class StandinFrame
+{
+public:
+    StandinFrame(DcsShm* shm_, bool framed_) : shm(shm_), framed(framed_) {}
+
+    bool add(const RakNet::BitStream& message)
+    {
+        if (!framed)
+            return dcsShmSend(shm, message.GetData(), message.GetNumberOfBytesUsed()) != 0;
+
+        if (frame.GetNumberOfBytesUsed() == 0)
+            frame.Write(ID_LOCAL_FRAME);
+        frame.Write((unsigned short)message.GetNumberOfBytesUsed());
+        frame.WriteAlignedBytes(message.GetData(), message.GetNumberOfBytesUsed());
+        return true;
+    }
+
+    ///Sends the frame, also an empty one, as that tells the copilot to answer in frames
+    bool send()
+    {
+        if (!framed)
+            return true;
+
+        if (frame.GetNumberOfBytesUsed() == 0)
+            frame.Write(ID_LOCAL_FRAME);
+        bool sent = dcsShmSend(shm, frame.GetData(), frame.GetNumberOfBytesUsed()) != 0;
+        frame.Reset();
+        return sent;
+    }
+
+private:
+    DcsShm* shm;
+    bool framed;
+    RakNet::BitStream frame;
+};
+
+void addEcho(StandinFrame& frame, uint32_t& sent)
+{
+    RakNet::BitStream bsOut;
+    bsOut.Write(ID_LOCAL_ECHO);
+    bsOut.Write((uint64_t)RakNet::GetTimeUS());
+    if (frame.add(bsOut))
+        sent++;
+}
+
+void addCommand(StandinFrame& frame, unsigned short command, uint32_t& sent)
+{
+    RakNet::BitStream bsOut;
+    bsOut.Write(ID_LOCAL_COMMAND);
+    bsOut.Write((char)0); //ordering channel
+    unsigned char packetInfo = 0;
+    WRITETO(packetInfo, 0, 2, (unsigned char)HIGH_PRIORITY);
+    WRITETO(packetInfo, 2, 3, (unsigned char)RELIABLE_ORDERED);
+    bsOut.Write(packetInfo);
+    bsOut.Write(command);
+    if (frame.add(bsOut))
+        sent++;
+}
+
+void handleMessage(const unsigned char* data, uint32_t length, Network::LatencyHistogram& roundTrip, uint32_t& other)
+{
+    if (data[0] != ID_LOCAL_ECHO) {
+        other++;
+        return;
+    }
+
+    uint64_t sentUS = 0;
+    RakNet::BitStream bsIn(const_cast<unsigned char*>(data), length, false);
+    bsIn.IgnoreBytes(sizeof(RakNet::MessageID));
+    if (bsIn.Read(sentUS))
+        roundTrip.add(RakNet::GetTimeUS() - sentUS);
+}
+
+void receiveAll(DcsShm* shm, std::vector<unsigned char>& buffer, Network::LatencyHistogram& roundTrip, uint32_t& other, uint32_t& frames)
+{
+    uint32_t length;
+    while ((length = dcsShmReceive(shm, &buffer[0], (uint32_t)buffer.size())) > 0)
+    {
+        if (buffer[0] != ID_LOCAL_FRAME) {
+            handleMessage(&buffer[0], length, roundTrip, other);
+            continue;
+        }
+
+        frames++;
+        uint32_t offset = 1;
+        while (offset + 2 <= length)
+        {
+            uint32_t messageLength = ((uint32_t)buffer[offset] << 8) | buffer[offset + 1];
+            offset += 2;
+            if (messageLength == 0 || offset + messageLength > length)
+                break;
+            handleMessage(&buffer[offset], messageLength, roundTrip, other);
+            offset += messageLength;
+        }
+    }
+}
+
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+int main(int argc, char *argv[])
+{
+    double seconds = (argc > 1) ? atof(argv[1]) : 10.0;
+    int commandsPerFrame = (argc > 2) ? atoi(argv[2]) : 4;
+    bool framed = (argc > 3) ? (atoi(argv[3]) != 0) : true;
+
+    DcsShm shm;
+    dcsShmInit(&shm);
+
+    RakNet::TimeMS deadline = RakNet::GetTimeMS() + ATTACH_TIMEOUT_MS;
+    while (!dcsShmOpen(&shm))
+    {
+        if (RakNet::GetTimeMS() >= deadline) {
+            fprintf(stderr, "No shared memory listener running\n");
+            return 1;
+        }
+        RakSleep(100);
+    }
+    printf("Attached, sending for %g s with %d commands per frame%s\n", seconds, commandsPerFrame, framed ? ", framed" : "");
+
+    StandinFrame frame(&shm, framed);
+    frame.send();
+
+    std::vector<unsigned char> buffer(DCS_SHM_MAX_MESSAGE_SIZE);
+    Network::LatencyHistogram roundTrip;
+    uint32_t echoesSent = 0;
+    uint32_t commandsSent = 0;
+    uint32_t other = 0;
+    uint32_t frames = 0;
+    unsigned short command = 0;
+
+    RakNet::TimeMS endTime = RakNet::GetTimeMS() + (RakNet::TimeMS)(seconds * 1000.0);
+    while (RakNet::GetTimeMS() < endTime && dcsShmIsOpen(&shm))
+    {
+        addEcho(frame, echoesSent);
+        for (int i = 0; i < commandsPerFrame; i++)
+            addCommand(frame, command++, commandsSent);
+        frame.send();
+        dcsShmSignal(&shm);
+
+        receiveAll(&shm, buffer, roundTrip, other, frames);
+        RakSleep(FRAME_TIME_MS);
+    }
+
+    RakNet::TimeMS drainEnd = RakNet::GetTimeMS() + DRAIN_TIME_MS;
+    while (RakNet::GetTimeMS() < drainEnd && dcsShmIsOpen(&shm) && roundTrip.getCount() < echoesSent)
+    {
+        dcsShmSignal(&shm);
+        receiveAll(&shm, buffer, roundTrip, other, frames);
+        RakSleep(1);
+    }
+
+    bool listenerStopped = !dcsShmIsOpen(&shm);
+    dcsShmClose(&shm);
+
+    if (listenerStopped)
+        printf("Listener stopped during the run\n");
+
+    printf("%u echoes sent, %u returned, %u commands sent, %u other messages and %u frames received\n",
+           echoesSent, (unsigned int)roundTrip.getCount(), commandsSent, other, frames);
+    printf("round trip p50 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+           roundTrip.getPercentileUS(0.50) / 1000.0, roundTrip.getPercentileUS(0.99) / 1000.0, roundTrip.getMaxUS() / 1000.0);
+
+    return (roundTrip.getCount() == echoesSent) ? 0 : 1;
+}
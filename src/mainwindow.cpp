@@ -27,30 +27,28 @@ INCLUDES
 
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "statisticsgraph.h"
 
 #include "NetworkLocal.h"
+#include "CommandLatency.h"
 #include "Network.h"
+#include "NetworkThread.h"
 #include "NetworkTypes.h"
+#include "StatisticsSampler.h"
+#include "UiChannel.h"
 #include "version.h"
 
 #include <QCloseEvent>
 #include <QTimer>
 #include <QLabel>
 #include <QDateTime>
+#include <QFileDialog>
 #include <QSettings>
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
-Network::NetworkLocal* netLocal = nullptr;
-Network::Network* net = nullptr;
-
-QTimer* netLocalTimer = nullptr;
-QTimer* netTimer = nullptr;
-
-
-
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 std::string getTimeString(uint64_t timeMS, TimeStringFormats format)
@@ -271,18 +269,16 @@ MainWindow::MainWindow(QWidget *parent) :
     clientConnectionIndex(0),
     contextMenuRowAction(-1),
     prevClientSortIndex(4),
-    prevClientSortOrder(Qt::AscendingOrder)
+    prevClientSortOrder(Qt::AscendingOrder),
+    statisticsRate(Network::STATISTICS_DEFAULT_RATE_HZ),
+    hosting(false)
 {
     ui->setupUi(this);
 
-    netLocalTimer = new QTimer(this);
-    netTimer = new QTimer(this);
-
-    netLocalTimer->setInterval(1);
-    netTimer->setInterval(1);
-
-    connect(netLocalTimer, SIGNAL(timeout()), this, SLOT(updateLocalNetwork()));
-    connect(netTimer, SIGNAL(timeout()), this, SLOT(updateNetwork()));
+    //the GUI only drains network state at display rate, the network itself runs on its own thread
+    uiTimer = new QTimer(this);
+    uiTimer->setInterval(30);
+    connect(uiTimer, SIGNAL(timeout()), this, SLOT(processNetworkEvents()));
 
     QString version = QStringLiteral("%1.%2.%3.%4").arg(Version::MAJOR).arg(Version::MINOR).arg(Version::REVISION).arg(Version::BUILD);
     this->setWindowTitle("DCS Copilot - " + version);
@@ -353,6 +349,14 @@ MainWindow::MainWindow(QWidget *parent) :
     //ui->textEdit->setTextColor(QColor(120,120,120));
     //ui->textEdit->setEnabled(false);
 
+    //graphs of the last minute of statistics, below the log
+    bandwidthGraph = new StatisticsGraph("Send / Receive", QColor(0, 100, 200), QColor(0, 160, 60), ui->centralWidget);
+    bandwidthGraph->setGeometry(20, 470, 205, 70);
+    packetLossGraph = new StatisticsGraph("Packet Loss", QColor(200, 40, 40), QColor(), ui->centralWidget);
+    packetLossGraph->setGeometry(233, 470, 205, 70);
+    pingGraph = new StatisticsGraph("Ping", QColor(120, 60, 160), QColor(), ui->centralWidget);
+    pingGraph->setGeometry(446, 470, 205, 70);
+
     ui->tableWidget->setSortingEnabled(true);
     connect(ui->tableWidget->horizontalHeader(), &QHeaderView::sortIndicatorChanged, this, &MainWindow::HandleIndicatorChanged);   
 
@@ -373,41 +377,31 @@ MainWindow::MainWindow(QWidget *parent) :
     //About window
     aboutWindow = new AboutWindow();
 
-    //
-    netLocal = new Network::NetworkLocal(this);
-    net = new Network::Network(this);
-
-    //NET_LOCAL ===> NET
-    connect(netLocal, SIGNAL(localConnected(void)), net, SLOT(handleLocalConnected(void)));
-
-    connect(netLocal, SIGNAL(receivedLocalCommand(unsigned short,unsigned char,unsigned char,char)),
-            net, SLOT(handleReceivedLocalCommand(unsigned short,unsigned char,unsigned char,char)));
-    connect(netLocal, SIGNAL(receivedLocalCommandValue(unsigned short,unsigned char,unsigned char,char,unsigned char,float,bool,float)),
-            net, SLOT(handleReceivedLocalCommandValue(unsigned short,unsigned char,unsigned char,char,unsigned char,float,bool,float)));
-    connect(netLocal, SIGNAL(receivedLocalCorrectionCommandValue(unsigned short,float)),
-            net, SLOT(handleReceivedLocalCorrectionCommandValue(unsigned short,float)));
+    //Network thread owns both the local (DCS) and the copilot network
+    networkThread = new Network::NetworkThread();
 
-    connect(netLocal, SIGNAL(receivedLocalEvent(unsigned char)),
-            net, SLOT(handleReceivedLocalEvent(unsigned char)));
-
-
-
-    //NET ===> NET_LOCAL
-    connect(net, SIGNAL(receivedSeatChange(int)), netLocal, SLOT(handleReceivedSeatChange(int)));
+    QSettings settings;
+    //per command and event lines are LOG_DEBUG, so they are only shown with logLevel 0
+    networkThread->getLogger()->setLevel((Network::LogLevel)settings.value("logLevel", (int)Network::LOG_INFO).toInt());
+    QString logFile = settings.value("logFile", "").toString();
+    if (!logFile.isEmpty() && !networkThread->getLogger()->setLogFile(logFile.toStdString())) {
+        logMessage(QString("<font color='red'>ERROR:</font> Cannot open log file: %1").arg(logFile));
+    }
 
-    connect(net, SIGNAL(receivedNetCommand(unsigned short)),
-            netLocal, SLOT(handleReceivedNetCommand(unsigned short)));
-    connect(net, SIGNAL(receivedNetCommandValue(unsigned short,float,bool,float)),
-            netLocal, SLOT(handleReceivedNetCommandValue(unsigned short,float,bool,float)));
+    networkThread->start(QThread::TimeCriticalPriority);
+    uiTimer->start();
 
-    connect(net, SIGNAL(receivedNetEvent(unsigned char)),
-            netLocal, SLOT(handleReceivedNetEvent(unsigned char)));
+    //connection statistics samples per second, which is also how often the statistics and graphs update
+    statisticsRate = std::max(Network::STATISTICS_MIN_RATE_HZ, std::min(settings.value("statisticsRate", Network::STATISTICS_DEFAULT_RATE_HZ).toInt(), Network::STATISTICS_MAX_RATE_HZ));
+    int rate = statisticsRate;
+    postRequest([rate](Network::Network* net, Network::NetworkLocal*) {
+        net->setStatisticsRate(rate);
+    });
 
     updateListenerStatus(false);
     updateDCSStatus(false);
     updateServerStatus(Network::SS_NOT_CONNECTED);
 
-    QSettings settings;
     bool startListenerOnStartup = settings.value("startListenerOnStartup", true).toBool();
     if (startListenerOnStartup) {
         startLocalServer();
@@ -431,9 +425,143 @@ void MainWindow::HandleIndicatorChanged(int logicalIndex, Qt::SortOrder eSort)
 
 MainWindow::~MainWindow()
 {
+    uiTimer->stop();
+    networkThread->stop();
+    delete networkThread;
     delete ui;
 }
 
+void MainWindow::processNetworkEvents()
+{
+    Network::UiChannel* uiChannel = networkThread->getUiChannel();
+
+    postUnpostedRequests();
+
+    //statistics first, so a reset queued after the last sample is not overwritten
+    Network::NetworkStatistics stats;
+    if (uiChannel->readStatistics(stats))
+    {
+        setStatistics(stats.numClients, stats.bandwidthSendRate, stats.bandwidthReceiveRate,
+                      stats.bandwidthSentTotal, stats.bandwidthReceivedTotal, stats.connectionTime, stats.myPacketLoss);
+    }
+
+    if (uiChannel->readStatisticsHistory(statisticsHistory)) {
+        setStatisticsHistory(statisticsHistory);
+    }
+
+    if (uiChannel->readCommandLatency(commandLatency)) {
+        setCommandLatency(commandLatency);
+    }
+
+    if (uiChannel->readOrderingStalls(orderingStalls)) {
+        setOrderingStalls(orderingStalls);
+    }
+
+    QString logLines;
+    while (uiChannel->popLogBatch(logLines)) {
+        ui->textEdit->append(logLines);
+    }
+
+    QString logMsg;
+    while (uiChannel->popLogMessage(logMsg)) {
+        logMessage(logMsg);
+    }
+
+    Network::UiState newState;
+    if (uiChannel->readState(newState)) {
+        applyUiState(newState);
+    }
+}
+
+//the network side only publishes its latest state, so whatever changed since the last one applied is worked out here
+void MainWindow::applyUiState(const Network::UiState& newState)
+{
+    //a reset blanks the server IP and own ping along with the statistics
+    bool reset = (newState.statisticsResets != uiState.statisticsResets);
+    if (reset) {
+        resetStatistics();
+    }
+
+    if (newState.listenerRunning != uiState.listenerRunning) {
+        updateListenerStatus(newState.listenerRunning);
+    }
+    if (newState.dcsRunning != uiState.dcsRunning) {
+        updateDCSStatus(newState.dcsRunning);
+    }
+    if (newState.serverStatusChanges != uiState.serverStatusChanges) {
+        updateServerStatus(newState.serverStatus);
+    }
+    if (reset || newState.serverIP != uiState.serverIP) {
+        setServerIP(newState.serverIP.isEmpty() ? QString("N/A") : newState.serverIP);
+    }
+    if (reset || newState.myPing != uiState.myPing) {
+        if (newState.myPing < 0)
+            ui->label_13->setText("N/A");
+        else
+            setMyPing(newState.myPing);
+    }
+    if (newState.maxSeats > 0 && newState.maxSeats != uiState.maxSeats) {
+        setMaxSeats((unsigned char)newState.maxSeats);
+    }
+
+    //rows of clients that left go first, then the others are added or brought up to date
+    for (int row = ui->tableWidget->rowCount() - 1; row >= 0; row--)
+    {
+        QString id = ui->tableWidget->item(row, 3)->text();
+        bool stayed = std::any_of(newState.clients.begin(), newState.clients.end(),
+                                  [&id](const Network::UiClient& client) { return client.id == id; });
+        if (!stayed)
+            ui->tableWidget->removeRow(row);
+    }
+    for (const Network::UiClient& client : newState.clients)
+    {
+        int row = findClientRow(client.id);
+        if (row < 0)
+            addClient(client.id, client.name, (unsigned char)client.seatNumber);
+        else if (ui->tableWidget->item(row, 0)->text() != client.name)
+            ui->tableWidget->item(row, 0)->setText(client.name);
+
+        setSeat(client.id, (unsigned char)client.seatNumber);
+        setPing(client.id, client.ping);
+    }
+
+    for (size_t i = uiState.bannedAddresses.size(); i < newState.bannedAddresses.size(); i++) {
+        addToBanList(newState.bannedAddresses[i]);
+    }
+
+    uiState = newState;
+}
+
+int MainWindow::findClientRow(const QString& id) const
+{
+    int rows = ui->tableWidget->rowCount();
+    for (int i=0; i < rows; i++)
+    {
+        if (ui->tableWidget->item(i, 3)->text() == id)
+            return i;
+    }
+    return -1;
+}
+
+//a request must never be lost, so one the queue cannot take waits here and keeps its place before any later one
+void MainWindow::postRequest(std::function<void(Network::Network*, Network::NetworkLocal*)> request)
+{
+    if (unpostedRequests.empty() && networkThread->post(request))
+        return;
+
+    if (unpostedRequests.empty()) {
+        logMessage("<font color='orange'>WARNING:</font> The network thread is busy, requests are delayed.");
+    }
+    unpostedRequests.push_back(std::move(request));
+}
+
+void MainWindow::postUnpostedRequests()
+{
+    while (!unpostedRequests.empty() && networkThread->post(unpostedRequests.front())) {
+        unpostedRequests.pop_front();
+    }
+}
+
 void MainWindow::addClient(const QString& id, const QString& clientName, unsigned char seatNumber)
 {
     int row = ui->tableWidget->rowCount();
@@ -553,6 +681,90 @@ void MainWindow::resetStatistics()
     ui->label_16->setText("N/A");
     ui->label_18->setText("N/A");
     ui->label_14->setText("N/A");
+
+    bandwidthGraph->clear();
+    packetLossGraph->clear();
+    pingGraph->clear();
+}
+
+void MainWindow::setStatisticsHistory(const std::vector<Network::StatisticsSample>& samples)
+{
+    if (samples.empty())
+        return;
+
+    std::vector<double> sendRates;
+    std::vector<double> receiveRates;
+    std::vector<double> packetLoss;
+    std::vector<double> pings;
+    for (const auto& sample : samples)
+    {
+        sendRates.push_back((double)sample.bandwidthSendRate);
+        receiveRates.push_back((double)sample.bandwidthReceiveRate);
+        packetLoss.push_back((double)sample.packetLoss * 100.0);
+        pings.push_back((double)std::max(sample.ping, 0));
+    }
+
+    const Network::StatisticsSample& latest = samples.back();
+    size_t capacity = (size_t)(statisticsRate * Network::STATISTICS_HISTORY_SECONDS);
+    bandwidthGraph->setValues(sendRates, receiveRates, capacity,
+                              QString(getBandwidthString(latest.bandwidthSendRate + latest.bandwidthReceiveRate, BandwidthStringFormats::rateAdaptive).c_str()));
+    packetLossGraph->setValues(packetLoss, std::vector<double>(), capacity, QString::number((double)latest.packetLoss * 100.0, 'f', 1) + " %");
+    pingGraph->setValues(pings, std::vector<double>(), capacity, (latest.ping >= 0) ? QString("%1 ms").arg(latest.ping) : QString("N/A"));
+}
+
+void MainWindow::setCommandLatency(const std::vector<Network::CommandLatencySummary>& summary)
+{
+    if (summary.empty())
+    {
+        ui->label_23->setText("N/A");
+        ui->label_23->setToolTip(QString());
+        return;
+    }
+
+    //the label shows the slowest seat and class, the tooltip all of them
+    const Network::CommandLatencySummary* worst = &summary.front();
+    QString table = "<table><tr><th>Seat</th><th>Class</th><th>Count</th><th>p50 ms</th><th>p99 ms</th><th>Max ms</th></tr>";
+    for (const auto& entry : summary)
+    {
+        if (entry.p99US > worst->p99US)
+            worst = &entry;
+
+        table += QString("<tr><td>%1</td><td>%2</td><td>%3</td><td>%4</td><td>%5</td><td>%6</td></tr>")
+                .arg(entry.seatNumber)
+                .arg(Network::CommandLatency::getMessageClassName(entry.messageClass))
+                .arg(entry.count)
+                .arg(entry.p50US / 1000)
+                .arg(entry.p99US / 1000)
+                .arg(entry.maxUS / 1000);
+    }
+    table += "</table>";
+
+    ui->label_23->setText(QString("%1 / %2 ms (seat %3)").arg(worst->p50US / 1000).arg(worst->p99US / 1000).arg(worst->seatNumber));
+    ui->label_23->setToolTip(table);
+}
+
+void MainWindow::setOrderingStalls(const std::vector<Network::OrderingStallSummary>& summary)
+{
+    if (summary.empty())
+    {
+        ui->label_22->setToolTip(QString());
+        return;
+    }
+
+    //ordered messages held back waiting for a resend of an earlier one on their channel
+    QString table = "<b>Ordering channel stalls</b><table><tr><th>Channel</th><th>Messages</th><th>Stalled</th><th>Stall ms</th></tr>";
+    for (const auto& entry : summary)
+    {
+        table += QString("<tr><td>%1</td><td>%2</td><td>%3 (%4%)</td><td>%5</td></tr>")
+                .arg(entry.orderingChannel)
+                .arg(entry.count)
+                .arg(entry.stalled)
+                .arg(100.0 * entry.stalled / entry.count, 0, 'f', 1)
+                .arg(entry.stalledMS);
+    }
+    table += "</table>";
+
+    ui->label_22->setToolTip(table);
 }
 
 void MainWindow::clearClients()
@@ -616,7 +828,7 @@ void MainWindow::updateServerStatus(int status)
     }
     else if (status == Network::SS_NOT_CONNECTED)
     {
-        netTimer->stop();
+        hosting = false;
         Server_status_label->setText("NOT CONNECTED");
         changeLabelColor(Server_status_label, "darkred");
         findChild<QAction*>("actionStart_Server")->setEnabled(true);
@@ -642,63 +854,122 @@ void MainWindow::updateServerStatus(int status)
         findChild<QAction*>("actionDisconnect")->setEnabled(true);
         settingsWindow->setEnabledClientServerSettings(false);
 
-        if (net->isHost())
-        {
-            // Read ban list from settings
-            QSettings settings;
-            QStringList banList = settings.value("banList").toStringList();
+        hosting = true;
+
+        // Read ban list from settings
+        QSettings settings;
+        QStringList banList = settings.value("banList").toStringList();
+        postRequest([banList](Network::Network* net, Network::NetworkLocal*) {
             net->clearBanList();
             for (int i = 0; i < banList.size(); i++)
             {
                 net->banIpFromServer(banList.at(i).toStdString());
             }
-        }
+        });
     }
 }
 
 void MainWindow::startLocalServer()
 {
-    netLocal->startServer();
-    netLocalTimer->start();
+    QSettings settings;
+    Network::LocalTransport transport = (Network::LocalTransport)settings.value("localTransport", (int)Network::LOCAL_TRANSPORT_RAKNET).toInt();
+    postRequest([transport](Network::Network*, Network::NetworkLocal* netLocal) {
+        netLocal->startServer(transport);
+    });
 }
 
 void MainWindow::stopLocalServer()
 {
-    netLocalTimer->stop();
-    netLocal->disconnect();
+    postRequest([](Network::Network*, Network::NetworkLocal* netLocal) {
+        netLocal->disconnect();
+    });
+}
+
+//read when a session starts, so settings changed since startup (such as the tick rate in the settings window) take effect
+void MainWindow::postSessionSettings()
+{
+    QSettings settings;
+
+    //"hashed" (default), "aircraft" or the path of an ordering channel table
+    std::string orderingChannels = settings.value("orderingChannels", "").toString().toStdString();
+    postRequest([orderingChannels](Network::Network* net, Network::NetworkLocal*) {
+        net->setOrderingChannels(orderingChannels);
+    });
+
+    //"on" (default), "off" or the path of a dead reckoning tolerance table
+    std::string deadReckoning = settings.value("deadReckoning", "").toString().toStdString();
+    postRequest([deadReckoning](Network::Network* net, Network::NetworkLocal*) {
+        net->setDeadReckoning(deadReckoning);
+    });
+
+    //path of an aircraft codec profile, used while every seat loaded the same one
+    std::string codecProfile = settings.value("codecProfile", "").toString().toStdString();
+    postRequest([codecProfile](Network::Network* net, Network::NetworkLocal*) {
+        net->setCodecProfile(codecProfile);
+    });
+
+    //time between RakNet update cycles, for hosting and connecting (settings window tick rate)
+    int tickTimeMS = settings.value("tickTimeMS", 6).toInt();
+    postRequest([tickTimeMS](Network::Network* net, Network::NetworkLocal*) {
+        net->setTickTimeMS(tickTimeMS);
+    });
+
+    //threads (0 to 8) that help RakNet with the per connection updates when hosting a large crew
+    int updateWorkers = settings.value("updateWorkers", 0).toInt();
+    postRequest([updateWorkers](Network::Network* net, Network::NetworkLocal*) {
+        net->setUpdateWorkers(updateWorkers);
+    });
+
+    //aircraft (0 to 31) to fly in on a host serving several, each with its own seats
+    int crew = settings.value("crew", 0).toInt();
+    postRequest([crew](Network::Network* net, Network::NetworkLocal*) {
+        net->setCrew(crew);
+    });
+
+    //"all" (default) or the path of a seat interest table, sent to the host with seat requests
+    std::string seatInterest = settings.value("seatInterest", "").toString().toStdString();
+    postRequest([seatInterest](Network::Network* net, Network::NetworkLocal*) {
+        net->setSeatInterest(seatInterest);
+    });
 }
 
 void MainWindow::startServer()
 {
     ServerStartAttempt attempt = serverStart->getServerStartAttempt();
-    net->setTimeoutTimeMS(attempt.timeoutTimeMS.toInt());
-    net->setMaxClients(attempt.maxClients);
-    net->startServer(attempt.port.toUShort(), attempt.clientName.toStdString(), attempt.password.toStdString());
-    netTimer->start();
+    int timeoutTimeMS = attempt.timeoutTimeMS.toInt();
+    int maxClients = attempt.maxClients;
+    unsigned short port = attempt.port.toUShort();
+    std::string clientName = attempt.clientName.toStdString();
+    std::string password = attempt.password.toStdString();
+
+    postSessionSettings();
+    postRequest([=](Network::Network* net, Network::NetworkLocal*) {
+        net->setTimeoutTimeMS(timeoutTimeMS);
+        net->setMaxClients(maxClients);
+        net->startServer(port, clientName, password);
+    });
 }
 
 void MainWindow::connectToServer()
 {
-    ServerConnectionAttempt attempt = connectionWindow->getServerConnectionAttempt();    
-    net->connect(attempt.ip.toStdString().c_str(), attempt.port.toUShort(), attempt.clientName.toStdString(), attempt.password.toStdString());
+    ServerConnectionAttempt attempt = connectionWindow->getServerConnectionAttempt();
+    std::string ip = attempt.ip.toStdString();
+    unsigned short port = attempt.port.toUShort();
+    std::string clientName = attempt.clientName.toStdString();
+    std::string password = attempt.password.toStdString();
+
+    postSessionSettings();
+    postRequest([=](Network::Network* net, Network::NetworkLocal*) {
+        net->connect(ip.c_str(), port, clientName, password);
+    });
     connectionWindow->setRecentServer(attempt.ip+":"+attempt.port);
-    netTimer->start();
 }
 
 void MainWindow::stopServer()
 {
-    netTimer->stop();
-    net->disconnect();
-}
-
-void MainWindow::updateLocalNetwork()
-{
-    netLocal->update();
-}
-
-void MainWindow::updateNetwork()
-{
-    net->update();
+    postRequest([](Network::Network* net, Network::NetworkLocal*) {
+        net->disconnect();
+    });
 }
 
 void MainWindow::closeProgram()
@@ -784,16 +1055,58 @@ void MainWindow::on_actionAbout_triggered()
     }
 }
 
+void MainWindow::on_actionExport_Latency_triggered()
+{
+    QString path = QFileDialog::getSaveFileName(this, "Export Latency", "command_latency.csv", "CSV Files (*.csv)");
+    if (path.isEmpty())
+        return;
+
+    std::string pathStr = path.toStdString();
+    postRequest([pathStr](Network::Network* net, Network::NetworkLocal*) {
+        net->exportCommandLatency(pathStr);
+    });
+}
+
+void MainWindow::on_actionRecord_Session_triggered(bool checked)
+{
+    if (!checked) {
+        networkThread->stopRecording();
+        return;
+    }
+
+    QString path = QFileDialog::getSaveFileName(this, "Record Session", "session.dcsr", "Session Recordings (*.dcsr)");
+    if (path.isEmpty()) {
+        ui->actionRecord_Session->setChecked(false);
+        return;
+    }
+
+    networkThread->startRecording(path.toStdString());
+}
+
+void MainWindow::on_actionReplay_Session_triggered()
+{
+    QString path = QFileDialog::getOpenFileName(this, "Replay Session", "", "Session Recordings (*.dcsr)");
+    if (path.isEmpty())
+        return;
+
+    //at the recorded pace, into whatever session is running
+    networkThread->startReplay(path.toStdString(), 1.0);
+}
+
 void MainWindow::on_pushButton_clicked()
 {
     int seatNumber = ui->spinBox->value();
-    net->requestSeat(seatNumber);
+    postRequest([seatNumber](Network::Network* net, Network::NetworkLocal*) {
+        net->requestSeat(seatNumber);
+    });
 }
 
 void MainWindow::on_pushButton_2_clicked()
 {
     unsigned short command = (unsigned short)ui->spinBox_2->value();
-    net->handleReceivedLocalCommand(command,HIGH_PRIORITY,RELIABLE_ORDERED,0);
+    postRequest([command](Network::Network* net, Network::NetworkLocal*) {
+        net->handleReceivedLocalCommand(command,HIGH_PRIORITY,RELIABLE_ORDERED,0);
+    });
 
     QString q = QString("Local Command (%1)").arg(command);
     std::cout << q.toStdString().c_str() << std::endl;
@@ -804,7 +1117,9 @@ void MainWindow::on_pushButton_3_clicked()
 {
     unsigned short command = (unsigned short)ui->spinBox_2->value();
     float value = (float)ui->doubleSpinBox->value();
-    net->handleReceivedLocalCommandValue(command,HIGH_PRIORITY,RELIABLE_ORDERED,0,Network::FLOAT32,value,false,0.0f);
+    postRequest([command, value](Network::Network* net, Network::NetworkLocal*) {
+        net->handleReceivedLocalCommandValue(command,HIGH_PRIORITY,RELIABLE_ORDERED,0,Network::FLOAT32,value,false,0.0f);
+    });
 
     QString q = QString("Local Command (%1): ").arg(command)+QString::number((double)value);
     std::cout << q.toStdString().c_str() << std::endl;
@@ -815,8 +1130,10 @@ void MainWindow::kickClientFromSeat()
 {
     if (contextMenuRowAction >= 0 && contextMenuRowAction < ui->tableWidget->rowCount())
     {
-        QString id = ui->tableWidget->item(contextMenuRowAction, 3)->text();
-        net->kickClientFromSeat(id.toStdString());
+        std::string id = ui->tableWidget->item(contextMenuRowAction, 3)->text().toStdString();
+        postRequest([id](Network::Network* net, Network::NetworkLocal*) {
+            net->kickClientFromSeat(id);
+        });
     }
     contextMenuRowAction = -1;
 }
@@ -825,8 +1142,10 @@ void MainWindow::kickClientFromServer()
 {
     if (contextMenuRowAction >= 0 && contextMenuRowAction < ui->tableWidget->rowCount())
     {
-        QString id = ui->tableWidget->item(contextMenuRowAction, 3)->text();
-        net->kickClientFromServer(id.toStdString());
+        std::string id = ui->tableWidget->item(contextMenuRowAction, 3)->text().toStdString();
+        postRequest([id](Network::Network* net, Network::NetworkLocal*) {
+            net->kickClientFromServer(id);
+        });
     }
     contextMenuRowAction = -1;
 }
@@ -835,36 +1154,44 @@ void MainWindow::banClientFromServer()
 {
     if (contextMenuRowAction >= 0 && contextMenuRowAction < ui->tableWidget->rowCount())
     {
-        QString id = ui->tableWidget->item(contextMenuRowAction, 3)->text();
-        if (net->banClientFromServer(id.toStdString()))
-        {
-            QString clientAddress = QString::fromStdString(net->getClientAddress(id.toStdString()));
-            QSettings settings;
-            QStringList banList = settings.value("banList").toStringList();
-            bool foundInBanList = false;
-            for (int i = 0; i < banList.size(); i++)
-            {
-                if (QString::compare(banList.at(i), clientAddress) == 0)
-                {
-                    foundInBanList = true;
-                    break;
-                }
-            }
-            if (!foundInBanList)
-            {
-                banList.append(clientAddress);
-                settings.setValue("banList", banList);
+        std::string id = ui->tableWidget->item(contextMenuRowAction, 3)->text().toStdString();
+        Network::UiChannel* uiChannel = networkThread->getUiChannel();
+        postRequest([id, uiChannel](Network::Network* net, Network::NetworkLocal*) {
+            //address has to be looked up before the connection is closed
+            QString clientAddress = QString::fromStdString(net->getClientAddress(id));
+            if (net->banClientFromServer(id)) {
+                uiChannel->clientBanned(clientAddress);
             }
-        }
+        });
     }
     contextMenuRowAction = -1;
 }
 
+void MainWindow::addToBanList(const QString& clientAddress)
+{
+    QSettings settings;
+    QStringList banList = settings.value("banList").toStringList();
+    bool foundInBanList = false;
+    for (int i = 0; i < banList.size(); i++)
+    {
+        if (QString::compare(banList.at(i), clientAddress) == 0)
+        {
+            foundInBanList = true;
+            break;
+        }
+    }
+    if (!foundInBanList)
+    {
+        banList.append(clientAddress);
+        settings.setValue("banList", banList);
+    }
+}
+
 void MainWindow::on_tableWidget_customContextMenuRequested(const QPoint &pos)
 {
     int row = ui->tableWidget->indexAt(pos).row();
     contextMenuRowAction = row;
-    if (row >= 0 && net->isHost())
+    if (row >= 0 && hosting)
     {
         QMenu contextMenu;
 
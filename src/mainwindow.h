@@ -18,6 +18,10 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <deque>
+#include <functional>
+#include <vector>
+
 #include <QMainWindow>
 #include <QLabel>
 
@@ -27,6 +31,8 @@ INCLUDES
 #include "connectionwindow.h"
 #include "aboutwindow.h"
 
+#include "UiChannel.h"
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -64,7 +70,14 @@ enum class BandwidthStringFormats {
 FORWARD DECLARATIONS
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+class QTimer;
+class StatisticsGraph;
 
+namespace Network {
+class Network;
+class NetworkLocal;
+class NetworkThread;
+}
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -112,6 +125,9 @@ public:
                        float myPacketLoss);
     void resetStatistics();
     void clearClients();
+    void setCommandLatency(const std::vector<Network::CommandLatencySummary>& summary);
+    void setOrderingStalls(const std::vector<Network::OrderingStallSummary>& summary);
+    void setStatisticsHistory(const std::vector<Network::StatisticsSample>& samples);
 
     QLabel* Listener_status_label = nullptr;
     QLabel* DCS_status_label = nullptr;
@@ -119,8 +135,7 @@ public:
 
 private slots:
     void on_actionExit_triggered();
-    void updateLocalNetwork();
-    void updateNetwork();
+    void processNetworkEvents();
     void startServer();
     void connectToServer();
     void kickClientFromSeat();
@@ -136,6 +151,9 @@ private slots:
     void on_actionConnect_triggered();
     void on_actionDisconnect_triggered();
     void on_actionAbout_triggered();
+    void on_actionExport_Latency_triggered();
+    void on_actionRecord_Session_triggered(bool checked);
+    void on_actionReplay_Session_triggered();
 
     void on_pushButton_clicked();
     void on_pushButton_2_clicked();
@@ -154,7 +172,26 @@ private:
     int contextMenuRowAction;
     int prevClientSortIndex;
     Qt::SortOrder prevClientSortOrder;
+    Network::NetworkThread* networkThread = nullptr;
+    //requests the full request queue did not take, posted again in order by the UI timer
+    std::deque<std::function<void(Network::Network*, Network::NetworkLocal*)>> unpostedRequests;
+    QTimer* uiTimer = nullptr;
+    std::vector<Network::CommandLatencySummary> commandLatency; //reused between GUI updates
+    std::vector<Network::OrderingStallSummary> orderingStalls; //reused between GUI updates
+    std::vector<Network::StatisticsSample> statisticsHistory; //reused between GUI updates
+    Network::UiState uiState; //as last applied to the widgets
+    StatisticsGraph* bandwidthGraph = nullptr;
+    StatisticsGraph* packetLossGraph = nullptr;
+    StatisticsGraph* pingGraph = nullptr;
+    int statisticsRate;
+    bool hosting;
     void closeProgram();
+    void postRequest(std::function<void(Network::Network*, Network::NetworkLocal*)> request);
+    void postUnpostedRequests();
+    void postSessionSettings();
+    void addToBanList(const QString& clientAddress);
+    void applyUiState(const Network::UiState& newState);
+    int findClientRow(const QString& id) const;
     void startLocalServer();
     void stopLocalServer();
     void stopServer();
@@ -0,0 +1,211 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       server_main.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      Entry point of the dcs_copilot_server target
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Headless copilot host. Settings come from an optional INI file (--config, same
+keys as the GUI settings) and are overridden by command line flags.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+NOTES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+Example config file:
+
+    clientName=DedicatedHost
+    serverPort=39640
+    password=
+    tickTimeMS=10
+    timeoutTimeMS=10000
+    maxClients=8
+    updateWorkers=0
+    startListener=false
+    listenerTransport=raknet
+    orderingChannels=hashed
+    deadReckoning=on
+    codecProfile=
+    logLevel=1
+    logFile=/var/log/dcs_copilot_server.log
+    banList=
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <csignal>
+#include <iostream>
+
+#include "Network.h"
+#include "ServerDaemon.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QSettings>
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+namespace {
+
+void handleStopSignal(int)
+{
+    Network::ServerDaemon::requestStop();
+}
+
+Network::LocalTransport parseListenerTransport(const QString& name, Network::LocalTransport defaultTransport)
+{
+    if (name == "raknet")
+        return Network::LOCAL_TRANSPORT_RAKNET;
+    if (name == "shm")
+        return Network::LOCAL_TRANSPORT_SHARED_MEMORY;
+
+    std::cerr << "Unknown listener transport: " << name.toStdString() << std::endl;
+    return defaultTransport;
+}
+
+void readConfigFile(const QString& path, Network::ServerDaemonConfig& config)
+{
+    QSettings settings(path, QSettings::IniFormat);
+    config.clientName = settings.value("clientName", QString::fromStdString(config.clientName)).toString().toStdString();
+    config.port = (unsigned short)settings.value("serverPort", config.port).toUInt();
+    config.password = settings.value("password", QString::fromStdString(config.password)).toString().toStdString();
+    config.tickTimeMS = settings.value("tickTimeMS", config.tickTimeMS).toInt();
+    config.timeoutTimeMS = settings.value("timeoutTimeMS", config.timeoutTimeMS).toInt();
+    config.maxClients = settings.value("maxClients", config.maxClients).toInt();
+    config.updateWorkers = settings.value("updateWorkers", config.updateWorkers).toInt();
+    config.startListener = settings.value("startListener", config.startListener).toBool();
+    if (settings.contains("listenerTransport"))
+        config.listenerTransport = parseListenerTransport(settings.value("listenerTransport").toString(), config.listenerTransport);
+    config.orderingChannels = settings.value("orderingChannels", QString::fromStdString(config.orderingChannels)).toString().toStdString();
+    config.deadReckoning = settings.value("deadReckoning", QString::fromStdString(config.deadReckoning)).toString().toStdString();
+    config.codecProfile = settings.value("codecProfile", QString::fromStdString(config.codecProfile)).toString().toStdString();
+    config.logLevel = (Network::LogLevel)settings.value("logLevel", (int)config.logLevel).toInt();
+    config.logFile = settings.value("logFile", QString::fromStdString(config.logFile)).toString().toStdString();
+    config.banList = settings.value("banList").toStringList();
+    config.configFile = path;
+}
+
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCoreApplication::setOrganizationName("Cory Parks");
+    QCoreApplication::setApplicationName("DCS Copilot Server");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless DCS Copilot host");
+    parser.addHelpOption();
+
+    QCommandLineOption configOption(QStringList() << "c" << "config", "Read settings from an INI file. Bans are written back to it.", "file");
+    QCommandLineOption portOption(QStringList() << "p" << "port", "Port to host on.", "port");
+    QCommandLineOption nameOption(QStringList() << "n" << "name", "Name of the host shown to the clients.", "name");
+    QCommandLineOption passwordOption("password", "Server password.", "password");
+    QCommandLineOption maxClientsOption("max-clients", "Maximum number of clients.", "count");
+    QCommandLineOption updateWorkersOption("update-workers", "Threads that help with the per connection updates, for large crews (default 0).", "count");
+    QCommandLineOption tickTimeOption("tick-time", "Time between network update cycles in milliseconds, 5 to 30 (default 10).", "ms");
+    QCommandLineOption timeoutOption("timeout", "Connection timeout in milliseconds.", "ms");
+    QCommandLineOption listenerOption("listener", "Also accept a local DCS connection.");
+    QCommandLineOption listenerTransportOption("listener-transport", "Local DCS connection over raknet (default) or shm (shared memory). Implies --listener.", "transport");
+    QCommandLineOption orderingChannelsOption("ordering-channels", "Ordering channels of commands from the listener: hashed (default), aircraft, or a table file.", "mode");
+    QCommandLineOption deadReckoningOption("dead-reckoning", "Skip analog values from the listener that receivers extrapolate well enough: on (default), off, or a tolerance table file.", "mode");
+    QCommandLineOption codecProfileOption("codec-profile", "Aircraft codec profile, used while every seat loaded the same one.", "file");
+    QCommandLineOption logLevelOption("log-level", "0 debug (every command), 1 info, 2 warning, 3 error.", "level");
+    QCommandLineOption logFileOption("log-file", "Append the log to a file.", "file");
+    QCommandLineOption recordOption("record", "Record every message sent and received to a file.", "file");
+    QCommandLineOption replayOption("replay", "Replay the received messages of a recording once hosting.", "file");
+    QCommandLineOption replaySpeedOption("replay-speed", "Replay speed, 1 the recorded pace, 0 as fast as possible.", "factor");
+
+    parser.addOption(configOption);
+    parser.addOption(portOption);
+    parser.addOption(nameOption);
+    parser.addOption(passwordOption);
+    parser.addOption(maxClientsOption);
+    parser.addOption(updateWorkersOption);
+    parser.addOption(tickTimeOption);
+    parser.addOption(timeoutOption);
+    parser.addOption(listenerOption);
+    parser.addOption(listenerTransportOption);
+    parser.addOption(orderingChannelsOption);
+    parser.addOption(deadReckoningOption);
+    parser.addOption(codecProfileOption);
+    parser.addOption(logLevelOption);
+    parser.addOption(logFileOption);
+    parser.addOption(recordOption);
+    parser.addOption(replayOption);
+    parser.addOption(replaySpeedOption);
+    parser.process(a);
+
+    Network::ServerDaemonConfig config;
+
+    if (parser.isSet(configOption))
+    {
+        QString path = parser.value(configOption);
+        if (!QFileInfo(path).isFile()) {
+            std::cerr << "Config file not found: " << path.toStdString() << std::endl;
+            return 1;
+        }
+        readConfigFile(path, config);
+    }
+
+    if (parser.isSet(portOption))
+        config.port = (unsigned short)parser.value(portOption).toUInt();
+    if (parser.isSet(nameOption))
+        config.clientName = parser.value(nameOption).toStdString();
+    if (parser.isSet(passwordOption))
+        config.password = parser.value(passwordOption).toStdString();
+    if (parser.isSet(maxClientsOption))
+        config.maxClients = parser.value(maxClientsOption).toInt();
+    if (parser.isSet(updateWorkersOption))
+        config.updateWorkers = parser.value(updateWorkersOption).toInt();
+    if (parser.isSet(tickTimeOption))
+        config.tickTimeMS = parser.value(tickTimeOption).toInt();
+    if (parser.isSet(timeoutOption))
+        config.timeoutTimeMS = parser.value(timeoutOption).toInt();
+    if (parser.isSet(listenerOption))
+        config.startListener = true;
+    if (parser.isSet(listenerTransportOption)) {
+        config.startListener = true;
+        config.listenerTransport = parseListenerTransport(parser.value(listenerTransportOption), config.listenerTransport);
+    }
+    if (parser.isSet(orderingChannelsOption))
+        config.orderingChannels = parser.value(orderingChannelsOption).toStdString();
+    if (parser.isSet(deadReckoningOption))
+        config.deadReckoning = parser.value(deadReckoningOption).toStdString();
+    if (parser.isSet(codecProfileOption))
+        config.codecProfile = parser.value(codecProfileOption).toStdString();
+    if (parser.isSet(logLevelOption))
+        config.logLevel = (Network::LogLevel)parser.value(logLevelOption).toInt();
+    if (parser.isSet(logFileOption))
+        config.logFile = parser.value(logFileOption).toStdString();
+    if (parser.isSet(recordOption))
+        config.recordFile = parser.value(recordOption).toStdString();
+    if (parser.isSet(replayOption))
+        config.replayFile = parser.value(replayOption).toStdString();
+    if (parser.isSet(replaySpeedOption))
+        config.replaySpeed = parser.value(replaySpeedOption).toDouble();
+
+    if (config.port < Network::MIN_PORT) {
+        std::cerr << "Invalid port, use " << Network::MIN_PORT << " to " << Network::MAX_PORT << std::endl;
+        return 1;
+    }
+
+    Network::ServerDaemon daemon(config);
+    if (!daemon.start())
+        return 1;
+
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+
+    return a.exec();
+}
@@ -95,8 +95,10 @@ void SettingsWindow::showEvent( QShowEvent* event )
     QString timeoutTimeMS = settings.value("timeoutTimeMS", "10000").toString();
     int tickTimeIndex = fmin(fmax(int(std::round(settings.value("tickTimeMS", 6).toDouble() / 6.0)), 1), 5) - 1;
     int maxClients = settings.value("maxClients", 8).toInt();
+    int localTransport = settings.value("localTransport", 0).toInt();
 
     ui->checkBox->setChecked(startListenerOnStartup);
+    ui->comboBox_2->setCurrentIndex(localTransport);
     ui->lineEdit->setText(clientName);
     ui->spinBox->setValue(maxServerHistorySize);
     ui->lineEdit_2->setText(serverPort);
@@ -123,6 +125,7 @@ void SettingsWindow::on_SettingsWindow_accepted()
     settings.setValue("clientName", ui->lineEdit->text());
     settings.setValue("serverPort", ui->lineEdit_2->text());
     settings.setValue("startListenerOnStartup", ui->checkBox->isChecked());
+    settings.setValue("localTransport", ui->comboBox_2->currentIndex());
     settings.setValue("maxServerHistorySize", ui->spinBox->value());
     settings.setValue("timeoutTimeMS", ui->lineEdit_4->text());
     settings.setValue("maxClients", ui->spinBox_2->value());
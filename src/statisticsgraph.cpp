@@ -0,0 +1,107 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module:       statisticsgraph.cpp
+Author:       DCS Copilot contributors
+Date started: 10/2026
+Purpose:      StatisticsGraph Class
+
+See LICENSE file for copyright and license information
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Line graphs of the sampled connection statistics in the main window.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "statisticsgraph.h"
+
+#include <algorithm>
+
+#include <QPainter>
+#include <QPainterPath>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+StatisticsGraph::StatisticsGraph(const QString& title_, const QColor& color_, const QColor& secondColor_, QWidget* parent)
+    : QWidget(parent), title(title_), color(color_), secondColor(secondColor_)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void StatisticsGraph::setValues(const std::vector<double>& values_, const std::vector<double>& secondValues_, size_t capacity_, const QString& text_)
+{
+    values = values_;
+    secondValues = secondValues_;
+    capacity = std::max<size_t>(2, capacity_);
+    text = text_;
+    update();
+}
+
+void StatisticsGraph::clear()
+{
+    values.clear();
+    secondValues.clear();
+    text.clear();
+    update();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void StatisticsGraph::paintEvent(QPaintEvent*)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::white);
+    painter.setPen(Qt::gray);
+    painter.drawRect(rect().adjusted(0, 0, -1, -1));
+
+    painter.setPen(Qt::black);
+    painter.drawText(rect().adjusted(4, 2, -4, 0), Qt::AlignLeft | Qt::AlignTop, title);
+    painter.drawText(rect().adjusted(4, 2, -4, 0), Qt::AlignRight | Qt::AlignTop, text);
+
+    //below the text, so the latest value is never drawn over
+    QRect area = rect().adjusted(2, painter.fontMetrics().height() + 4, -2, -2);
+    if (area.height() < 2)
+        return;
+
+    double maximum = 0.0;
+    for (double value : values)
+        maximum = std::max(maximum, value);
+    for (double value : secondValues)
+        maximum = std::max(maximum, value);
+    if (maximum <= 0.0)
+        maximum = 1.0;
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    drawSeries(painter, secondValues, secondColor, area, maximum);
+    drawSeries(painter, values, color, area, maximum);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void StatisticsGraph::drawSeries(QPainter& painter, const std::vector<double>& series, const QColor& seriesColor, const QRect& area, double maximum)
+{
+    if (series.size() < 2)
+        return;
+
+    //the newest sample is at the right edge, and a short history only fills part of the width
+    double step = (double)area.width() / (double)(capacity - 1);
+    double x = area.right() - step * (double)(series.size() - 1);
+
+    QPainterPath path;
+    for (size_t i = 0; i < series.size(); i++, x += step)
+    {
+        double y = area.bottom() - (series[i] / maximum) * (double)area.height();
+        if (i == 0)
+            path.moveTo(x, y);
+        else
+            path.lineTo(x, y);
+    }
+
+    painter.setPen(QPen(seriesColor, 1.5));
+    painter.drawPath(path);
+}
@@ -0,0 +1,75 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header:       statisticsgraph.h
+Author:       DCS Copilot contributors
+Date started: 10/2026
+
+See LICENSE file for copyright and license information
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef STATISTICSGRAPH_H
+#define STATISTICSGRAPH_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstddef>
+#include <vector>
+
+#include <QColor>
+#include <QString>
+#include <QWidget>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class QPainter;
+class QPaintEvent;
+class QRect;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Small line graph of up to two series over the statistics history, scaled to
+the largest value shown, with a title and the latest value as text.
+
+@author DCS Copilot contributors
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class StatisticsGraph : public QWidget
+{
+public:
+    StatisticsGraph(const QString& title, const QColor& color, const QColor& secondColor = QColor(), QWidget* parent = 0);
+
+    ///Replace the series, oldest first. capacity is the number of samples across the whole graph.
+    void setValues(const std::vector<double>& values, const std::vector<double>& secondValues, size_t capacity, const QString& text);
+
+    ///Drop the series
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent* event);
+
+private:
+    void drawSeries(QPainter& painter, const std::vector<double>& series, const QColor& seriesColor, const QRect& area, double maximum);
+
+    QString title;
+    QString text;
+    QColor color;
+    QColor secondColor;
+    std::vector<double> values;
+    std::vector<double> secondValues;
+    size_t capacity = 1;
+};
+
+#endif // STATISTICSGRAPH_H